@@ -0,0 +1,369 @@
+/**
+ * @file bench_comm.cpp
+ * @brief Latency and throughput of the comm interfaces. Serial runs over a pseudo-terminal
+ * pair, Ethernet over the loopback interface, impaired Ethernet additionally with jitter.
+ * @version 0.1
+ *
+ * @copyright Copyright 2026 Triton AI
+ *
+ */
+
+#include <benchmark/benchmark.h>
+#include <arpa/inet.h>
+#include <pty.h>
+#include <sys/socket.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "tai_gokart_controller/comm.hpp"
+
+namespace
+{
+// About the size of a sensor frame
+const std::vector<uint8_t> FRAME(24, 0x5A);
+
+/**
+ * @brief A raw pseudo-terminal pair. The master stands in for the MCU, the slave for the
+ * serial device opened by the controller.
+ */
+class PtyPair
+{
+public:
+  PtyPair()
+  {
+    char name[64] = {0};
+    if (openpty(&master_, &slave_, name, nullptr, nullptr) == 0) {
+      termios tio {};
+      tcgetattr(slave_, &tio);
+      cfmakeraw(&tio);
+      tcsetattr(slave_, TCSANOW, &tio);
+      slave_name_ = name;
+    }
+  }
+
+  ~PtyPair()
+  {
+    if (master_ >= 0) {
+      ::close(master_);
+      ::close(slave_);
+    }
+  }
+
+  bool ok() const {return !slave_name_.empty();}
+  int master() const {return master_;}
+  int slave() const {return slave_;}
+  const std::string & slave_name() const {return slave_name_;}
+  void write_frame() {(void)!::write(master_, FRAME.data(), FRAME.size());}
+
+private:
+  int master_ = -1;
+  int slave_ = -1;
+  std::string slave_name_ {};
+};
+
+/**
+ * @brief A UDP socket on the loopback interface standing in for the MCU
+ */
+class UdpPeer
+{
+public:
+  UdpPeer()
+  {
+    socket_ = socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in address = loopback(0);
+    const int buffer_size = 4 << 20;
+    setsockopt(socket_, SOL_SOCKET, SO_RCVBUF, &buffer_size, sizeof(buffer_size));
+    timeval timeout {0, 100000};
+    setsockopt(socket_, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    socklen_t length = sizeof(address);
+    ok_ = bind(socket_, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) == 0 &&
+      getsockname(socket_, reinterpret_cast<sockaddr *>(&address), &length) == 0;
+    port_ = ntohs(address.sin_port);
+  }
+  ~UdpPeer() {::close(socket_);}
+
+  static sockaddr_in loopback(const uint16_t & port)
+  {
+    sockaddr_in address {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    return address;
+  }
+
+  bool ok() const {return ok_;}
+  int socket_fd() const {return socket_;}
+  uint16_t port() const {return port_;}
+  void write_frame(const uint16_t & port)
+  {
+    const sockaddr_in address = loopback(port);
+    sendto(
+      socket_, FRAME.data(), FRAME.size(), 0,
+      reinterpret_cast<const sockaddr *>(&address), sizeof(address));
+  }
+
+private:
+  int socket_ = -1;
+  bool ok_ = false;
+  uint16_t port_ = 0;
+};
+
+class CountingHandler : public tritonai::gkc::ICommRecvHandler
+{
+public:
+  void receive(const tritonai::gkc::GkcBufferView & buffer) {num_bytes += buffer.size();}
+  std::atomic<size_t> num_bytes {0};
+};
+
+/**
+ * @brief Counts the bytes readable from `fd` until stopped, like an MCU draining its link
+ */
+class Drain
+{
+public:
+  explicit Drain(const int & fd)
+  : thread_([this, fd]() {
+        std::vector<uint8_t> buffer(65536, 0);
+        while (running) {
+          const ssize_t bytes_read = ::read(fd, buffer.data(), buffer.size());
+          if (bytes_read > 0) {
+            num_bytes += static_cast<size_t>(bytes_read);
+          }
+        }
+      }) {}
+
+  // Wait for `size` bytes in total, for up to a second
+  bool wait_for(const size_t & size)
+  {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (num_bytes < size && std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::yield();
+    }
+    return num_bytes >= size;
+  }
+
+  // `unblock` makes the last read return
+  void stop(const std::function<void()> & unblock)
+  {
+    running = false;
+    unblock();
+    thread_.join();
+  }
+
+  std::atomic<bool> running {true};
+  std::atomic<size_t> num_bytes {0};
+
+private:
+  std::thread thread_;
+};
+
+tritonai::gkc::ConfigList serial_configs(const PtyPair & pty)
+{
+  return tritonai::gkc::ConfigList{
+    {"serial_port", tritonai::gkc::Configurable(pty.slave_name())},
+    {"baud_rate", tritonai::gkc::Configurable(static_cast<int64_t>(115200))},
+  };
+}
+
+tritonai::gkc::ConfigList ethernet_configs(const UdpPeer & peer)
+{
+  using tritonai::gkc::Configurable;
+  return tritonai::gkc::ConfigList{
+    {"udp_local_ip", Configurable(std::string("127.0.0.1"))},
+    {"udp_local_port", Configurable(static_cast<int64_t>(0))},
+    {"udp_remote_ip", Configurable(std::string("127.0.0.1"))},
+    {"udp_remote_port", Configurable(static_cast<int64_t>(peer.port()))},
+    {"udp_socket_buffer_size", Configurable(static_cast<int64_t>(0))},
+    {"udp_dscp", Configurable(static_cast<int64_t>(46))},
+  };
+}
+
+tritonai::gkc::ConfigList impaired_ethernet_configs(
+  const UdpPeer & peer,
+  const int64_t & jitter_ms)
+{
+  using tritonai::gkc::Configurable;
+  auto configs = ethernet_configs(peer);
+  configs.insert(
+  {
+    {"impairment_seed", Configurable(static_cast<int64_t>(0))},
+    {"impairment_delay_ms", Configurable(static_cast<int64_t>(1))},
+    {"impairment_jitter_ms", Configurable(jitter_ms)},
+    {"impairment_bandwidth_bps", Configurable(static_cast<int64_t>(0))},
+    {"impairment_loss_rate", Configurable(0.0)},
+    {"impairment_corruption_rate", Configurable(0.0)},
+  });
+  return configs;
+}
+
+// Write one frame and spin until all of its bytes have been received
+template<typename WriteT, typename CountT>
+void wait_for_frame(const WriteT & write_frame, const CountT & num_bytes)
+{
+  const size_t expected = num_bytes + FRAME.size();
+  write_frame();
+  while (num_bytes < expected) {
+    std::this_thread::yield();
+  }
+}
+
+// Send frames as fast as the interface takes them
+void send_frames(
+  benchmark::State & state, tritonai::gkc::ICommInterface & comm, Drain & drain)
+{
+  size_t num_sent = 0;
+  for (auto _ : state) {
+    num_sent += comm.send(FRAME);
+  }
+  if (!drain.wait_for(num_sent)) {
+    state.counters["bytes_lost"] = static_cast<double>(num_sent - drain.num_bytes);
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * FRAME.size());
+}
+}  // namespace
+
+// The serial receive loop used before: blocking read, then a 5 ms sleep before the next read
+static void BM_SerialSleepPollingLatency(benchmark::State & state)
+{
+  PtyPair pty;
+  if (!pty.ok()) {
+    state.SkipWithError("openpty failed");
+    return;
+  }
+  std::atomic<size_t> num_bytes {0};
+  std::atomic<bool> running {true};
+  std::thread reader([&]() {
+      std::vector<uint8_t> buffer(2048, 0);
+      while (running) {
+        const ssize_t bytes_read = ::read(pty.slave(), buffer.data(), buffer.size());
+        if (bytes_read > 0) {
+          num_bytes += static_cast<size_t>(bytes_read);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+      }
+    });
+  for (auto _ : state) {
+    wait_for_frame([&pty]() {pty.write_frame();}, num_bytes);
+  }
+  running = false;
+  pty.write_frame();  // unblock the last read
+  reader.join();
+}
+BENCHMARK(BM_SerialSleepPollingLatency)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+// From a write of the MCU to the bytes reaching the receive handler
+static void BM_SerialLatency(benchmark::State & state)
+{
+  PtyPair pty;
+  if (!pty.ok()) {
+    state.SkipWithError("openpty failed");
+    return;
+  }
+  CountingHandler handler;
+  tritonai::gkc::SerialInterface serial(&handler);
+  if (!serial.configure(serial_configs(pty)) || !serial.open()) {
+    state.SkipWithError("failed to open the pseudo-terminal");
+    return;
+  }
+  for (auto _ : state) {
+    wait_for_frame([&pty]() {pty.write_frame();}, handler.num_bytes);
+  }
+  serial.close();
+}
+BENCHMARK(BM_SerialLatency)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+static void BM_EthernetLatency(benchmark::State & state)
+{
+  UdpPeer peer;
+  CountingHandler handler;
+  tritonai::gkc::EthernetInterface ethernet(&handler);
+  if (!peer.ok() || !ethernet.configure(ethernet_configs(peer)) || !ethernet.open()) {
+    state.SkipWithError("failed to open a loopback socket");
+    return;
+  }
+  const uint16_t port = ethernet.get_local_port();
+  for (auto _ : state) {
+    wait_for_frame([&peer, port]() {peer.write_frame(port);}, handler.num_bytes);
+  }
+  ethernet.close();
+}
+BENCHMARK(BM_EthernetLatency)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+// Frames sent to the MCU per second
+static void BM_SerialThroughput(benchmark::State & state)
+{
+  PtyPair pty;
+  if (!pty.ok()) {
+    state.SkipWithError("openpty failed");
+    return;
+  }
+  CountingHandler handler;
+  tritonai::gkc::SerialInterface serial(&handler);
+  if (!serial.configure(serial_configs(pty)) || !serial.open()) {
+    state.SkipWithError("failed to open the pseudo-terminal");
+    return;
+  }
+  Drain drain(pty.master());
+  send_frames(state, serial, drain);
+  drain.stop([&serial]() {serial.send(FRAME);});
+  serial.close();
+}
+BENCHMARK(BM_SerialThroughput)->UseRealTime();
+
+static void BM_EthernetThroughput(benchmark::State & state)
+{
+  UdpPeer peer;
+  CountingHandler handler;
+  tritonai::gkc::EthernetInterface ethernet(&handler);
+  if (!peer.ok() || !ethernet.configure(ethernet_configs(peer)) || !ethernet.open()) {
+    state.SkipWithError("failed to open a loopback socket");
+    return;
+  }
+  // The receive timeout of the peer ends the last read
+  Drain drain(peer.socket_fd());
+  send_frames(state, ethernet, drain);
+  drain.stop([]() {});
+  ethernet.close();
+}
+BENCHMARK(BM_EthernetThroughput)->UseRealTime();
+
+// Latency percentiles with 1 ms of delay and the given jitter in ms
+static void BM_ImpairedEthernetLatency(benchmark::State & state)
+{
+  UdpPeer peer;
+  CountingHandler handler;
+  auto ethernet = std::make_shared<tritonai::gkc::EthernetInterface>(nullptr);
+  tritonai::gkc::ImpairedInterface impaired(&handler, ethernet);
+  if (!peer.ok() || !impaired.configure(impaired_ethernet_configs(peer, state.range(0))) ||
+    !impaired.open())
+  {
+    state.SkipWithError("failed to open a loopback socket");
+    return;
+  }
+  const uint16_t port = ethernet->get_local_port();
+  std::vector<double> latencies_us;
+  for (auto _ : state) {
+    const auto start = std::chrono::steady_clock::now();
+    wait_for_frame([&peer, port]() {peer.write_frame(port);}, handler.num_bytes);
+    latencies_us.push_back(
+      std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+  }
+  impaired.close();
+  std::sort(latencies_us.begin(), latencies_us.end());
+  for (const auto & percentile : {50, 90, 99}) {
+    state.counters["p" + std::to_string(percentile) + "_us"] =
+      latencies_us[(latencies_us.size() - 1) * percentile / 100];
+  }
+}
+BENCHMARK(BM_ImpairedEthernetLatency)->Arg(0)->Arg(2)->Unit(benchmark::kMicrosecond)
+->UseRealTime();
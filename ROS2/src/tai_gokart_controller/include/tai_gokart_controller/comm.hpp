@@ -12,11 +12,21 @@
 #ifndef TAI_GOKART_CONTROLLER__COMM_HPP_
 #define TAI_GOKART_CONTROLLER__COMM_HPP_
 
+#include <netinet/in.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <map>
+#include <mutex>
 #include <string>
 #include <memory>
 #include <queue>
+#include <random>
 #include <thread>
+#include <vector>
 
 #include "serial_driver/serial_driver.hpp"
 
@@ -26,6 +36,7 @@
 #include "tai_gokart_packet/gkc_packets.hpp"
 
 #include "tai_gokart_controller/config.hpp"
+#include "tai_gokart_controller/sim_mcu.hpp"
 
 namespace tritonai
 {
@@ -35,10 +46,107 @@ enum CommIO
 {
   Serial = 0,
   Ethernet = 1,
-  CAN = 2
+  CAN = 2,
+  Sim = 3
+};
+
+/**
+ * @brief Send priority of a frame. Queued frames of a higher priority are written first.
+ */
+enum class CommPriority : uint8_t
+{
+  Urgent = 0,  // state transitions (e.g. emergency stop), handshakes and shutdowns
+  Control = 1,  // only the newest queued control frame is written
+  Heartbeat = 2,
+  Background = 3  // configuration, logs, firmware requests, bulk transfers
+};
+
+/**
+ * @brief Frames waiting to be written, one FIFO per `CommPriority`. Frames are copied into
+ * preallocated slots, so queueing does not allocate. Not thread-safe.
+ */
+class CommTxQueue
+{
+public:
+  typedef std::chrono::steady_clock Clock;
+  static constexpr size_t NUM_PRIORITIES = 4;
+  // frames queued per priority before new ones are dropped
+  static constexpr size_t DEPTH = 8;
+  // the write `pop()` builds holds up to this many bytes of whole frames. One extended frame at
+  // most, so an urgent frame queued during a write waits for no more than that on a slow link.
+  static constexpr size_t MAX_WRITE_SIZE = GkcFrameFormat::MAX_EXTENDED_FRAME_SIZE;
+
+  struct Statistics
+  {
+    uint64_t frames_written = 0;
+    uint64_t frames_replaced = 0;  // control frames replaced by a newer one while queued
+    uint64_t frames_dropped = 0;  // frames rejected because the queue was full
+    size_t depth = 0;  // frames queued now
+    size_t max_depth = 0;
+    Clock::duration total_queued_time {};  // from `push()` to `pop()`, for the mean
+    Clock::duration max_queued_time {};
+  };
+
+  /**
+   * @brief Queue a copy of a frame. A control frame replaces the one already queued.
+   *
+   * @return true if queued; false if the queue of `priority` is full or the frame is too long
+   */
+  bool push(
+    const GkcBufferView & frame, const CommPriority & priority,
+    const Clock::time_point & now = Clock::now());
+
+  /**
+   * @brief Coalesce queued frames into one write, highest priority first. A frame that does
+   * not fit stays queued with the ones after it.
+   *
+   * @param write cleared, then filled with whole frames of up to `MAX_WRITE_SIZE` bytes in total
+   * @param priority set to the priority of the first frame, the highest one in `write`
+   * @param single_priority only take frames of that priority
+   * @return size_t number of frames moved into `write`
+   */
+  size_t pop(
+    std::vector<uint8_t> & write, CommPriority & priority,
+    const bool & single_priority = false,
+    const Clock::time_point & now = Clock::now());
+
+  /**
+   * @brief Number of frames queued
+   */
+  size_t size() const;
+
+  const Statistics & get_statistics(const CommPriority & priority) const
+  {
+    return queues_[static_cast<size_t>(priority)].stats;
+  }
+
+  /**
+   * @brief Number of non-empty `pop()`, i.e. writes. Compare with the frames written to
+   * see how many frames each write carries.
+   */
+  uint64_t num_writes() const {return num_writes_;}
+
+private:
+  struct Slot
+  {
+    std::array<uint8_t, GkcFrameFormat::MAX_EXTENDED_FRAME_SIZE> bytes;
+    size_t size;
+    Clock::time_point queued_at;
+  };
+
+  struct Queue
+  {
+    std::array<Slot, DEPTH> slots;
+    size_t head = 0;  // oldest frame
+    Statistics stats {};
+  };
+
+  std::array<Queue, NUM_PRIORITIES> queues_ {};
+  uint64_t num_writes_ = 0;
 };
 
 class ICommInterface;
+class ImpairedInterface;
 
 /**
  * @brief An interface to receive content from low level communication implementation
@@ -50,7 +158,13 @@ public:
   friend ICommInterface;
   ICommRecvHandler() {}
   virtual ~ICommRecvHandler() {}
-  virtual void receive(const GkcBuffer & buffer) = 0;
+  /**
+   * @brief Handle received bytes, e.g. by pushing them into the framer of a
+   * `GkcPacketFactory`. Called with the whole read at once.
+   *
+   * @param buffer bytes owned by the interface, only valid during the call
+   */
+  virtual void receive(const GkcBufferView & buffer) = 0;
 };
 
 /**
@@ -60,6 +174,7 @@ public:
 class ICommInterface
 {
 public:
+  friend ImpairedInterface;  // writes to the interface it wraps
   typedef std::shared_ptr<ICommInterface> SharedPtr;
   typedef std::unique_ptr<ICommInterface> UniquePtr;
 
@@ -112,12 +227,25 @@ public:
   virtual bool close() = 0;
 
   /**
-   * @brief Send a buffer
+   * @brief Send a frame, e.g. one encoded on the stack. Safe to call from any thread.
+   *
+   * The frame is queued with its priority. If no other thread is writing, the calling thread
+   * writes the queue until it is empty, coalescing the frames queued meanwhile into single
+   * writes. Otherwise the writing thread picks the frame up before it returns.
+   * The bytes are not referenced after the call returns.
    *
-   * @param buffer to send
-   * @return size_t number of bytes sent
+   * @param frame one whole frame
+   * @param priority of the frame
+   * @return size_t number of bytes queued; 0 if the queue is full
    */
-  virtual size_t send(const GkcBuffer & buffer) = 0;
+  size_t send(
+    const GkcBufferView & frame,
+    const CommPriority & priority = CommPriority::Background);
+
+  /**
+   * @brief Queue depth and time spent queued of one priority
+   */
+  CommTxQueue::Statistics get_tx_statistics(const CommPriority & priority);
 
   /**
    * @brief Get the interface type
@@ -125,7 +253,24 @@ public:
   virtual CommIO get_io_type() = 0;
 
 protected:
+  /**
+   * @brief Write bytes to the link. Only called by one thread at a time.
+   *
+   * @param buffer one or more whole frames, not referenced after the call returns
+   * @param priority of the first frame, the highest one in `buffer`
+   * @return size_t number of bytes written
+   */
+  virtual size_t write(const GkcBufferView & buffer, const CommPriority & priority) = 0;
+
   ICommRecvHandler * handler_;
+  // Writes only carry frames of one priority, for links that tag writes with it
+  bool tx_single_priority_ = false;
+
+private:
+  std::mutex tx_mutex_ {};
+  CommTxQueue tx_queue_ {};
+  std::vector<uint8_t> tx_write_ {};  // the write being sent
+  bool tx_writing_ = false;  // a thread is writing the queue
 };
 
 class CommUtils
@@ -156,16 +301,343 @@ public:
   bool open();
   bool is_open();
   bool close();
-  size_t send(const GkcBuffer & buffer);
   CommIO get_io_type();
 
-  void recv();
-
 protected:
+  size_t write(const GkcBufferView & buffer, const CommPriority & priority);
+
+  /**
+   * @brief Called on an IO context thread as soon as the driver has read bytes. The driver
+   * re-arms the asynchronous read after each call, so there is no polling interval.
+   * The handler reads the bytes in place from the driver's buffer.
+   */
+  void recv(const std::vector<uint8_t> & buffer, const size_t & bytes_read);
+
   std::unique_ptr<drivers::common::IoContext> owned_ctx {};
   std::unique_ptr<drivers::serial_driver::SerialDriver> driver_ {};
-  std::unique_ptr<std::thread> recv_thread;
-  bool running_ = true;
+  std::vector<uint8_t> send_buffer_ {};
+};
+
+/**
+ * @brief Frames over UDP, for boards on Ethernet. Writes and reads are batched with
+ * `sendmmsg` and `recvmmsg`. The socket is connected to the MCU, so datagrams from other
+ * addresses are ignored.
+ *
+ * Datagrams carry the same byte stream as a serial port. A write is split into datagrams of
+ * at most `MAX_DATAGRAM_SIZE` bytes, and every received datagram goes to the handler as is.
+ * A lost datagram costs the frames in it, like a corrupted stretch of a serial stream.
+ */
+class EthernetInterface : public ICommInterface
+{
+public:
+  // UDP payload of an Ethernet frame (MTU of 1500 bytes) that is not fragmented
+  static constexpr size_t MAX_DATAGRAM_SIZE = 1472;
+  // datagrams per `sendmmsg` or `recvmmsg` call
+  static constexpr size_t BATCH_SIZE = 16;
+  // how long a write waits for room in a full send buffer
+  static constexpr int SEND_TIMEOUT_MS = 10;
+
+  EthernetInterface() = delete;
+  explicit EthernetInterface(ICommRecvHandler * handler);
+  ~EthernetInterface();
+
+  bool configure(const ConfigList & configs);
+  bool open();
+  bool is_open();
+  bool close();
+  CommIO get_io_type();
+
+  /**
+   * @brief Port the socket is bound to, e.g. the one picked by the OS if configured with 0
+   */
+  uint16_t get_local_port() const;
+
+protected:
+  size_t write(const GkcBufferView & buffer, const CommPriority & priority);
+
+  /**
+   * @brief Hand received datagrams to the handler until `close()`
+   */
+  void recv();
+
+  sockaddr_in local_addr_ {};
+  sockaddr_in remote_addr_ {};
+  int socket_buffer_size_ = 0;  // SO_SNDBUF and SO_RCVBUF; 0 for the OS default
+  int dscp_ = 0;  // differentiated services code point of sent datagrams
+  int socket_ = -1;
+  int wake_fd_ = -1;  // eventfd that stops `recv`
+  std::unique_ptr<std::thread> recv_thread_ {};
+};
+
+/**
+ * @brief Splits writes into CAN frames.
+ *
+ * A write is sent as a message of consecutive CAN frames with one arbitration ID. The first
+ * byte of each CAN frame is a sequence number counting the frames of the message, with `FIRST`
+ * set on the first frame. The first frame then carries the message size as a little-endian
+ * uint16. The rest are message bytes. Bytes after the end of the message, e.g. padding to a
+ * valid CAN-FD length, are ignored.
+ */
+class CanFragmenter
+{
+public:
+  static constexpr uint8_t FIRST = 0x80;
+  static constexpr uint8_t SEQUENCE_MASK = 0x7F;
+  static constexpr size_t FIRST_HEADER_SIZE = 3;
+  static constexpr size_t HEADER_SIZE = 1;
+  static constexpr size_t MAX_PAYLOAD_SIZE = 64;  // of CAN-FD, 8 for classic CAN
+
+  /**
+   * @brief Split a message into CAN payloads
+   *
+   * @param message at most UINT16_MAX bytes
+   * @param max_payload_size bytes per CAN frame, at least `FIRST_HEADER_SIZE + 1`
+   * @param emit called with the payload of each CAN frame in order, e.g.
+   * `bool(const GkcBufferView & payload)`. Returns false to stop.
+   * @return true if every CAN frame was emitted
+   */
+  template<typename EmitT>
+  static bool split(
+    const GkcBufferView & message, const size_t & max_payload_size,
+    EmitT && emit)
+  {
+    std::array<uint8_t, MAX_PAYLOAD_SIZE> payload;
+    const size_t payload_size = std::min(max_payload_size, MAX_PAYLOAD_SIZE);
+    size_t offset = 0;
+    uint8_t sequence = 0;
+    do {
+      size_t header_size = HEADER_SIZE;
+      payload[0] = sequence & SEQUENCE_MASK;
+      if (offset == 0) {
+        payload[0] |= FIRST;
+        payload[1] = static_cast<uint8_t>(message.size());
+        payload[2] = static_cast<uint8_t>(message.size() >> 8);
+        header_size = FIRST_HEADER_SIZE;
+      }
+      const size_t size = std::min(payload_size - header_size, message.size() - offset);
+      std::copy_n(message.data() + offset, size, payload.data() + header_size);
+      if (!emit(GkcBufferView(payload.data(), header_size + size))) {
+        return false;
+      }
+      offset += size;
+      ++sequence;
+    } while (offset < message.size());
+    return true;
+  }
+};
+
+/**
+ * @brief Rebuilds the messages of one arbitration ID. A message missing a CAN frame is dropped.
+ */
+class CanReassembler
+{
+public:
+  /**
+   * @brief Add the payload of the next CAN frame
+   *
+   * @return true if it completes a message, which `message()` holds until the next push
+   */
+  bool push(const GkcBufferView & payload);
+
+  GkcBufferView message() const {return GkcBufferView(message_);}
+
+  // Messages dropped for a missing CAN frame
+  uint64_t num_dropped() const {return num_dropped_;}
+
+private:
+  std::vector<uint8_t> message_ {};
+  size_t size_ = 0;  // of the message being received
+  uint8_t next_sequence_ = 0;
+  bool receiving_ = false;
+  uint64_t num_dropped_ = 0;
+};
+
+/**
+ * @brief Frames over SocketCAN, classic CAN or CAN-FD. Each write is a `CanFragmenter`
+ * message whose arbitration ID is the transmit base ID plus its `CommPriority`, so that urgent
+ * and control frames win arbitration over telemetry on the bus. The MCU does the same from the
+ * receive base ID, and a kernel filter drops every other ID.
+ */
+class CanInterface : public ICommInterface
+{
+public:
+  // CAN frames per `sendmmsg` or `recvmmsg` call
+  static constexpr size_t BATCH_SIZE = 16;
+  // how long a write waits for room in a full transmit queue
+  static constexpr int SEND_TIMEOUT_MS = 10;
+
+  CanInterface() = delete;
+  explicit CanInterface(ICommRecvHandler * handler);
+  ~CanInterface();
+
+  bool configure(const ConfigList & configs);
+  bool open();
+  bool is_open();
+  bool close();
+  CommIO get_io_type();
+
+protected:
+  size_t write(const GkcBufferView & buffer, const CommPriority & priority);
+
+  /**
+   * @brief Hand reassembled messages to the handler until `close()`
+   */
+  void recv();
+
+  std::string interface_name_ {};
+  bool can_fd_ = false;
+  uint32_t tx_base_id_ = 0;  // of the frames sent, one ID per priority
+  uint32_t rx_base_id_ = 0;  // of the frames received
+  int socket_ = -1;
+  int wake_fd_ = -1;  // eventfd that stops `recv`
+  std::unique_ptr<std::thread> recv_thread_ {};
+  std::array<CanReassembler, CommTxQueue::NUM_PRIORITIES> reassemblers_ {};
+};
+
+/**
+ * @brief An MCU simulated in process, for runs without hardware. Writes are decoded by a
+ * `SimMcu` on a thread of its own, which hands the frames it sends to the handler.
+ */
+class SimInterface : public ICommInterface
+{
+public:
+  SimInterface() = delete;
+  explicit SimInterface(ICommRecvHandler * handler);
+  ~SimInterface();
+
+  bool configure(const ConfigList & configs);
+  bool open();
+  bool is_open();
+  bool close();
+  CommIO get_io_type();
+
+protected:
+  size_t write(const GkcBufferView & buffer, const CommPriority & priority);
+
+  /**
+   * @brief Run the MCU on the bytes written and its timers until `close()`
+   */
+  void run();
+
+  SimMcu::Clock::duration heartbeat_interval_ {};
+  SimMcu::Clock::duration sensor_interval_ {};  // 0 to not stream sensors
+  SimMcu::Clock::duration initialization_time_ {};
+  std::unique_ptr<SimMcu> mcu_ {};
+  std::mutex mutex_ {};
+  std::condition_variable wake_ {};
+  std::vector<uint8_t> written_ {};  // bytes not read by the MCU yet
+  bool running_ = false;
+  std::unique_ptr<std::thread> mcu_thread_ {};
+};
+
+/**
+ * @brief Degrades one direction of a link: delay and jitter, a bandwidth cap, lost bytes and
+ * bit flips. Draws from a generator of its own, so the same seed loses and corrupts the same
+ * bytes in every run. Not thread-safe.
+ */
+class CommImpairment
+{
+public:
+  typedef std::chrono::steady_clock Clock;
+
+  struct Parameters
+  {
+    Clock::duration delay {};  // of every byte
+    Clock::duration jitter {};  // added to the delay of a write, uniformly up to this
+    uint64_t bandwidth_bps = 0;  // bits per second; 0 for no limit
+    double loss_rate = 0.0;  // probability of a byte being lost
+    double corruption_rate = 0.0;  // probability of a byte getting a bit flipped
+  };
+
+  struct Statistics
+  {
+    uint64_t bytes_sent = 0;  // put on the link, including the lost ones
+    uint64_t bytes_lost = 0;
+    uint64_t bytes_corrupted = 0;
+  };
+
+  CommImpairment(const Parameters & parameters, const uint64_t & seed);
+
+  /**
+   * @brief Impair a write. Writes arrive in order: a write waits for the bandwidth the ones
+   * before it take, and does not overtake them however its jitter falls.
+   *
+   * @param bytes lost bytes are removed, corrupted bytes changed in place
+   * @param now when the write is put on the link
+   * @return Clock::time_point when the remaining bytes arrive
+   */
+  Clock::time_point apply(
+    std::vector<uint8_t> & bytes,
+    const Clock::time_point & now = Clock::now());
+
+  const Statistics & get_statistics() const {return stats_;}
+
+private:
+  Parameters parameters_;
+  std::mt19937_64 generator_;  // of the lost and corrupted bytes
+  std::mt19937_64 jitter_generator_;
+  // bytes between two lost or corrupted bytes
+  std::geometric_distribution<uint64_t> loss_gap_;
+  std::geometric_distribution<uint64_t> corruption_gap_;
+  uint64_t until_loss_ = 0;
+  uint64_t until_corruption_ = 0;
+  Clock::time_point link_free_at_ {};  // when the last write is through the bandwidth cap
+  Clock::time_point last_arrival_ {};
+  Statistics stats_ {};
+};
+
+/**
+ * @brief Wraps another interface and impairs both directions of its link with a
+ * `CommImpairment` each, to test on a degraded link. A thread of its own delivers the delayed
+ * writes to the wrapped interface, and the delayed reads to the handler. Unlike the other
+ * interfaces it allocates for every write and read.
+ */
+class ImpairedInterface : public ICommInterface, public ICommRecvHandler
+{
+public:
+  ImpairedInterface() = delete;
+  ImpairedInterface(ICommRecvHandler * handler, const ICommInterface::SharedPtr & inner);
+  ~ImpairedInterface();
+
+  // The impairment configs, then those of the wrapped interface
+  bool configure(const ConfigList & configs);
+  bool open();
+  bool is_open();
+  bool close();
+  CommIO get_io_type();  // of the wrapped interface
+
+  // Reads of the wrapped interface
+  void receive(const GkcBufferView & buffer);
+
+  CommImpairment::Statistics get_tx_impairment_statistics();
+  CommImpairment::Statistics get_rx_impairment_statistics();
+
+protected:
+  size_t write(const GkcBufferView & buffer, const CommPriority & priority);
+
+  /**
+   * @brief Deliver the writes and reads as they arrive until `close()`
+   */
+  void deliver();
+
+  struct Chunk
+  {
+    CommImpairment::Clock::time_point arrival;
+    std::vector<uint8_t> bytes;
+    CommPriority priority;
+  };
+
+  ICommInterface::SharedPtr inner_;
+  CommImpairment::Parameters parameters_ {};
+  uint64_t seed_ = 0;
+  std::unique_ptr<CommImpairment> tx_impairment_ {};
+  std::unique_ptr<CommImpairment> rx_impairment_ {};
+  std::mutex mutex_ {};
+  std::condition_variable wake_ {};
+  std::deque<Chunk> tx_chunks_ {};  // in order of arrival
+  std::deque<Chunk> rx_chunks_ {};
+  bool running_ = false;
+  std::unique_ptr<std::thread> deliver_thread_ {};
 };
 }  // namespace gkc
 }  // namespace tritonai
@@ -0,0 +1,134 @@
+/**
+ * @file sim_mcu.hpp
+ * @brief A model of the MCU firmware, for runs without hardware
+ * @version 0.1
+ *
+ * @copyright Copyright 2026 Triton AI
+ *
+ */
+
+#ifndef TAI_GOKART_CONTROLLER__SIM_MCU_HPP_
+#define TAI_GOKART_CONTROLLER__SIM_MCU_HPP_
+
+#include <chrono>
+#include <functional>
+#include <string>
+
+#include "tai_gokart_packet/gkc_logs.hpp"
+#include "tai_gokart_packet/gkc_packet_factory.hpp"
+#include "tai_gokart_packet/gkc_packet_subscriber.hpp"
+#include "tai_gokart_packet/gkc_packet_utils.hpp"
+#include "tai_gokart_packet/gkc_packets.hpp"
+
+namespace tritonai
+{
+namespace gkc
+{
+/**
+ * @brief The state machine of the MCU (see design/README.md), driven by the frames of the PC.
+ *
+ * Received bytes are decoded and replies encoded by a `GkcPacketFactory` of its own, so the PC
+ * talks to it through the same codec as to the firmware. Handshakes agree to `CAPABILITIES`.
+ * The state is reported in heartbeats, and sensor packets are streamed once configured. The
+ * sensors follow the commanded actuation with a first-order lag. Watchdogs are not modelled.
+ *
+ * Not thread-safe: `receive()` and `tick()` are called from one thread.
+ */
+class SimMcu : public GkcPacketSubscriber
+{
+public:
+  typedef std::chrono::steady_clock Clock;
+  // `void(const GkcBufferView & frame)`, called with every frame the MCU sends
+  typedef std::function<void (const GkcBufferView &)> SendCallback;
+
+  static constexpr uint8_t CAPABILITIES = GkcCapabilities::COBS_FRAMING |
+    GkcCapabilities::COMPACT_PACKETS | GkcCapabilities::EXTENDED_FRAMES;
+  static constexpr float MAX_WHEEL_SPEED_RPM = 600.0f;  // at full throttle
+  static constexpr float STOPPED_WHEEL_SPEED_RPM = 1.0f;  // below which pausing is allowed
+  static constexpr float WHEEL_SPEED_TIME_CONSTANT_S = 0.5f;
+  static constexpr float BATTERY_VOLTAGE = 48.0f;
+  static constexpr float MAX_AMPERAGE = 50.0f;  // at full throttle
+
+  /**
+   * @param send called with the frames to the PC
+   * @param heartbeat_interval between two heartbeats
+   * @param sensor_interval between two sensor packets; 0 to not stream them
+   * @param initialization_time from receiving the configuration to the end of the self-test
+   */
+  SimMcu(
+    const SendCallback & send, const Clock::duration & heartbeat_interval,
+    const Clock::duration & sensor_interval, const Clock::duration & initialization_time,
+    const Clock::time_point & now = Clock::now());
+
+  /**
+   * @brief Decode bytes from the PC and react to its packets
+   */
+  void receive(const GkcBufferView & buffer, const Clock::time_point & now = Clock::now());
+
+  /**
+   * @brief Advance the model: end the self-test, update the sensors, and send the heartbeats
+   * and sensor packets that are due
+   *
+   * @return Clock::time_point when the next one is due
+   */
+  Clock::time_point tick(const Clock::time_point & now = Clock::now());
+
+  GkcLifecycle get_state() const {return state_;}
+  const SensorGkcPacket & get_sensors() const {return sensors_;}
+
+  // GkcPacketSubscriber
+  void packet_callback(const Handshake1GkcPacket & packet);
+  void packet_callback(const Handshake2GkcPacket & packet);
+  void packet_callback(const GetFirmwareVersionGkcPacket & packet);
+  void packet_callback(const FirmwareVersionGkcPacket & packet);
+  void packet_callback(const ResetMcuGkcPacket & packet);
+  void packet_callback(const HeartbeatGkcPacket & packet);
+  void packet_callback(const ConfigGkcPacket & packet);
+  void packet_callback(const StateTransitionGkcPacket & packet);
+  void packet_callback(const LogFilterGkcPacket & packet);
+  void packet_callback(const ControlGkcPacket & packet);
+  void packet_callback(const SensorGkcPacket & packet);
+  void packet_callback(const Shutdown1GkcPacket & packet);
+  void packet_callback(const Shutdown2GkcPacket & packet);
+  void packet_callback(const LogPacket & packet);
+  void packet_callback(const LogIdGkcPacket & packet);
+  void packet_callback(const CompactSensorGkcPacket & packet);
+  void packet_callback(const CompactControlGkcPacket & packet);
+  void packet_callback(const SensorDeltaGkcPacket & packet);
+  void packet_callback(const SensorResyncGkcPacket & packet);
+  void packet_callback(const SensorBatchGkcPacket & packet);
+  void packet_callback(const BulkRequestGkcPacket & packet);
+  void packet_callback(const BulkStartGkcPacket & packet);
+  void packet_callback(const BulkChunkGkcPacket & packet);
+  void packet_callback(const BulkAckGkcPacket & packet);
+
+protected:
+  void send_packet(const GkcPacket & packet);
+  void send_heartbeat();
+  void send_log(const LogPacket::Severity & level, const std::string & what);
+  void transition(const GkcLifecycle & state);
+  void reject_transition(const GkcLifecycle & requested_state);
+  void update_sensors(const Clock::time_point & now);
+
+  SendCallback send_;
+  GkcPacketFactory factory_;
+  Clock::duration heartbeat_interval_;
+  Clock::duration sensor_interval_;
+  Clock::duration initialization_time_;
+
+  GkcLifecycle state_ {GkcLifecycle::Uninitialized};
+  bool compact_packets_ = false;  // agreed to in the handshake
+  ConfigGkcPacket config_ {};
+  ControlGkcPacket command_ {};  // the last one received while active
+  GkcLogFilter log_filter_ {};  // as set by the PC
+  SensorGkcPacket sensors_ {};
+  uint8_t heartbeat_counter_ = 0;
+  Clock::time_point now_;  // of the bytes being received
+  Clock::time_point next_heartbeat_;
+  Clock::time_point next_sensor_;
+  Clock::time_point initialized_at_;  // end of the self-test
+  Clock::time_point updated_at_;  // of the sensors
+};
+}  // namespace gkc
+}  // namespace tritonai
+#endif  // TAI_GOKART_CONTROLLER__SIM_MCU_HPP_
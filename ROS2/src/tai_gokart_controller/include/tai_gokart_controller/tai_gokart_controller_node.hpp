@@ -12,6 +12,7 @@
 #define TAI_GOKART_CONTROLLER__TAI_GOKART_CONTROLLER_NODE_HPP_
 
 #include <memory>
+#include <vector>
 
 #include "rclcpp/rclcpp.hpp"
 #include "rclcpp_lifecycle/lifecycle_node.hpp"
@@ -20,6 +21,8 @@
 #include "tai_gokart_msgs/msg/gkc_command.hpp"
 #include "tai_gokart_msgs/msg/gkc_state.hpp"
 
+#include "tai_gokart_packet/generated/gkc_msg_conversions.hpp"
+
 #include "tai_gokart_controller/tai_gokart_interface.hpp"
 
 namespace tritonai
@@ -53,12 +56,15 @@ private:
   rclcpp::Publisher<GkcState>::SharedPtr state_pub_;
   rclcpp::Subscription<GkcCommand>::SharedPtr cmd_sub_;
   rclcpp::TimerBase::SharedPtr state_pub_timer_;
+  OnSetParametersCallbackHandle::SharedPtr param_callback_handle_;
   std::unique_ptr<GkcInterface> interface_;
   ConfigList configs_;
 
 
   void cmd_callback(const GkcCommand::SharedPtr cmd_msg);
   void state_pub_timer_callback();
+  rcl_interfaces::msg::SetParametersResult param_callback(
+    const std::vector<rclcpp::Parameter> & parameters);
   void dump_logs();
 };
 }  // namespace gkc
@@ -11,15 +11,24 @@
 #ifndef TAI_GOKART_CONTROLLER__TAI_GOKART_INTERFACE_HPP_
 #define TAI_GOKART_CONTROLLER__TAI_GOKART_INTERFACE_HPP_
 
+#include <atomic>
+#include <deque>
+#include <mutex>
 #include <queue>
 #include <string>
 #include <memory>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
+#include "tai_gokart_packet/gkc_bulk_transfer.hpp"
+#include "tai_gokart_packet/gkc_logs.hpp"
 #include "tai_gokart_packet/gkc_packets.hpp"
 #include "tai_gokart_packet/gkc_packet_factory.hpp"
 #include "tai_gokart_packet/gkc_packet_utils.hpp"
 #include "tai_gokart_packet/gkc_packet_subscriber.hpp"
+#include "tai_gokart_packet/gkc_packet_views.hpp"
+#include "tai_gokart_packet/gkc_sensor_deltas.hpp"
 
 #include "tai_gokart_controller/comm.hpp"
 #include "tai_gokart_controller/config.hpp"
@@ -28,6 +37,15 @@ namespace tritonai
 {
 namespace gkc
 {
+/**
+ * @brief A sensor sample and the MCU time it was taken at
+ */
+struct TimedSensorValues
+{
+  uint32_t timestamp_us;  // MCU time in microsecond
+  SensorGkcPacket::SensorValues values;
+};
+
 class GkcInterface : public GkcPacketSubscriber, public ICommRecvHandler
 {
 public:
@@ -44,11 +62,25 @@ public:
   bool release_emergency_stop(const uint32_t & timeout_ms);
   bool shutdown(const uint32_t & timeout_ms);
   const SensorGkcPacket & get_sensors() const;
+  std::vector<TimedSensorValues> take_sensor_history();  // oldest first, empties the history
   GkcLifecycle get_state() const;
   std::shared_ptr<LogPacket> get_next_log();
+  // Logs the MCU sends: at least `min_level` ("info", "warning", "error" or "fatal"), at most
+  // `max_logs_per_second` (0 for no limit). Throws std::invalid_argument if out of range.
+  bool set_log_filter(const std::string & min_level, const int64_t & max_logs_per_second);
+  // Bulk transfers, blocking until complete, failed or timed out
+  bool push_bulk(
+    const uint16_t & resource, const std::vector<uint8_t> & data,
+    const uint32_t & timeout_ms);
+  // nullptr if it failed, or if the MCU offers more than `max_size` bytes
+  std::shared_ptr<std::vector<uint8_t>> pull_bulk(
+    const uint16_t & resource, const size_t & max_size,
+    const uint32_t & timeout_ms);
+  // Queue depth and time spent queued of the frames sent with `priority`
+  CommTxQueue::Statistics get_tx_statistics(const CommPriority & priority) const;
 
   // ICommRecvHandler
-  void receive(const GkcBuffer & buffer);
+  void receive(const GkcBufferView & buffer);
 
   // GkcPacketSubscriber
   void packet_callback(const Handshake1GkcPacket & packet);
@@ -59,33 +91,70 @@ public:
   void packet_callback(const HeartbeatGkcPacket & packet);
   void packet_callback(const ConfigGkcPacket & packet);
   void packet_callback(const StateTransitionGkcPacket & packet);
+  void packet_callback(const LogFilterGkcPacket & packet);
   void packet_callback(const ControlGkcPacket & packet);
   void packet_callback(const SensorGkcPacket & packet);
   void packet_callback(const Shutdown1GkcPacket & packet);
   void packet_callback(const Shutdown2GkcPacket & packet);
   void packet_callback(const LogPacket & packet);
+  void packet_callback(const LogIdGkcPacket & packet);
+  void packet_callback(const CompactSensorGkcPacket & packet);
+  void packet_callback(const CompactControlGkcPacket & packet);
+  void packet_callback(const SensorDeltaGkcPacket & packet);
+  void packet_callback(const SensorResyncGkcPacket & packet);
+  void packet_callback(const SensorBatchGkcPacket & packet);
+  void packet_callback(const BulkRequestGkcPacket & packet);
+  void packet_callback(const BulkStartGkcPacket & packet);
+  void packet_callback(const BulkChunkGkcPacket & packet);
+  void packet_callback(const BulkAckGkcPacket & packet);
+  bool packet_view_callback(const HeartbeatView & view);
+  using GkcPacketSubscriber::packet_view_callback;
 
 protected:
   std::queue<LogPacket> logs_ {};
   std::shared_ptr<ICommInterface> comm_ {};
   std::unique_ptr<std::thread> heartbeat_thread {};
   std::unique_ptr<GkcPacketFactory> factory_ {};
-  std::unique_ptr<SensorGkcPacket> sensors_ {};
+  SensorGkcPacket sensors_ {};
+  GkcSensorDeltaDecoder sensor_deltas_ {};  // rebuilds `sensors_` from SensorDeltaGkcPacket
+  std::deque<TimedSensorValues> sensor_history_ {};  // samples of SensorBatchGkcPacket
+  size_t sensor_history_size_ = 0;  // oldest samples are dropped beyond this
+  std::mutex sensor_history_mutex_ {};
   std::unique_ptr<uint32_t> handshake_number {};
+  uint8_t capabilities_ = 0;  // proposed in handshake #1, see GkcCapabilities
+  // agreed to in handshake #2, read by the threads sending control and bulk data
+  std::atomic<bool> compact_packets_ {false};
+  std::atomic<bool> extended_frames_ {false};
+  GkcBulkSender bulk_sender_ {};
+  GkcBulkReceiver bulk_receiver_ {};
+  std::shared_ptr<std::vector<uint8_t>> bulk_data_ {};  // destination of `pull_bulk`
+  uint16_t bulk_resource_ = 0;  // requested by `pull_bulk`
+  size_t bulk_max_size_ = 0;  // accepted by `pull_bulk`
+  bool bulk_pulling_ = false;  // the requested transfer started
+  std::mutex bulk_mutex_ {};
   std::unique_ptr<uint32_t> shutdown_number {};
+  LogFilterGkcPacket log_filter_ {};  // sent again after every handshake
+  std::mutex log_filter_mutex_ {};  // set by parameter callbacks, read by the receive thread
 
   GkcLifecycle current_state_ {GkcLifecycle::Uninitialized};
 
   // Inner working
+  bool send_packet(
+    const GkcPacket & packet,
+    const CommPriority & priority = CommPriority::Background);
   bool try_change_state(const GkcLifecycle & target_state, const uint32_t & timeout_ms);
   void stream_heartbeats();
   bool send_handshake();
   bool send_shutdown();
   bool send_firmware_version_request();
+  static uint32_t bulk_clock_ms();
 
   typedef ICommInterface::SharedPtr (* Creator)(ICommRecvHandler * handler);
   const std::unordered_map<std::string, Creator> comm_lookup_ = {
-    {"serial", CommUtils::CreateCommInterface<SerialInterface>}
+    {"serial", CommUtils::CreateCommInterface<SerialInterface>},
+    {"ethernet", CommUtils::CreateCommInterface<EthernetInterface>},
+    {"can", CommUtils::CreateCommInterface<CanInterface>},
+    {"sim", CommUtils::CreateCommInterface<SimInterface>}
   };
 };
 }  // namespace gkc
@@ -9,9 +9,22 @@
  *
  */
 
+#include <arpa/inet.h>
+#include <linux/can.h>
+#include <linux/can/raw.h>
+#include <net/if.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <iterator>
 #include <string>
-#include <thread>
 #include <memory>
+#include <vector>
 
 #include "tai_gokart_controller/comm.hpp"
 
@@ -19,21 +32,130 @@ namespace tritonai
 {
 namespace gkc
 {
+bool CommTxQueue::push(
+  const GkcBufferView & frame, const CommPriority & priority,
+  const Clock::time_point & now)
+{
+  auto & queue = queues_[static_cast<size_t>(priority)];
+  if (frame.size() > GkcFrameFormat::MAX_EXTENDED_FRAME_SIZE) {
+    ++queue.stats.frames_dropped;
+    return false;
+  }
+  Slot * slot = nullptr;
+  if (priority == CommPriority::Control && queue.stats.depth) {
+    // Only the newest command matters. It takes the place of the queued one.
+    slot = &queue.slots[queue.head];
+    slot->queued_at = now;
+    ++queue.stats.frames_replaced;
+  } else if (queue.stats.depth < DEPTH) {
+    slot = &queue.slots[(queue.head + queue.stats.depth) % DEPTH];
+    slot->queued_at = now;
+    ++queue.stats.depth;
+    queue.stats.max_depth = std::max(queue.stats.max_depth, queue.stats.depth);
+  } else {
+    ++queue.stats.frames_dropped;
+    return false;
+  }
+  std::copy(frame.begin(), frame.end(), slot->bytes.begin());
+  slot->size = frame.size();
+  return true;
+}
+
+size_t CommTxQueue::pop(
+  std::vector<uint8_t> & write, CommPriority & priority,
+  const bool & single_priority, const Clock::time_point & now)
+{
+  write.clear();
+  size_t num_frames = 0;
+  for (size_t i = 0; i < NUM_PRIORITIES; ++i) {
+    auto & queue = queues_[i];
+    if (num_frames && single_priority && queue.stats.depth) {
+      break;
+    } else if (!num_frames) {
+      priority = static_cast<CommPriority>(i);
+    }
+    while (queue.stats.depth) {
+      const auto & slot = queue.slots[queue.head];
+      if (write.size() + slot.size > MAX_WRITE_SIZE) {
+        // Keep the priority order: nothing of a lower priority skips ahead
+        if (num_frames) {
+          ++num_writes_;
+        }
+        return num_frames;
+      }
+      write.insert(write.end(), slot.bytes.begin(), slot.bytes.begin() + slot.size);
+      const auto queued_time = now - slot.queued_at;
+      queue.stats.total_queued_time += queued_time;
+      queue.stats.max_queued_time = std::max(queue.stats.max_queued_time, queued_time);
+      ++queue.stats.frames_written;
+      queue.head = (queue.head + 1) % DEPTH;
+      --queue.stats.depth;
+      ++num_frames;
+    }
+  }
+  if (num_frames) {
+    ++num_writes_;
+  }
+  return num_frames;
+}
+
+size_t CommTxQueue::size() const
+{
+  size_t size = 0;
+  for (const auto & queue : queues_) {
+    size += queue.stats.depth;
+  }
+  return size;
+}
+
+size_t ICommInterface::send(const GkcBufferView & frame, const CommPriority & priority)
+{
+  std::unique_lock<std::mutex> lock(tx_mutex_);
+  if (!tx_queue_.push(frame, priority)) {
+    return 0;
+  }
+  if (tx_writing_) {
+    // The writing thread checks the queue again before it stops
+    return frame.size();
+  }
+  tx_writing_ = true;
+  if (tx_write_.capacity() < CommTxQueue::MAX_WRITE_SIZE) {
+    tx_write_.reserve(CommTxQueue::MAX_WRITE_SIZE);
+  }
+  CommPriority write_priority;
+  while (tx_queue_.pop(tx_write_, write_priority, tx_single_priority_)) {
+    // Other threads keep queueing while this one writes
+    lock.unlock();
+    write(tx_write_, write_priority);
+    lock.lock();
+  }
+  tx_writing_ = false;
+  return frame.size();
+}
+
+CommTxQueue::Statistics ICommInterface::get_tx_statistics(const CommPriority & priority)
+{
+  std::lock_guard<std::mutex> lock(tx_mutex_);
+  return tx_queue_.get_statistics(priority);
+}
+
 SerialInterface::SerialInterface(ICommRecvHandler * handler)
 : ICommInterface(handler),
   owned_ctx{new drivers::common::IoContext(2)},
   driver_{new drivers::serial_driver::SerialDriver(*owned_ctx)}
 {
+  send_buffer_.reserve(CommTxQueue::MAX_WRITE_SIZE);
 }
 
 SerialInterface::~SerialInterface()
 {
   if (driver_ && driver_->port()->is_open()) {
-    running_ = false;
     close();
-    if (recv_thread && recv_thread->joinable()) {
-      recv_thread->join();
-    }
+  }
+  // A receive handler may still be running on an IO context thread. Wait for it to return
+  // before the driver and the members it uses are destroyed.
+  if (owned_ctx) {
+    owned_ctx->waitForExit();
   }
 }
 
@@ -59,8 +181,11 @@ bool SerialInterface::open()
   if (!driver_->port()->is_open()) {
     return false;
   }
-  // Start recv thread
-  recv_thread = std::unique_ptr<std::thread>(new std::thread(&SerialInterface::recv, this));
+  // Bytes are handed to `recv` on the IO context threads as soon as they arrive
+  driver_->port()->async_receive(
+    [this](const std::vector<uint8_t> & buffer, const size_t & bytes_read) {
+      recv(buffer, bytes_read);
+    });
   return true;
 }
 
@@ -83,30 +208,778 @@ bool SerialInterface::close()
   return !driver_->port()->is_open();
 }
 
-size_t SerialInterface::send(const GkcBuffer & buffer)
+size_t SerialInterface::write(const GkcBufferView & buffer, const CommPriority & priority)
 {
+  (void)priority;
   if (driver_ && driver_->port()->is_open()) {
-    driver_->port()->async_send(buffer);
-    return buffer.size();
+    // The driver only takes vectors. Reuse one so that steady-state writes do not allocate.
+    // Writing synchronously also keeps the bytes alive for as long as the driver needs them.
+    send_buffer_.assign(buffer.begin(), buffer.end());
+    return driver_->port()->send(send_buffer_);
   }
   return 0;
 }
 
-void SerialInterface::recv()
+void SerialInterface::recv(const std::vector<uint8_t> & buffer, const size_t & bytes_read)
 {
-  auto buffer = GkcBuffer(2048, 0);
-  while (running_ && driver_->port()->is_open()) {
-    auto bytes_read = driver_->port()->receive(buffer);
-    if (bytes_read > 0) {
-      handler_->receive(GkcBuffer(buffer.begin(), buffer.begin() + bytes_read));
-    }
-    std::this_thread::sleep_for(std::chrono::milliseconds(5));
-  }
+  handler_->receive(GkcBufferView(buffer.data(), std::min(bytes_read, buffer.size())));
 }
 
 CommIO SerialInterface::get_io_type()
 {
   return CommIO::Serial;
 }
+
+EthernetInterface::EthernetInterface(ICommRecvHandler * handler)
+: ICommInterface(handler)
+{
+}
+
+EthernetInterface::~EthernetInterface()
+{
+  close();
+}
+
+bool EthernetInterface::configure(const ConfigList & configs)
+{
+  const auto parse_address = [](
+    const std::string & ip, const int64_t & port, sockaddr_in & address) {
+      address = sockaddr_in();
+      address.sin_family = AF_INET;
+      address.sin_port = htons(static_cast<uint16_t>(port));
+      return port >= 0 && port <= UINT16_MAX &&
+             inet_pton(AF_INET, ip.c_str(), &address.sin_addr) == 1;
+    };
+  if (!parse_address(
+      configs.at("udp_local_ip"), configs.at("udp_local_port").integer, local_addr_) ||
+    !parse_address(
+      configs.at("udp_remote_ip"), configs.at("udp_remote_port").integer, remote_addr_))
+  {
+    return false;
+  }
+  socket_buffer_size_ = static_cast<int>(configs.at("udp_socket_buffer_size").integer);
+  dscp_ = static_cast<int>(configs.at("udp_dscp").integer);
+  return socket_buffer_size_ >= 0 && dscp_ >= 0 && dscp_ < 64;
+}
+
+bool EthernetInterface::open()
+{
+  if (is_open()) {
+    return true;
+  }
+  socket_ = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (socket_ < 0 || wake_fd_ < 0) {
+    close();
+    return false;
+  }
+  // DSCP is the upper 6 bits of the TOS byte
+  const int tos = dscp_ << 2;
+  bool ok = setsockopt(socket_, IPPROTO_IP, IP_TOS, &tos, sizeof(tos)) == 0;
+  for (const int option : {SO_SNDBUF, SO_RCVBUF}) {
+    ok = ok && (!socket_buffer_size_ ||
+      setsockopt(socket_, SOL_SOCKET, option, &socket_buffer_size_, sizeof(int)) == 0);
+  }
+  const auto local = reinterpret_cast<const sockaddr *>(&local_addr_);
+  const auto remote = reinterpret_cast<const sockaddr *>(&remote_addr_);
+  ok = ok && bind(socket_, local, sizeof(local_addr_)) == 0 &&
+    connect(socket_, remote, sizeof(remote_addr_)) == 0;
+  if (!ok) {
+    close();
+    return false;
+  }
+  recv_thread_ = std::make_unique<std::thread>(&EthernetInterface::recv, this);
+  return true;
+}
+
+bool EthernetInterface::is_open()
+{
+  return socket_ >= 0;
+}
+
+bool EthernetInterface::close()
+{
+  if (recv_thread_) {
+    const uint64_t stop = 1;
+    (void)!::write(wake_fd_, &stop, sizeof(stop));
+    if (recv_thread_->joinable()) {
+      recv_thread_->join();
+    }
+    recv_thread_.reset();
+  }
+  for (int * fd : {&socket_, &wake_fd_}) {
+    if (*fd >= 0) {
+      ::close(*fd);
+      *fd = -1;
+    }
+  }
+  return true;
+}
+
+CommIO EthernetInterface::get_io_type()
+{
+  return CommIO::Ethernet;
+}
+
+uint16_t EthernetInterface::get_local_port() const
+{
+  sockaddr_in address {};
+  socklen_t length = sizeof(address);
+  if (socket_ < 0 ||
+    getsockname(socket_, reinterpret_cast<sockaddr *>(&address), &length) != 0)
+  {
+    return 0;
+  }
+  return ntohs(address.sin_port);
+}
+
+size_t EthernetInterface::write(const GkcBufferView & buffer, const CommPriority & priority)
+{
+  (void)priority;
+  if (socket_ < 0) {
+    return 0;
+  }
+  std::array<iovec, BATCH_SIZE> iovs;
+  std::array<mmsghdr, BATCH_SIZE> msgs;
+  size_t sent = 0;
+  while (sent < buffer.size()) {
+    // Split the rest into as many datagrams as one call takes
+    size_t num_msgs = 0;
+    for (size_t offset = sent; offset < buffer.size() && num_msgs < BATCH_SIZE;
+      offset += MAX_DATAGRAM_SIZE)
+    {
+      iovs[num_msgs].iov_base = const_cast<uint8_t *>(buffer.data() + offset);
+      iovs[num_msgs].iov_len = std::min(MAX_DATAGRAM_SIZE, buffer.size() - offset);
+      msgs[num_msgs] = mmsghdr();
+      msgs[num_msgs].msg_hdr.msg_iov = &iovs[num_msgs];
+      msgs[num_msgs].msg_hdr.msg_iovlen = 1;
+      ++num_msgs;
+    }
+    const int num_sent = sendmmsg(socket_, msgs.data(), static_cast<unsigned int>(num_msgs), 0);
+    if (num_sent > 0) {
+      for (int i = 0; i < num_sent; ++i) {
+        sent += msgs[i].msg_len;
+      }
+    } else if (num_sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      // The send buffer is full. Wait a little for it to drain.
+      pollfd writable {socket_, POLLOUT, 0};
+      if (poll(&writable, 1, SEND_TIMEOUT_MS) <= 0) {
+        break;
+      }
+    } else if (num_sent < 0 && errno != EINTR) {
+      break;
+    }
+  }
+  return sent;
+}
+
+namespace
+{
+/**
+ * @brief Receive from `socket` until `wake_fd` is signalled or the socket fails. Every time the
+ * socket is readable, drain it with a batch of up to `N` messages per call, and pass each one to
+ * `on_message(buffer, size)`.
+ */
+template<size_t N, typename BufferT, typename OnMessageT>
+void poll_and_drain(
+  const int & socket, const int & wake_fd, std::array<BufferT, N> & buffers,
+  const OnMessageT & on_message)
+{
+  std::array<iovec, N> iovs;
+  std::array<mmsghdr, N> msgs;
+  while (true) {
+    std::array<pollfd, 2> fds {{{socket, POLLIN, 0}, {wake_fd, POLLIN, 0}}};
+    if (poll(fds.data(), fds.size(), -1) < 0 && errno != EINTR) {
+      return;
+    }
+    if (fds[1].revents || fds[0].revents & POLLNVAL) {
+      return;
+    }
+    if (fds[0].revents & POLLERR) {
+      // Poll reports a pending error until it is read, so read it to not spin
+      int error = 0;
+      socklen_t error_size = sizeof(error);
+      getsockopt(socket, SOL_SOCKET, SO_ERROR, &error, &error_size);
+    }
+    if (!(fds[0].revents & POLLIN)) {
+      continue;
+    }
+    int num_received = 0;
+    do {
+      for (size_t i = 0; i < N; ++i) {
+        iovs[i].iov_base = &buffers[i];
+        iovs[i].iov_len = sizeof(buffers[i]);
+        msgs[i] = mmsghdr();
+        msgs[i].msg_hdr.msg_iov = &iovs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+      }
+      num_received = recvmmsg(socket, msgs.data(), N, MSG_DONTWAIT, nullptr);
+      for (int i = 0; i < num_received; ++i) {
+        on_message(buffers[i], static_cast<size_t>(msgs[i].msg_len));
+      }
+    } while (num_received == static_cast<int>(N));
+  }
+}
+}  // namespace
+
+void EthernetInterface::recv()
+{
+  // Pending socket errors are e.g. ICMP port unreachable while the MCU is down
+  std::array<std::array<uint8_t, MAX_DATAGRAM_SIZE>, BATCH_SIZE> buffers;
+  poll_and_drain(
+    socket_, wake_fd_, buffers,
+    [this](const std::array<uint8_t, MAX_DATAGRAM_SIZE> & datagram, const size_t & size) {
+      handler_->receive(GkcBufferView(datagram.data(), size));
+    });
+}
+
+bool CanReassembler::push(const GkcBufferView & payload)
+{
+  if (payload.empty()) {
+    return false;
+  }
+  const uint8_t sequence = payload[0] & CanFragmenter::SEQUENCE_MASK;
+  size_t header_size = CanFragmenter::HEADER_SIZE;
+  if (payload[0] & CanFragmenter::FIRST) {
+    if (receiving_) {
+      // The previous message never completed
+      ++num_dropped_;
+    }
+    receiving_ = payload.size() >= CanFragmenter::FIRST_HEADER_SIZE;
+    if (!receiving_) {
+      return false;
+    }
+    size_ = payload[1] | static_cast<size_t>(payload[2]) << 8;
+    message_.clear();
+    next_sequence_ = 0;
+    header_size = CanFragmenter::FIRST_HEADER_SIZE;
+  } else if (!receiving_) {
+    // The rest of a message whose start was missed
+    return false;
+  }
+  if (sequence != next_sequence_) {
+    ++num_dropped_;
+    receiving_ = false;
+    return false;
+  }
+  next_sequence_ = (next_sequence_ + 1) & CanFragmenter::SEQUENCE_MASK;
+  const size_t size = std::min(payload.size() - header_size, size_ - message_.size());
+  message_.insert(
+    message_.end(), payload.begin() + header_size, payload.begin() + header_size + size);
+  if (message_.size() < size_) {
+    return false;
+  }
+  receiving_ = false;
+  return true;
+}
+
+CanInterface::CanInterface(ICommRecvHandler * handler)
+: ICommInterface(handler)
+{
+  // A message takes its priority's arbitration ID, so it must not mix priorities
+  tx_single_priority_ = true;
+}
+
+CanInterface::~CanInterface()
+{
+  close();
+}
+
+bool CanInterface::configure(const ConfigList & configs)
+{
+  interface_name_ = static_cast<std::string>(configs.at("can_interface"));
+  can_fd_ = configs.at("can_fd").boolean;
+  const int64_t tx_base_id = configs.at("can_tx_base_id").integer;
+  const int64_t rx_base_id = configs.at("can_rx_base_id").integer;
+  // Standard 11-bit IDs, one per priority, in ranges aligned for the receive filter
+  static constexpr int64_t NUM_IDS = CommTxQueue::NUM_PRIORITIES;
+  const auto valid = [](const int64_t & base_id) {
+      return base_id >= 0 && base_id + NUM_IDS - 1 <= CAN_SFF_MASK && base_id % NUM_IDS == 0;
+    };
+  if (!valid(tx_base_id) || !valid(rx_base_id) || tx_base_id == rx_base_id) {
+    return false;
+  }
+  tx_base_id_ = static_cast<uint32_t>(tx_base_id);
+  rx_base_id_ = static_cast<uint32_t>(rx_base_id);
+  return !interface_name_.empty();
+}
+
+bool CanInterface::open()
+{
+  if (is_open()) {
+    return true;
+  }
+  socket_ = socket(PF_CAN, SOCK_RAW | SOCK_NONBLOCK | SOCK_CLOEXEC, CAN_RAW);
+  wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (socket_ < 0 || wake_fd_ < 0) {
+    close();
+    return false;
+  }
+  sockaddr_can address {};
+  address.can_family = AF_CAN;
+  address.can_ifindex = static_cast<int>(if_nametoindex(interface_name_.c_str()));
+  // Only the MCU's data frames with standard IDs
+  can_filter filter {};
+  filter.can_id = rx_base_id_;
+  filter.can_mask = (CAN_SFF_MASK & ~(CommTxQueue::NUM_PRIORITIES - 1)) |
+    CAN_EFF_FLAG | CAN_RTR_FLAG;
+  const int enable_fd = 1;
+  const bool ok = address.can_ifindex &&
+    setsockopt(socket_, SOL_CAN_RAW, CAN_RAW_FILTER, &filter, sizeof(filter)) == 0 &&
+    (!can_fd_ ||
+    setsockopt(socket_, SOL_CAN_RAW, CAN_RAW_FD_FRAMES, &enable_fd, sizeof(enable_fd)) == 0) &&
+    bind(socket_, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) == 0;
+  if (!ok) {
+    close();
+    return false;
+  }
+  for (auto & reassembler : reassemblers_) {
+    reassembler = CanReassembler();
+  }
+  recv_thread_ = std::make_unique<std::thread>(&CanInterface::recv, this);
+  return true;
+}
+
+bool CanInterface::is_open()
+{
+  return socket_ >= 0;
+}
+
+bool CanInterface::close()
+{
+  if (recv_thread_) {
+    const uint64_t stop = 1;
+    (void)!::write(wake_fd_, &stop, sizeof(stop));
+    if (recv_thread_->joinable()) {
+      recv_thread_->join();
+    }
+    recv_thread_.reset();
+  }
+  for (int * fd : {&socket_, &wake_fd_}) {
+    if (*fd >= 0) {
+      ::close(*fd);
+      *fd = -1;
+    }
+  }
+  return true;
+}
+
+CommIO CanInterface::get_io_type()
+{
+  return CommIO::CAN;
+}
+
+size_t CanInterface::write(const GkcBufferView & buffer, const CommPriority & priority)
+{
+  if (socket_ < 0 || buffer.size() > UINT16_MAX) {
+    return 0;
+  }
+  const canid_t id = tx_base_id_ + static_cast<canid_t>(priority);
+  const size_t mtu = can_fd_ ? CANFD_MTU : CAN_MTU;
+  std::array<canfd_frame, BATCH_SIZE> frames;
+  std::array<iovec, BATCH_SIZE> iovs;
+  std::array<mmsghdr, BATCH_SIZE> msgs;
+  size_t num_frames = 0;
+
+  // Send the batched CAN frames, waiting for room in the transmit queue if needed
+  const auto flush = [&]() {
+      size_t num_sent = 0;
+      const auto deadline = std::chrono::steady_clock::now() +
+        std::chrono::milliseconds(SEND_TIMEOUT_MS);
+      while (num_sent < num_frames) {
+        const int result = sendmmsg(
+          socket_, msgs.data() + num_sent, static_cast<unsigned int>(num_frames - num_sent), 0);
+        if (result > 0) {
+          num_sent += static_cast<size_t>(result);
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS) {
+          // ENOBUFS does not wake poll(), so check again shortly
+          pollfd writable {socket_, POLLOUT, 0};
+          poll(&writable, 1, 1);
+          if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+          }
+        } else if (errno != EINTR) {
+          return false;
+        }
+      }
+      num_frames = 0;
+      return true;
+    };
+
+  const bool sent = CanFragmenter::split(
+    buffer, can_fd_ ? CANFD_MAX_DLEN : CAN_MAX_DLEN,
+    [&](const GkcBufferView & payload) {
+      auto & frame = frames[num_frames];
+      frame = canfd_frame();
+      frame.can_id = id;
+      // CAN-FD lengths above 8 bytes come in steps. The padding is ignored.
+      static constexpr size_t FD_LENGTHS[] = {12, 16, 20, 24, 32, 48, 64};
+      size_t length = payload.size();
+      if (length > CAN_MAX_DLEN) {
+        length = *std::lower_bound(std::begin(FD_LENGTHS), std::end(FD_LENGTHS), length);
+      }
+      frame.len = static_cast<uint8_t>(length);
+      std::copy(payload.begin(), payload.end(), frame.data);
+      iovs[num_frames].iov_base = &frame;
+      iovs[num_frames].iov_len = mtu;
+      msgs[num_frames] = mmsghdr();
+      msgs[num_frames].msg_hdr.msg_iov = &iovs[num_frames];
+      msgs[num_frames].msg_hdr.msg_iovlen = 1;
+      return ++num_frames < BATCH_SIZE || flush();
+    });
+  // A partly sent message is dropped by the receiver
+  return sent && flush() ? buffer.size() : 0;
+}
+
+void CanInterface::recv()
+{
+  // Pending socket errors are e.g. ENETDOWN when the CAN interface goes down
+  std::array<canfd_frame, BATCH_SIZE> frames;
+  poll_and_drain(
+    socket_, wake_fd_, frames, [this](const canfd_frame & frame, const size_t &) {
+      const size_t index = (frame.can_id & CAN_SFF_MASK) - rx_base_id_;
+      if (index >= reassemblers_.size() || frame.len > CANFD_MAX_DLEN) {
+        return;
+      }
+      auto & reassembler = reassemblers_[index];
+      if (reassembler.push(GkcBufferView(frame.data, frame.len))) {
+        handler_->receive(reassembler.message());
+      }
+    });
+}
+
+SimInterface::SimInterface(ICommRecvHandler * handler)
+: ICommInterface(handler)
+{
+}
+
+SimInterface::~SimInterface()
+{
+  close();
+}
+
+bool SimInterface::configure(const ConfigList & configs)
+{
+  const auto heartbeat_hz = configs.at("sim_heartbeat_hz").integer;
+  const auto sensor_hz = configs.at("sim_sensor_hz").integer;
+  const auto initialization_time_ms = configs.at("sim_initialization_time_ms").integer;
+  if (heartbeat_hz <= 0 || sensor_hz < 0 || initialization_time_ms < 0) {
+    return false;
+  }
+  const auto interval = [](const int64_t & hz) {
+      return std::chrono::duration_cast<SimMcu::Clock::duration>(
+        std::chrono::duration<double>(1.0 / static_cast<double>(hz)));
+    };
+  heartbeat_interval_ = interval(heartbeat_hz);
+  sensor_interval_ = sensor_hz ? interval(sensor_hz) : SimMcu::Clock::duration::zero();
+  initialization_time_ = std::chrono::milliseconds(initialization_time_ms);
+  return true;
+}
+
+bool SimInterface::open()
+{
+  if (is_open()) {
+    return true;
+  }
+  // Like a serial link, the MCU's frames go to the handler from a thread of the interface
+  mcu_ = std::make_unique<SimMcu>(
+    [this](const GkcBufferView & frame) {
+      if (handler_) {
+        handler_->receive(frame);
+      }
+    }, heartbeat_interval_, sensor_interval_, initialization_time_);
+  written_.clear();
+  running_ = true;
+  mcu_thread_ = std::make_unique<std::thread>(&SimInterface::run, this);
+  return true;
+}
+
+bool SimInterface::is_open()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return running_;
+}
+
+bool SimInterface::close()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    running_ = false;
+  }
+  wake_.notify_one();
+  if (mcu_thread_) {
+    if (mcu_thread_->joinable()) {
+      mcu_thread_->join();
+    }
+    mcu_thread_.reset();
+  }
+  mcu_.reset();
+  return true;
+}
+
+CommIO SimInterface::get_io_type()
+{
+  return CommIO::Sim;
+}
+
+size_t SimInterface::write(const GkcBufferView & buffer, const CommPriority & priority)
+{
+  (void)priority;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_) {
+      return 0;
+    }
+    written_.insert(written_.end(), buffer.begin(), buffer.end());
+  }
+  wake_.notify_one();
+  return buffer.size();
+}
+
+void SimInterface::run()
+{
+  std::vector<uint8_t> bytes {};
+  auto next_tick = SimMcu::Clock::now();
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (running_) {
+    wake_.wait_until(lock, next_tick, [this]() {return !running_ || !written_.empty();});
+    if (!running_) {
+      break;
+    }
+    bytes.swap(written_);
+    // The MCU's frames reach the handler, which may write back, without the lock
+    lock.unlock();
+    const auto now = SimMcu::Clock::now();
+    if (!bytes.empty()) {
+      mcu_->receive(GkcBufferView(bytes), now);
+      bytes.clear();
+    }
+    next_tick = mcu_->tick(now);
+    lock.lock();
+  }
+}
+
+CommImpairment::CommImpairment(const Parameters & parameters, const uint64_t & seed)
+: parameters_(parameters),
+  generator_(seed),
+  jitter_generator_(~seed),
+  // A rate of 0 is not a valid distribution, and its distribution is not used
+  loss_gap_(parameters.loss_rate > 0.0 ? parameters.loss_rate : 1.0),
+  corruption_gap_(parameters.corruption_rate > 0.0 ? parameters.corruption_rate : 1.0)
+{
+  until_loss_ = loss_gap_(generator_);
+  until_corruption_ = corruption_gap_(generator_);
+}
+
+CommImpairment::Clock::time_point CommImpairment::apply(
+  std::vector<uint8_t> & bytes,
+  const Clock::time_point & now)
+{
+  // The n-th byte on the link is impaired the same however the writes split the bytes
+  std::uniform_int_distribution<int> bit(0, 7);
+  const size_t size = bytes.size();
+  size_t kept = 0;
+  for (size_t i = 0; i < size; ++i) {
+    if (parameters_.loss_rate > 0.0 && until_loss_-- == 0) {
+      until_loss_ = loss_gap_(generator_);
+      ++stats_.bytes_lost;
+      continue;
+    }
+    uint8_t byte = bytes[i];
+    if (parameters_.corruption_rate > 0.0 && until_corruption_-- == 0) {
+      until_corruption_ = corruption_gap_(generator_);
+      byte ^= static_cast<uint8_t>(1 << bit(generator_));
+      ++stats_.bytes_corrupted;
+    }
+    bytes[kept++] = byte;
+  }
+  bytes.resize(kept);
+  stats_.bytes_sent += size;
+
+  // Lost bytes take their time on the link too
+  link_free_at_ = std::max(now, link_free_at_);
+  if (parameters_.bandwidth_bps) {
+    link_free_at_ += std::chrono::duration_cast<Clock::duration>(
+      std::chrono::duration<double>(
+        static_cast<double>(size * 8) / static_cast<double>(parameters_.bandwidth_bps)));
+  }
+  auto arrival = link_free_at_ + parameters_.delay;
+  if (parameters_.jitter.count() > 0) {
+    std::uniform_int_distribution<Clock::rep> jitter(0, parameters_.jitter.count());
+    arrival += Clock::duration(jitter(jitter_generator_));
+  }
+  last_arrival_ = std::max(arrival, last_arrival_);
+  return last_arrival_;
+}
+
+ImpairedInterface::ImpairedInterface(
+  ICommRecvHandler * handler,
+  const ICommInterface::SharedPtr & inner)
+: ICommInterface(handler), inner_(inner)
+{
+  // Writes reach the inner interface as they are popped, e.g. one priority at a time for CAN
+  tx_single_priority_ = inner_->tx_single_priority_;
+  inner_->register_handler(this);
+}
+
+ImpairedInterface::~ImpairedInterface()
+{
+  close();
+}
+
+bool ImpairedInterface::configure(const ConfigList & configs)
+{
+  const auto delay_ms = configs.at("impairment_delay_ms").integer;
+  const auto jitter_ms = configs.at("impairment_jitter_ms").integer;
+  const auto bandwidth_bps = configs.at("impairment_bandwidth_bps").integer;
+  const auto loss_rate = configs.at("impairment_loss_rate").floating;
+  const auto corruption_rate = configs.at("impairment_corruption_rate").floating;
+  const auto valid_rate = [](const double & rate) {return rate >= 0.0 && rate <= 1.0;};
+  if (delay_ms < 0 || jitter_ms < 0 || bandwidth_bps < 0 ||
+    !valid_rate(loss_rate) || !valid_rate(corruption_rate))
+  {
+    return false;
+  }
+  parameters_.delay = std::chrono::milliseconds(delay_ms);
+  parameters_.jitter = std::chrono::milliseconds(jitter_ms);
+  parameters_.bandwidth_bps = static_cast<uint64_t>(bandwidth_bps);
+  parameters_.loss_rate = loss_rate;
+  parameters_.corruption_rate = corruption_rate;
+  seed_ = static_cast<uint64_t>(configs.at("impairment_seed").integer);
+  return inner_->configure(configs);
+}
+
+bool ImpairedInterface::open()
+{
+  if (is_open()) {
+    return true;
+  }
+  {
+    // Every open replays the same impairments
+    std::lock_guard<std::mutex> lock(mutex_);
+    tx_impairment_ = std::make_unique<CommImpairment>(parameters_, seed_);
+    rx_impairment_ = std::make_unique<CommImpairment>(parameters_, seed_ + 1);
+    tx_chunks_.clear();
+    rx_chunks_.clear();
+    running_ = true;
+  }
+  deliver_thread_ = std::make_unique<std::thread>(&ImpairedInterface::deliver, this);
+  if (!inner_->open()) {
+    close();
+    return false;
+  }
+  return true;
+}
+
+bool ImpairedInterface::is_open()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_) {
+      return false;
+    }
+  }
+  return inner_->is_open();
+}
+
+bool ImpairedInterface::close()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    running_ = false;
+  }
+  wake_.notify_one();
+  if (deliver_thread_) {
+    if (deliver_thread_->joinable()) {
+      deliver_thread_->join();
+    }
+    deliver_thread_.reset();
+  }
+  return inner_->close();
+}
+
+CommIO ImpairedInterface::get_io_type()
+{
+  return inner_->get_io_type();
+}
+
+CommImpairment::Statistics ImpairedInterface::get_tx_impairment_statistics()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return tx_impairment_ ? tx_impairment_->get_statistics() : CommImpairment::Statistics();
+}
+
+CommImpairment::Statistics ImpairedInterface::get_rx_impairment_statistics()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return rx_impairment_ ? rx_impairment_->get_statistics() : CommImpairment::Statistics();
+}
+
+size_t ImpairedInterface::write(const GkcBufferView & buffer, const CommPriority & priority)
+{
+  auto chunk = Chunk{{}, std::vector<uint8_t>(buffer.begin(), buffer.end()), priority};
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_) {
+      return 0;
+    }
+    chunk.arrival = tx_impairment_->apply(chunk.bytes);
+    tx_chunks_.push_back(std::move(chunk));
+  }
+  wake_.notify_one();
+  // Like a link, lost bytes count as written
+  return buffer.size();
+}
+
+void ImpairedInterface::receive(const GkcBufferView & buffer)
+{
+  auto chunk = Chunk{{}, std::vector<uint8_t>(buffer.begin(), buffer.end()),
+    CommPriority::Background};
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_) {
+      return;
+    }
+    chunk.arrival = rx_impairment_->apply(chunk.bytes);
+    rx_chunks_.push_back(std::move(chunk));
+  }
+  wake_.notify_one();
+}
+
+void ImpairedInterface::deliver()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (running_) {
+    // The chunk to arrive first
+    std::deque<Chunk> * chunks = nullptr;
+    for (auto * candidate : {&tx_chunks_, &rx_chunks_}) {
+      if (!candidate->empty() &&
+        (!chunks || candidate->front().arrival < chunks->front().arrival))
+      {
+        chunks = candidate;
+      }
+    }
+    if (!chunks) {
+      wake_.wait(lock);
+      continue;
+    } else if (chunks->front().arrival > CommImpairment::Clock::now()) {
+      // Woken early by a new chunk, which may arrive first
+      wake_.wait_until(lock, chunks->front().arrival);
+      continue;
+    }
+    const bool outgoing = chunks == &tx_chunks_;
+    const Chunk chunk = std::move(chunks->front());
+    chunks->pop_front();
+    // The handler may write back, which takes the lock
+    lock.unlock();
+    // Nothing arrives of a chunk whose bytes were all lost
+    if (outgoing && !chunk.bytes.empty()) {
+      inner_->write(chunk.bytes, chunk.priority);
+    } else if (!outgoing && !chunk.bytes.empty() && handler_) {
+      handler_->receive(chunk.bytes);
+    }
+    lock.lock();
+  }
+}
 }  // namespace gkc
 }  // namespace tritonai
@@ -0,0 +1,367 @@
+/**
+ * @file sim_mcu.cpp
+ * @brief A model of the MCU firmware, for runs without hardware
+ * @version 0.1
+ *
+ * @copyright Copyright 2026 Triton AI
+ *
+ */
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <string>
+
+#include "tai_gokart_controller/sim_mcu.hpp"
+#include "tai_gokart_packet/version.hpp"
+
+namespace tritonai
+{
+namespace gkc
+{
+SimMcu::SimMcu(
+  const SendCallback & send, const Clock::duration & heartbeat_interval,
+  const Clock::duration & sensor_interval, const Clock::duration & initialization_time,
+  const Clock::time_point & now)
+: send_(send),
+  factory_(this, GkcPacketUtils::debug_cout),
+  heartbeat_interval_(heartbeat_interval),
+  sensor_interval_(sensor_interval),
+  initialization_time_(initialization_time),
+  now_(now),
+  next_heartbeat_(now),
+  next_sensor_(now),
+  initialized_at_(now),
+  updated_at_(now)
+{
+  config_.values = ConfigGkcPacket::Configurables();
+  sensors_.values = SensorGkcPacket::SensorValues();
+}
+
+void SimMcu::receive(const GkcBufferView & buffer, const Clock::time_point & now)
+{
+  // Commands apply from now on
+  update_sensors(now);
+  now_ = now;
+  factory_.Receive(buffer);
+}
+
+SimMcu::Clock::time_point SimMcu::tick(const Clock::time_point & now)
+{
+  now_ = now;
+  if (state_ == GkcLifecycle::Initializing && now >= initialized_at_) {
+    // The self-test always passes
+    transition(GkcLifecycle::Inactive);
+  }
+  update_sensors(now);
+
+  // Skip the ones missed, e.g. while the thread was not scheduled
+  if (now >= next_heartbeat_) {
+    send_heartbeat();
+    while (next_heartbeat_ <= now) {
+      next_heartbeat_ += heartbeat_interval_;
+    }
+  }
+  const bool streaming = sensor_interval_.count() > 0 && state_ != GkcLifecycle::Uninitialized;
+  if (streaming && now >= next_sensor_) {
+    if (compact_packets_) {
+      send_packet(CompactSensorGkcPacket(sensors_));
+    } else {
+      send_packet(sensors_);
+    }
+    while (next_sensor_ <= now) {
+      next_sensor_ += sensor_interval_;
+    }
+  }
+
+  auto next = next_heartbeat_;
+  if (streaming) {
+    next = std::min(next, next_sensor_);
+  }
+  if (state_ == GkcLifecycle::Initializing) {
+    next = std::min(next, initialized_at_);
+  }
+  return next;
+}
+
+void SimMcu::send_packet(const GkcPacket & packet)
+{
+  std::array<uint8_t, GkcFrameFormat::MAX_EXTENDED_FRAME_SIZE> frame;
+  const auto frame_size = factory_.Send(packet, frame);
+  if (frame_size) {
+    send_(GkcBufferView(frame.data(), frame_size));
+  }
+}
+
+void SimMcu::send_heartbeat()
+{
+  auto heartbeat = HeartbeatGkcPacket();
+  heartbeat.rolling_counter = heartbeat_counter_++;
+  heartbeat.state = static_cast<uint8_t>(state_);
+  send_packet(heartbeat);
+}
+
+void SimMcu::send_log(const LogPacket::Severity & level, const std::string & what)
+{
+  // Wraps around. The filter only uses differences.
+  const auto now_ms = static_cast<uint32_t>(
+    std::chrono::duration_cast<std::chrono::milliseconds>(now_.time_since_epoch()).count());
+  if (!log_filter_.allow(level, now_ms)) {
+    return;
+  }
+  auto log = LogPacket();
+  log.level = level;
+  log.what = what;
+  send_packet(log);
+}
+
+void SimMcu::transition(const GkcLifecycle & state)
+{
+  state_ = state;
+  // The PC waits for the new state, so report it right away
+  send_heartbeat();
+}
+
+void SimMcu::reject_transition(const GkcLifecycle & requested_state)
+{
+  send_log(
+    LogPacket::Severity::WARNING,
+    "Transition from state " + std::to_string(state_) + " to state " +
+    std::to_string(requested_state) + " rejected.");
+}
+
+void SimMcu::update_sensors(const Clock::time_point & now)
+{
+  const float dt = std::chrono::duration<float>(now - updated_at_).count();
+  updated_at_ = now;
+
+  // Commands only actuate while active. Otherwise the parking or emergency brake is on.
+  const auto & config = config_.values;
+  float throttle = 0.0f;
+  float brake = state_ == GkcLifecycle::Uninitialized ? 0.0f : config.max_brake;
+  float steering = sensors_.values.steering_angle_rad;
+  if (state_ == GkcLifecycle::Active) {
+    throttle = std::min(std::max(command_.throttle, 0.0f), config.max_throttle);
+    brake = std::min(std::max(command_.brake, 0.0f), config.max_brake);
+    steering = std::min(
+      std::max(command_.steering, config.max_steering_right), config.max_steering_left);
+  }
+
+  // The wheels spin up to the throttle and stop when braking
+  auto & values = sensors_.values;
+  const float target_speed = brake > 0.0f ? 0.0f : throttle * MAX_WHEEL_SPEED_RPM;
+  const float speed = values.wheel_speed_fl +
+    (target_speed - values.wheel_speed_fl) * std::min(dt / WHEEL_SPEED_TIME_CONSTANT_S, 1.0f);
+  values.wheel_speed_fl = speed;
+  values.wheel_speed_fr = speed;
+  values.wheel_speed_rl = speed;
+  values.wheel_speed_rr = speed;
+  values.voltage = BATTERY_VOLTAGE;
+  values.amperage = throttle * MAX_AMPERAGE;
+  values.brake_pressure = brake;
+  values.throttle_pos = throttle;
+  values.steering_angle_rad = steering;
+  values.servo_angle_rad = steering - config.neutral_steering;
+}
+
+void SimMcu::packet_callback(const Handshake1GkcPacket & packet)
+{
+  auto reply = Handshake2GkcPacket();
+  reply.seq_number = packet.seq_number + 1;
+  reply.capabilities = packet.capabilities & CAPABILITIES;
+  send_packet(reply);
+
+  // Handshake #2 goes out in legacy framing, everything after it in the agreed encoding
+  factory_.set_framing(
+    reply.capabilities & GkcCapabilities::COBS_FRAMING ? GkcFraming::Cobs : GkcFraming::Legacy);
+  factory_.set_extended_frames(reply.capabilities & GkcCapabilities::EXTENDED_FRAMES);
+  compact_packets_ = reply.capabilities & GkcCapabilities::COMPACT_PACKETS;
+}
+
+void SimMcu::packet_callback(const Handshake2GkcPacket & packet)
+{
+  (void)packet;
+}
+
+void SimMcu::packet_callback(const GetFirmwareVersionGkcPacket & packet)
+{
+  (void)packet;
+  auto reply = FirmwareVersionGkcPacket();
+  reply.major = GkcPacketLibVersion::MAJOR;
+  reply.minor = GkcPacketLibVersion::MINOR;
+  reply.patch = GkcPacketLibVersion::PATCH;
+  send_packet(reply);
+}
+
+void SimMcu::packet_callback(const FirmwareVersionGkcPacket & packet)
+{
+  (void)packet;
+}
+
+void SimMcu::packet_callback(const ResetMcuGkcPacket & packet)
+{
+  (void)packet;
+  // Like a reboot: back to the state and encoding before the handshake
+  factory_.set_framing(GkcFraming::Legacy);
+  factory_.set_extended_frames(false);
+  compact_packets_ = false;
+  command_ = ControlGkcPacket();
+  transition(GkcLifecycle::Uninitialized);
+}
+
+void SimMcu::packet_callback(const HeartbeatGkcPacket & packet)
+{
+  // Only for the comm watchdog, which is not modelled
+  (void)packet;
+}
+
+void SimMcu::packet_callback(const ConfigGkcPacket & packet)
+{
+  if (state_ != GkcLifecycle::Uninitialized) {
+    send_log(
+      LogPacket::Severity::WARNING,
+      "Configuration ignored in state " + std::to_string(state_) + ".");
+    return;
+  }
+  config_ = packet;
+  initialized_at_ = now_ + initialization_time_;
+  next_sensor_ = now_;
+  transition(GkcLifecycle::Initializing);
+}
+
+void SimMcu::packet_callback(const StateTransitionGkcPacket & packet)
+{
+  const auto requested_state = static_cast<GkcLifecycle>(packet.requested_state);
+  bool allowed = false;
+  switch (requested_state) {
+    case GkcLifecycle::Active:
+      allowed = state_ == GkcLifecycle::Inactive;
+      break;
+    case GkcLifecycle::Inactive:
+      if (state_ == GkcLifecycle::Active &&
+        sensors_.values.wheel_speed_fl >= STOPPED_WHEEL_SPEED_RPM)
+      {
+        // A moving vehicle is not paused but stopped
+        send_log(LogPacket::Severity::ERROR, "Pause requested while moving.");
+        transition(GkcLifecycle::Emergency);
+        return;
+      }
+      allowed = state_ == GkcLifecycle::Active;
+      break;
+    case GkcLifecycle::Shutdown:
+      allowed = state_ == GkcLifecycle::Active || state_ == GkcLifecycle::Inactive;
+      break;
+    case GkcLifecycle::Emergency:
+      allowed = state_ != GkcLifecycle::Uninitialized;
+      break;
+    case GkcLifecycle::Uninitialized:
+      allowed = state_ == GkcLifecycle::Emergency;
+      break;
+    default:
+      // Initializing is only entered with a configuration
+      break;
+  }
+  if (!allowed) {
+    reject_transition(requested_state);
+    return;
+  }
+  if (requested_state == GkcLifecycle::Active) {
+    // No command from before the activation
+    command_ = ControlGkcPacket();
+  }
+  transition(requested_state);
+}
+
+void SimMcu::packet_callback(const LogFilterGkcPacket & packet)
+{
+  log_filter_.configure(packet);
+}
+
+void SimMcu::packet_callback(const ControlGkcPacket & packet)
+{
+  if (state_ == GkcLifecycle::Active) {
+    command_ = packet;
+  }
+}
+
+void SimMcu::packet_callback(const SensorGkcPacket & packet)
+{
+  (void)packet;
+}
+
+void SimMcu::packet_callback(const Shutdown1GkcPacket & packet)
+{
+  if (state_ != GkcLifecycle::Shutdown) {
+    send_log(LogPacket::Severity::WARNING, "Shutdown #1 received before a shutdown request.");
+    return;
+  }
+  auto reply = Shutdown2GkcPacket();
+  reply.seq_number = packet.seq_number + 1;
+  send_packet(reply);
+  // Shutdowns end in emergency stop, keeping the brake on
+  transition(GkcLifecycle::Emergency);
+}
+
+void SimMcu::packet_callback(const Shutdown2GkcPacket & packet)
+{
+  (void)packet;
+}
+
+void SimMcu::packet_callback(const LogPacket & packet)
+{
+  (void)packet;
+}
+
+void SimMcu::packet_callback(const LogIdGkcPacket & packet)
+{
+  (void)packet;
+}
+
+void SimMcu::packet_callback(const CompactSensorGkcPacket & packet)
+{
+  (void)packet;
+}
+
+void SimMcu::packet_callback(const CompactControlGkcPacket & packet)
+{
+  packet_callback(packet.expand());
+}
+
+void SimMcu::packet_callback(const SensorDeltaGkcPacket & packet)
+{
+  (void)packet;
+}
+
+void SimMcu::packet_callback(const SensorResyncGkcPacket & packet)
+{
+  // Sensor deltas are not agreed to
+  (void)packet;
+}
+
+void SimMcu::packet_callback(const SensorBatchGkcPacket & packet)
+{
+  (void)packet;
+}
+
+void SimMcu::packet_callback(const BulkRequestGkcPacket & packet)
+{
+  // No resources to transfer
+  (void)packet;
+}
+
+void SimMcu::packet_callback(const BulkStartGkcPacket & packet)
+{
+  (void)packet;
+}
+
+void SimMcu::packet_callback(const BulkChunkGkcPacket & packet)
+{
+  (void)packet;
+}
+
+void SimMcu::packet_callback(const BulkAckGkcPacket & packet)
+{
+  (void)packet;
+}
+}  // namespace gkc
+}  // namespace tritonai
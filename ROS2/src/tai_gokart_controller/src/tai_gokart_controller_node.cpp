@@ -10,6 +10,8 @@
  */
 #include <string>
 #include <memory>
+#include <stdexcept>
+#include <vector>
 
 #include "tai_gokart_controller/tai_gokart_controller_node.hpp"
 
@@ -27,8 +29,54 @@ GkcNode::GkcNode(const rclcpp::NodeOptions & options)
     Config{"serial_port",
       Configurable(declare_parameter<std::string>("serial.port", "/dev/ttyACM0"))},
     Config{"baud_rate", Configurable(declare_parameter<int64_t>("serial.baud_rate", 115200))},
+    Config{"udp_local_ip",
+      Configurable(declare_parameter<std::string>("ethernet.local_ip", "0.0.0.0"))},
+    Config{"udp_local_port",
+      Configurable(declare_parameter<int64_t>("ethernet.local_port", 50000))},
+    Config{"udp_remote_ip",
+      Configurable(declare_parameter<std::string>("ethernet.remote_ip", "192.168.1.10"))},
+    Config{"udp_remote_port",
+      Configurable(declare_parameter<int64_t>("ethernet.remote_port", 50000))},
+    Config{"udp_socket_buffer_size",
+      Configurable(declare_parameter<int64_t>("ethernet.socket_buffer_size", 0))},
+    Config{"udp_dscp", Configurable(declare_parameter<int64_t>("ethernet.dscp", 46))},
+    Config{"can_interface", Configurable(declare_parameter<std::string>("can.interface", "can0"))},
+    Config{"can_fd", Configurable(declare_parameter<bool>("can.fd", false))},
+    Config{"can_tx_base_id", Configurable(declare_parameter<int64_t>("can.tx_base_id", 0x100))},
+    Config{"can_rx_base_id", Configurable(declare_parameter<int64_t>("can.rx_base_id", 0x180))},
+    Config{"sim_heartbeat_hz", Configurable(declare_parameter<int64_t>("sim.heartbeat_hz", 10))},
+    Config{"sim_sensor_hz", Configurable(declare_parameter<int64_t>("sim.sensor_hz", 100))},
+    Config{"sim_initialization_time_ms",
+      Configurable(declare_parameter<int64_t>("sim.initialization_time_ms", 500))},
+    Config{"impairment_enabled",
+      Configurable(declare_parameter<bool>("impairment.enabled", false))},
+    Config{"impairment_seed", Configurable(declare_parameter<int64_t>("impairment.seed", 0))},
+    Config{"impairment_delay_ms",
+      Configurable(declare_parameter<int64_t>("impairment.delay_ms", 0))},
+    Config{"impairment_jitter_ms",
+      Configurable(declare_parameter<int64_t>("impairment.jitter_ms", 0))},
+    Config{"impairment_bandwidth_bps",
+      Configurable(declare_parameter<int64_t>("impairment.bandwidth_bps", 0))},
+    Config{"impairment_loss_rate",
+      Configurable(declare_parameter<double>("impairment.loss_rate", 0.0))},
+    Config{"impairment_corruption_rate",
+      Configurable(declare_parameter<double>("impairment.corruption_rate", 0.0))},
+    Config{"framing", Configurable(declare_parameter<std::string>("framing", "legacy"))},
+    Config{"compact_packets", Configurable(declare_parameter<bool>("compact_packets", false))},
+    Config{"sensor_deltas", Configurable(declare_parameter<bool>("sensor_deltas", false))},
+    Config{"sensor_batches", Configurable(declare_parameter<bool>("sensor_batches", false))},
+    Config{"sensor_history_size",
+      Configurable(declare_parameter<int64_t>("sensor_history_size", 1000))},
+    Config{"extended_frames", Configurable(declare_parameter<bool>("extended_frames", false))},
+    Config{"log_min_level",
+      Configurable(declare_parameter<std::string>("log_min_level", "info"))},
+    Config{"log_rate_limit", Configurable(declare_parameter<int64_t>("log_rate_limit", 0))},
   };
   interface_ = std::make_unique<GkcInterface>(configs_);
+
+  // The log filter can change at runtime, e.g. to quiet the MCU during a race
+  param_callback_handle_ = add_on_set_parameters_callback(
+    std::bind(&GkcNode::param_callback, this, _1));
 }
 
 LifecycleNodeInterface::CallbackReturn GkcNode::on_configure(
@@ -186,9 +234,7 @@ LifecycleNodeInterface::CallbackReturn GkcNode::on_error(
 void GkcNode::cmd_callback(const GkcCommand::SharedPtr cmd_msg)
 {
   auto pkt = ControlGkcPacket();
-  pkt.throttle = cmd_msg->throttle;
-  pkt.steering = cmd_msg->steering;
-  pkt.brake = cmd_msg->brake;
+  from_msg(*cmd_msg, pkt);
   if (!interface_->send_control(pkt)) {
     RCLCPP_WARN_THROTTLE(get_logger(), *get_clock(), 500, "Failed to send control.");
   }
@@ -201,24 +247,7 @@ void GkcNode::state_pub_timer_callback()
 {
   if (interface_ && state_pub_) {
     GkcState state = GkcState();
-    const auto & vals = interface_->get_sensors().values;
-    state.amperage = vals.amperage;
-    state.brake_pressure = vals.brake_pressure;
-    state.fault_brake = vals.fault_brake;
-    state.fault_error = vals.fault_error;
-    state.fault_fatal = vals.fault_fatal;
-    state.fault_info = vals.fault_info;
-    state.fault_steering = vals.fault_steering;
-    state.fault_throttle = vals.fault_throttle;
-    state.fault_warning = vals.fault_warning;
-    state.servo_angle_rad = vals.servo_angle_rad;
-    state.steering_angle_rad = vals.steering_angle_rad;
-    state.throttle_pos = vals.throttle_pos;
-    state.voltage = vals.voltage;
-    state.wheel_speed_fl = vals.wheel_speed_fl;
-    state.wheel_speed_fr = vals.wheel_speed_fr;
-    state.wheel_speed_rl = vals.wheel_speed_rl;
-    state.wheel_speed_rr = vals.wheel_speed_rr;
+    to_msg(interface_->get_sensors(), state);
     state.state = static_cast<uint8_t>(interface_->get_state());
     state.stamp = get_clock()->now();
     state_pub_->publish(state);
@@ -227,6 +256,37 @@ void GkcNode::state_pub_timer_callback()
   dump_logs();
 }
 
+rcl_interfaces::msg::SetParametersResult GkcNode::param_callback(
+  const std::vector<rclcpp::Parameter> & parameters)
+{
+  auto result = rcl_interfaces::msg::SetParametersResult();
+  result.successful = true;
+  auto min_level = get_parameter("log_min_level").as_string();
+  auto max_logs_per_second = get_parameter("log_rate_limit").as_int();
+  bool log_filter_changed = false;
+  for (const auto & parameter : parameters) {
+    if (parameter.get_name() == "log_min_level") {
+      min_level = parameter.as_string();
+      log_filter_changed = true;
+    } else if (parameter.get_name() == "log_rate_limit") {
+      max_logs_per_second = parameter.as_int();
+      log_filter_changed = true;
+    }
+  }
+  if (!log_filter_changed || !interface_) {
+    return result;
+  }
+  try {
+    if (!interface_->set_log_filter(min_level, max_logs_per_second)) {
+      RCLCPP_WARN(get_logger(), "Log filter not sent. It applies once the MCU is connected.");
+    }
+  } catch (const std::invalid_argument & e) {
+    result.successful = false;
+    result.reason = e.what();
+  }
+  return result;
+}
+
 void GkcNode::dump_logs()
 {
   if (!interface_) {
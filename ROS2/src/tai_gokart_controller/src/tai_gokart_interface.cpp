@@ -9,6 +9,9 @@
  *
  */
 
+#include <array>
+#include <chrono>
+#include <stdexcept>
 #include <string>
 #include <memory>
 
@@ -28,6 +31,38 @@ GkcInterface::GkcInterface(const ConfigList & configs)
   if (!comm_) {
     throw std::runtime_error("Cannot find comm interface with name \"" + comm_name + ".\"");
   }
+  // Degrade the link on purpose, e.g. to test on a bad serial connection
+  if (configs.at("impairment_enabled").boolean) {
+    comm_ = std::make_shared<ImpairedInterface>(this, comm_);
+  }
+
+  // Framing to propose in the handshake. Legacy framing is always supported.
+  std::string framing = static_cast<std::string>(configs.at("framing"));
+  if (framing == "cobs") {
+    capabilities_ |= GkcCapabilities::COBS_FRAMING;
+  } else if (framing != "legacy") {
+    throw std::runtime_error("Unknown framing \"" + framing + ".\"");
+  }
+  if (configs.at("compact_packets").boolean) {
+    capabilities_ |= GkcCapabilities::COMPACT_PACKETS;
+  }
+  if (configs.at("sensor_deltas").boolean) {
+    capabilities_ |= GkcCapabilities::SENSOR_DELTAS;
+  }
+  if (configs.at("sensor_batches").boolean) {
+    capabilities_ |= GkcCapabilities::SENSOR_BATCHES;
+  }
+  sensor_history_size_ = static_cast<size_t>(configs.at("sensor_history_size").integer);
+  if (configs.at("extended_frames").boolean) {
+    capabilities_ |= GkcCapabilities::EXTENDED_FRAMES;
+  }
+  try {
+    set_log_filter(
+      static_cast<std::string>(configs.at("log_min_level")),
+      configs.at("log_rate_limit").integer);
+  } catch (const std::invalid_argument & e) {
+    throw std::runtime_error(e.what());
+  }
 
   // Initialize the communication
   if (comm_->configure(configs) && comm_->open() && send_handshake()) {
@@ -55,7 +90,10 @@ bool GkcInterface::send_control(const ControlGkcPacket & control_packet)
   if (!comm_ || !comm_->is_open()) {
     return false;
   }
-  return static_cast<bool>(comm_->send(*factory_->Send(control_packet)));
+  if (compact_packets_) {
+    return send_packet(CompactControlGkcPacket(control_packet), CommPriority::Control);
+  }
+  return send_packet(control_packet, CommPriority::Control);
 }
 
 bool GkcInterface::initialize(const ConfigGkcPacket & config_packet, const uint32_t & timeout_ms)
@@ -71,7 +109,7 @@ bool GkcInterface::initialize(const ConfigGkcPacket & config_packet, const uint3
   if (!comm_ || !comm_->is_open()) {
     return false;
   }
-  auto sent = static_cast<bool>(comm_->send(*factory_->Send(config_packet)));
+  auto sent = send_packet(config_packet);
   if (!sent) {
     return false;
   }
@@ -121,6 +159,19 @@ bool GkcInterface::emergency_stop(const uint32_t & timeout_ms)
   return try_change_state(GkcLifecycle::Emergency, timeout_ms);
 }
 
+bool GkcInterface::release_emergency_stop(const uint32_t & timeout_ms)
+{
+  if (current_state_ != GkcLifecycle::Emergency) {
+    auto log = LogPacket();
+    log.level = LogPacket::Severity::WARNING;
+    log.what = "GKC can only be released from emergency state. Current state is " +
+      std::to_string(current_state_) + ".";
+    logs_.emplace(log);
+    return false;
+  }
+  return try_change_state(GkcLifecycle::Uninitialized, timeout_ms);
+}
+
 bool GkcInterface::shutdown(const uint32_t & timeout_ms)
 {
   if (current_state_ != GkcLifecycle::Active && current_state_ != GkcLifecycle::Inactive) {
@@ -138,7 +189,15 @@ bool GkcInterface::shutdown(const uint32_t & timeout_ms)
 
 const SensorGkcPacket & GkcInterface::get_sensors() const
 {
-  return *sensors_;
+  return sensors_;
+}
+
+std::vector<TimedSensorValues> GkcInterface::take_sensor_history()
+{
+  std::lock_guard<std::mutex> lock(sensor_history_mutex_);
+  auto history = std::vector<TimedSensorValues>(sensor_history_.begin(), sensor_history_.end());
+  sensor_history_.clear();
+  return history;
 }
 
 GkcLifecycle GkcInterface::get_state() const
@@ -146,6 +205,14 @@ GkcLifecycle GkcInterface::get_state() const
   return current_state_;
 }
 
+CommTxQueue::Statistics GkcInterface::get_tx_statistics(const CommPriority & priority) const
+{
+  if (!comm_) {
+    return CommTxQueue::Statistics();
+  }
+  return comm_->get_tx_statistics(priority);
+}
+
 std::shared_ptr<LogPacket> GkcInterface::get_next_log()
 {
   if (!logs_.size()) {
@@ -156,6 +223,133 @@ std::shared_ptr<LogPacket> GkcInterface::get_next_log()
   return log;
 }
 
+bool GkcInterface::set_log_filter(
+  const std::string & min_level,
+  const int64_t & max_logs_per_second)
+{
+  static const std::unordered_map<std::string, LogFilterGkcPacket::Severity> levels = {
+    {"info", LogFilterGkcPacket::INFO},
+    {"warning", LogFilterGkcPacket::WARNING},
+    {"error", LogFilterGkcPacket::ERROR},
+    {"fatal", LogFilterGkcPacket::FATAL}
+  };
+  const auto level = levels.find(min_level);
+  if (level == levels.end()) {
+    throw std::invalid_argument("Unknown log level \"" + min_level + ".\"");
+  }
+  if (max_logs_per_second < 0 || max_logs_per_second > UINT16_MAX) {
+    throw std::invalid_argument(
+            "The log rate limit must be between 0 and " + std::to_string(UINT16_MAX) + ".");
+  }
+  auto log_filter = LogFilterGkcPacket();
+  log_filter.min_level = level->second;
+  log_filter.max_logs_per_second = static_cast<uint16_t>(max_logs_per_second);
+  {
+    std::lock_guard<std::mutex> lock(log_filter_mutex_);
+    log_filter_ = log_filter;
+  }
+  // Applied after the handshake if not connected yet
+  if (!comm_ || !comm_->is_open() || !handshake_number) {
+    return false;
+  }
+  return send_packet(log_filter);
+}
+
+bool GkcInterface::push_bulk(
+  const uint16_t & resource, const std::vector<uint8_t> & data,
+  const uint32_t & timeout_ms)
+{
+  if (!comm_ || !comm_->is_open()) {
+    return false;
+  }
+  // Chunks fill a frame
+  const size_t chunk_size = extended_frames_ ?
+    BulkChunkGkcPacket::MAX_DATA_SIZE : GkcBulkSender::MAX_STANDARD_CHUNK_SIZE;
+  const uint32_t start_ms = bulk_clock_ms();
+  {
+    std::lock_guard<std::mutex> lock(bulk_mutex_);
+    if (!bulk_sender_.start(resource, data, chunk_size, start_ms)) {
+      return false;
+    }
+  }
+  while (bulk_clock_ms() - start_ms < timeout_ms) {
+    {
+      std::lock_guard<std::mutex> lock(bulk_mutex_);
+      bulk_sender_.poll(bulk_clock_ms(), [this](const GkcPacket & packet) {
+          return send_packet(packet);
+        });
+      if (bulk_sender_.state() != GkcBulkSender::State::Sending) {
+        return bulk_sender_.state() == GkcBulkSender::State::Complete;
+      }
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  // `data` is not used after returning
+  std::lock_guard<std::mutex> lock(bulk_mutex_);
+  bulk_sender_.reset();
+  return false;
+}
+
+std::shared_ptr<std::vector<uint8_t>> GkcInterface::pull_bulk(
+  const uint16_t & resource, const size_t & max_size,
+  const uint32_t & timeout_ms)
+{
+  if (!comm_ || !comm_->is_open()) {
+    return nullptr;
+  }
+  {
+    std::lock_guard<std::mutex> lock(bulk_mutex_);
+    // Stop writing to the destination of an earlier pull
+    bulk_receiver_.reset();
+    bulk_data_ = std::make_shared<std::vector<uint8_t>>();
+    bulk_resource_ = resource;
+    bulk_max_size_ = max_size;
+    bulk_pulling_ = false;
+  }
+  auto request = BulkRequestGkcPacket();
+  request.resource = resource;
+  if (!send_packet(request)) {
+    return nullptr;
+  }
+
+  // Wait for the MCU to send it
+  const uint32_t start_ms = bulk_clock_ms();
+  while (bulk_clock_ms() - start_ms < timeout_ms) {
+    {
+      std::lock_guard<std::mutex> lock(bulk_mutex_);
+      if (!bulk_data_) {
+        // Rejected for its size
+        return nullptr;
+      } else if (bulk_pulling_ &&
+        bulk_receiver_.state() == GkcBulkReceiver::State::Complete)
+      {
+        bulk_pulling_ = false;
+        return std::move(bulk_data_);
+      } else if (bulk_pulling_ && bulk_receiver_.state() == GkcBulkReceiver::State::Failed) {
+        bulk_pulling_ = false;
+        return nullptr;
+      }
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  std::lock_guard<std::mutex> lock(bulk_mutex_);
+  bulk_receiver_.reset();
+  bulk_data_.reset();
+  bulk_pulling_ = false;
+  return nullptr;
+}
+
+bool GkcInterface::send_packet(const GkcPacket & packet, const CommPriority & priority)
+{
+  // Encode on the stack so that sending does not allocate
+  std::array<uint8_t, GkcFrameFormat::MAX_EXTENDED_FRAME_SIZE> frame;
+  const auto frame_size = factory_->Send(packet, frame);
+  if (!frame_size) {
+    return false;
+  }
+  return static_cast<bool>(comm_->send(GkcBufferView(frame.data(), frame_size), priority));
+}
+
 bool GkcInterface::try_change_state(const GkcLifecycle & target_state, const uint32_t & timeout_ms)
 {
   if (!comm_ || !comm_->is_open()) {
@@ -165,7 +359,7 @@ bool GkcInterface::try_change_state(const GkcLifecycle & target_state, const uin
   auto activate_packet = StateTransitionGkcPacket();
   activate_packet.requested_state = static_cast<uint8_t>(target_state);
 
-  auto sent = static_cast<bool>(comm_->send(*factory_->Send(activate_packet)));
+  auto sent = send_packet(activate_packet, CommPriority::Urgent);
   if (!sent) {
     return false;
   }
@@ -183,7 +377,7 @@ void GkcInterface::stream_heartbeats()
   auto hb = HeartbeatGkcPacket();
   hb.rolling_counter = 0;
   while (comm_ && comm_->is_open()) {
-    comm_->send(*factory_->Send(hb));
+    send_packet(hb, CommPriority::Heartbeat);
     ++hb.rolling_counter;
     std::this_thread::sleep_for(std::chrono::milliseconds(HEARTBEAT_INTERVAL_MS));
   }
@@ -194,10 +388,16 @@ bool GkcInterface::send_handshake()
   if (!comm_ || !comm_->is_open()) {
     return false;
   }
+  // The MCU expects a handshake in legacy framing
+  factory_->set_framing(GkcFraming::Legacy);
+  factory_->set_extended_frames(false);
+  compact_packets_ = false;
+  extended_frames_ = false;
   auto handshake_packet = Handshake1GkcPacket();
   handshake_packet.seq_number = static_cast<uint32_t>(std::rand());
+  handshake_packet.capabilities = capabilities_;
   handshake_number = std::make_unique<uint32_t>(handshake_packet.seq_number);
-  return static_cast<bool>(comm_->send(*factory_->Send(handshake_packet)));
+  return send_packet(handshake_packet, CommPriority::Urgent);
 }
 
 bool GkcInterface::send_shutdown()
@@ -208,7 +408,7 @@ bool GkcInterface::send_shutdown()
   auto shutdown_packet = Shutdown1GkcPacket();
   shutdown_packet.seq_number = static_cast<uint32_t>(std::rand());
   shutdown_number = std::make_unique<uint32_t>(shutdown_packet.seq_number);
-  return static_cast<bool>(comm_->send(*factory_->Send(shutdown_packet)));
+  return send_packet(shutdown_packet, CommPriority::Urgent);
 }
 
 bool GkcInterface::send_firmware_version_request()
@@ -217,10 +417,18 @@ bool GkcInterface::send_firmware_version_request()
     return false;
   }
   auto packet = GetFirmwareVersionGkcPacket();
-  return static_cast<bool>(comm_->send(*factory_->Send(packet)));
+  return send_packet(packet);
+}
+
+uint32_t GkcInterface::bulk_clock_ms()
+{
+  // Wraps around. The bulk transfer only uses differences.
+  return static_cast<uint32_t>(
+    std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count());
 }
 
-void GkcInterface::receive(const GkcBuffer & buffer)
+void GkcInterface::receive(const GkcBufferView & buffer)
 {
   factory_->Receive(buffer);
 }
@@ -242,8 +450,23 @@ void GkcInterface::packet_callback(const Handshake2GkcPacket & packet)
     return;
   }
 
-  // Handshake is good. Confirm firmware version.
+  // Handshake is good. Switch to the encoding the MCU agreed to, then confirm firmware version.
+  if (packet.capabilities & capabilities_ & GkcCapabilities::COBS_FRAMING) {
+    factory_->set_framing(GkcFraming::Cobs);
+  }
+  compact_packets_ = packet.capabilities & capabilities_ & GkcCapabilities::COMPACT_PACKETS;
+  extended_frames_ = packet.capabilities & capabilities_ & GkcCapabilities::EXTENDED_FRAMES;
+  factory_->set_extended_frames(extended_frames_);
   send_firmware_version_request();
+  auto log_filter = LogFilterGkcPacket();
+  {
+    std::lock_guard<std::mutex> lock(log_filter_mutex_);
+    log_filter = log_filter_;
+  }
+  // Only if set, for firmware that does not know the packet
+  if (log_filter.min_level != LogFilterGkcPacket::INFO || log_filter.max_logs_per_second) {
+    send_packet(log_filter);
+  }
 }
 
 void GkcInterface::packet_callback(const GetFirmwareVersionGkcPacket & packet)
@@ -283,6 +506,13 @@ void GkcInterface::packet_callback(const HeartbeatGkcPacket & packet)
   current_state_ = static_cast<GkcLifecycle>(packet.state);
 }
 
+bool GkcInterface::packet_view_callback(const HeartbeatView & view)
+{
+  // Only the state byte is needed
+  current_state_ = static_cast<GkcLifecycle>(view.state());
+  return true;
+}
+
 void GkcInterface::packet_callback(const ConfigGkcPacket & packet)
 {
   (void)packet;
@@ -293,6 +523,11 @@ void GkcInterface::packet_callback(const StateTransitionGkcPacket & packet)
   (void)packet;
 }
 
+void GkcInterface::packet_callback(const LogFilterGkcPacket & packet)
+{
+  (void)packet;
+}
+
 void GkcInterface::packet_callback(const ControlGkcPacket & packet)
 {
   (void)packet;
@@ -300,7 +535,7 @@ void GkcInterface::packet_callback(const ControlGkcPacket & packet)
 
 void GkcInterface::packet_callback(const SensorGkcPacket & packet)
 {
-  sensors_ = std::make_unique<SensorGkcPacket>(packet);
+  sensors_ = packet;
 }
 
 void GkcInterface::packet_callback(const Shutdown1GkcPacket & packet)
@@ -312,10 +547,10 @@ void GkcInterface::packet_callback(const Shutdown2GkcPacket & packet)
 {
   if (!shutdown_number) {
     throw std::runtime_error("Shutdown #2 received, but no shutdown #1 was initiated before.");
-  } else if (*handshake_number + 1 != packet.seq_number) {
+  } else if (*shutdown_number + 1 != packet.seq_number) {
     auto log = LogPacket();
     log.level = LogPacket::Severity::WARNING;
-    log.what = "Handshake #2 received, but sequence number does not match. Retrying.";
+    log.what = "Shutdown #2 received, but sequence number does not match. Retrying.";
     logs_.emplace(log);
     send_shutdown();
     return;
@@ -326,5 +561,104 @@ void GkcInterface::packet_callback(const LogPacket & packet)
 {
   logs_.emplace(packet);
 }
+
+void GkcInterface::packet_callback(const LogIdGkcPacket & packet)
+{
+  logs_.emplace(GkcLogTable::expand(packet));
+}
+
+void GkcInterface::packet_callback(const CompactSensorGkcPacket & packet)
+{
+  sensors_ = packet.expand();
+}
+
+void GkcInterface::packet_callback(const CompactControlGkcPacket & packet)
+{
+  (void)packet;
+}
+
+void GkcInterface::packet_callback(const SensorDeltaGkcPacket & packet)
+{
+  switch (sensor_deltas_.apply(packet)) {
+    case GkcSensorDeltaDecoder::Result::Updated:
+      sensors_.values = sensor_deltas_.values();
+      break;
+    case GkcSensorDeltaDecoder::Result::Resync:
+      {
+        // The keyframe was lost. Keep the last values until the MCU sends a new one.
+        auto resync = SensorResyncGkcPacket();
+        resync.keyframe_id = sensor_deltas_.keyframe_id();
+        send_packet(resync);
+        break;
+      }
+    case GkcSensorDeltaDecoder::Result::Pending:
+      break;
+  }
+}
+
+void GkcInterface::packet_callback(const SensorResyncGkcPacket & packet)
+{
+  (void)packet;
+}
+
+void GkcInterface::packet_callback(const SensorBatchGkcPacket & packet)
+{
+  if (!packet.num_samples) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(sensor_history_mutex_);
+    for (size_t i = 0; i < packet.num_samples; ++i) {
+      const auto & sample = packet.samples[i];
+      sensor_history_.push_back({packet.timestamp_us + sample.time_offset_us, sample.values});
+    }
+    while (sensor_history_.size() > sensor_history_size_) {
+      sensor_history_.pop_front();
+    }
+  }
+  sensors_.values = packet.samples[packet.num_samples - 1].values;
+}
+
+void GkcInterface::packet_callback(const BulkRequestGkcPacket & packet)
+{
+  // The PC has no resources for the MCU to pull
+  (void)packet;
+}
+
+void GkcInterface::packet_callback(const BulkStartGkcPacket & packet)
+{
+  std::lock_guard<std::mutex> lock(bulk_mutex_);
+  auto destination = GkcMutableBufferView();
+  if (bulk_receiver_.is_new(packet)) {
+    // Only receive what `pull_bulk` asked for. An empty destination rejects the rest.
+    bulk_pulling_ = bulk_data_ && packet.resource == bulk_resource_;
+    if (bulk_pulling_ && packet.total_size > bulk_max_size_) {
+      // The size comes from the MCU, so it is not allocated before it is checked
+      bulk_pulling_ = false;
+      bulk_data_.reset();
+    }
+    if (bulk_pulling_) {
+      bulk_data_->assign(packet.total_size, 0);
+    }
+  }
+  if (bulk_pulling_) {
+    destination = GkcMutableBufferView(bulk_data_->data(), bulk_data_->size());
+  }
+  bulk_receiver_.start(packet, destination, [this](const GkcPacket & ack) {
+      return send_packet(ack);
+    });
+}
+
+void GkcInterface::packet_callback(const BulkChunkGkcPacket & packet)
+{
+  std::lock_guard<std::mutex> lock(bulk_mutex_);
+  bulk_receiver_.receive(packet, [this](const GkcPacket & ack) {return send_packet(ack);});
+}
+
+void GkcInterface::packet_callback(const BulkAckGkcPacket & packet)
+{
+  std::lock_guard<std::mutex> lock(bulk_mutex_);
+  bulk_sender_.on_ack(packet, bulk_clock_ms());
+}
 }  // namespace gkc
 }  // namespace tritonai
@@ -8,3 +8,846 @@
  * @copyright Copyright 2022 Triton AI
  *
  */
+
+#include <gtest/gtest.h>
+#include <arpa/inet.h>
+#include <linux/can.h>
+#include <net/if.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "tai_gokart_controller/comm.hpp"
+#include "tai_gokart_controller/tai_gokart_interface.hpp"
+
+using tritonai::gkc::CommPriority;
+using tritonai::gkc::CommTxQueue;
+using tritonai::gkc::GkcLifecycle;
+
+namespace
+{
+/**
+ * @brief Records the writes instead of sending them. `on_write` runs during the first write,
+ * like another thread queueing frames meanwhile.
+ */
+class FakeComm : public tritonai::gkc::ICommInterface
+{
+public:
+  FakeComm()
+  : ICommInterface(nullptr) {}
+
+  bool configure(const tritonai::gkc::ConfigList & configs) {(void)configs; return true;}
+  bool open() {return true;}
+  bool is_open() {return true;}
+  bool close() {return true;}
+  tritonai::gkc::CommIO get_io_type() {return tritonai::gkc::CommIO::Serial;}
+
+  std::vector<std::vector<uint8_t>> writes {};
+  std::vector<CommPriority> priorities {};
+  std::atomic<size_t> num_writes {0};  // for writes from another thread
+  using ICommInterface::tx_single_priority_;
+  std::function<void()> on_write {};
+
+protected:
+  size_t write(const tritonai::gkc::GkcBufferView & buffer, const CommPriority & priority)
+  {
+    writes.emplace_back(buffer.begin(), buffer.end());
+    priorities.push_back(priority);
+    if (writes.size() == 1 && on_write) {
+      on_write();
+    }
+    ++num_writes;
+    return buffer.size();
+  }
+};
+
+std::vector<uint8_t> frame(const uint8_t & value, const size_t & size = 4)
+{
+  return std::vector<uint8_t>(size, value);
+}
+
+class RecordingHandler : public tritonai::gkc::ICommRecvHandler
+{
+public:
+  void receive(const tritonai::gkc::GkcBufferView & buffer)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    bytes.insert(bytes.end(), buffer.begin(), buffer.end());
+  }
+
+  // Wait for at least `size` bytes, for up to a second
+  std::vector<uint8_t> wait_for(const size_t & size)
+  {
+    for (int i = 0; i < 1000; ++i) {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (bytes.size() >= size) {
+          return bytes;
+        }
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    return bytes;
+  }
+
+  std::mutex mutex {};
+  std::vector<uint8_t> bytes {};
+};
+
+class TestEthernetInterface : public tritonai::gkc::EthernetInterface
+{
+public:
+  using EthernetInterface::EthernetInterface;
+  using EthernetInterface::write;
+};
+
+/**
+ * @brief A UDP socket on the loopback interface standing in for the MCU
+ */
+class LoopbackPeer
+{
+public:
+  LoopbackPeer()
+  {
+    socket_ = socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in address = loopback(0);
+    bind(socket_, reinterpret_cast<const sockaddr *>(&address), sizeof(address));
+    socklen_t length = sizeof(address);
+    getsockname(socket_, reinterpret_cast<sockaddr *>(&address), &length);
+    port_ = ntohs(address.sin_port);
+    timeval timeout {1, 0};
+    setsockopt(socket_, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+  }
+  ~LoopbackPeer() {close(socket_);}
+
+  static sockaddr_in loopback(const uint16_t & port)
+  {
+    sockaddr_in address {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    return address;
+  }
+
+  uint16_t port() const {return port_;}
+
+  void send_to(const uint16_t & port, const std::vector<uint8_t> & datagram)
+  {
+    const sockaddr_in address = loopback(port);
+    sendto(
+      socket_, datagram.data(), datagram.size(), 0,
+      reinterpret_cast<const sockaddr *>(&address), sizeof(address));
+  }
+
+  std::vector<uint8_t> receive()
+  {
+    std::vector<uint8_t> datagram(65536, 0);
+    const ssize_t size = recv(socket_, datagram.data(), datagram.size(), 0);
+    datagram.resize(size > 0 ? static_cast<size_t>(size) : 0);
+    return datagram;
+  }
+
+private:
+  int socket_ = -1;
+  uint16_t port_ = 0;
+};
+
+tritonai::gkc::ConfigList ethernet_configs(
+  const uint16_t & remote_port, const int64_t & dscp = 46,
+  const std::string & remote_ip = "127.0.0.1")
+{
+  using tritonai::gkc::Configurable;
+  return tritonai::gkc::ConfigList{
+    {"udp_local_ip", Configurable(std::string("127.0.0.1"))},
+    {"udp_local_port", Configurable(static_cast<int64_t>(0))},
+    {"udp_remote_ip", Configurable(remote_ip)},
+    {"udp_remote_port", Configurable(static_cast<int64_t>(remote_port))},
+    {"udp_socket_buffer_size", Configurable(static_cast<int64_t>(1 << 20))},
+    {"udp_dscp", Configurable(dscp)},
+  };
+}
+
+tritonai::gkc::ConfigList can_configs(
+  const int64_t & tx_base_id, const int64_t & rx_base_id,
+  const std::string & interface = "vcan0")
+{
+  using tritonai::gkc::Configurable;
+  return tritonai::gkc::ConfigList{
+    {"can_interface", Configurable(interface)},
+    {"can_fd", Configurable(false)},
+    {"can_tx_base_id", Configurable(tx_base_id)},
+    {"can_rx_base_id", Configurable(rx_base_id)},
+  };
+}
+
+tritonai::gkc::ConfigList sim_configs(const std::string & framing, const bool & compact)
+{
+  using tritonai::gkc::Configurable;
+  return tritonai::gkc::ConfigList{
+    {"comm_type", Configurable(std::string("sim"))},
+    {"sim_heartbeat_hz", Configurable(static_cast<int64_t>(20))},
+    {"sim_sensor_hz", Configurable(static_cast<int64_t>(100))},
+    {"sim_initialization_time_ms", Configurable(static_cast<int64_t>(200))},
+    {"impairment_enabled", Configurable(false)},
+    {"impairment_seed", Configurable(static_cast<int64_t>(7))},
+    {"impairment_delay_ms", Configurable(static_cast<int64_t>(0))},
+    {"impairment_jitter_ms", Configurable(static_cast<int64_t>(0))},
+    {"impairment_bandwidth_bps", Configurable(static_cast<int64_t>(0))},
+    {"impairment_loss_rate", Configurable(0.0)},
+    {"impairment_corruption_rate", Configurable(0.0)},
+    {"framing", Configurable(framing)},
+    {"compact_packets", Configurable(compact)},
+    {"sensor_deltas", Configurable(false)},
+    {"sensor_batches", Configurable(false)},
+    {"sensor_history_size", Configurable(static_cast<int64_t>(100))},
+    {"extended_frames", Configurable(true)},
+    {"log_min_level", Configurable(std::string("info"))},
+    {"log_rate_limit", Configurable(static_cast<int64_t>(0))},
+  };
+}
+
+tritonai::gkc::ConfigGkcPacket sim_config_packet()
+{
+  auto packet = tritonai::gkc::ConfigGkcPacket();
+  packet.values = tritonai::gkc::ConfigGkcPacket::Configurables();
+  packet.values.max_steering_left = 0.5f;
+  packet.values.max_steering_right = -0.5f;
+  packet.values.max_throttle = 1.0f;
+  packet.values.max_brake = 2000.0f;
+  return packet;
+}
+
+// Wait until `condition` holds, for up to a second
+template<typename ConditionT>
+bool wait_until(const ConditionT & condition)
+{
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+  while (!condition() && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return condition();
+}
+
+// The PC requests the firmware version once the handshake is complete
+bool wait_for_handshake(tritonai::gkc::GkcInterface & gkc)
+{
+  return wait_until([&gkc]() {
+             return gkc.get_tx_statistics(CommPriority::Background).frames_written > 0;
+           });
+}
+
+// Split a message into CAN payloads
+std::vector<std::vector<uint8_t>> split(
+  const std::vector<uint8_t> & message,
+  const size_t & max_payload_size)
+{
+  auto payloads = std::vector<std::vector<uint8_t>>();
+  EXPECT_TRUE(
+    tritonai::gkc::CanFragmenter::split(
+      message, max_payload_size, [&payloads](const tritonai::gkc::GkcBufferView & payload) {
+        payloads.emplace_back(payload.begin(), payload.end());
+        return true;
+      }));
+  return payloads;
+}
+}  // namespace
+
+TEST(TestCommTxQueue, PriorityOrder) {
+  auto queue = CommTxQueue();
+  ASSERT_TRUE(queue.push(frame(4), CommPriority::Background));
+  ASSERT_TRUE(queue.push(frame(3), CommPriority::Heartbeat));
+  ASSERT_TRUE(queue.push(frame(2), CommPriority::Control));
+  ASSERT_TRUE(queue.push(frame(1), CommPriority::Urgent));
+  EXPECT_EQ(queue.size(), 4u);
+  auto write = std::vector<uint8_t>();
+  auto priority = CommPriority::Background;
+  EXPECT_EQ(queue.pop(write, priority), 4u);
+  auto expected = std::vector<uint8_t>();
+  for (uint8_t i = 1; i <= 4; ++i) {
+    const auto bytes = frame(i);
+    expected.insert(expected.end(), bytes.begin(), bytes.end());
+  }
+  EXPECT_EQ(write, expected);
+  EXPECT_EQ(priority, CommPriority::Urgent);
+  EXPECT_EQ(queue.size(), 0u);
+  EXPECT_EQ(queue.num_writes(), 1u);
+  EXPECT_EQ(queue.pop(write, priority), 0u);
+  EXPECT_TRUE(write.empty());
+  EXPECT_EQ(queue.num_writes(), 1u);
+  SUCCEED();
+}
+
+TEST(TestCommTxQueue, SinglePriority) {
+  auto queue = CommTxQueue();
+  ASSERT_TRUE(queue.push(frame(3), CommPriority::Heartbeat));
+  ASSERT_TRUE(queue.push(frame(1), CommPriority::Urgent));
+  ASSERT_TRUE(queue.push(frame(2), CommPriority::Urgent));
+  auto write = std::vector<uint8_t>();
+  auto priority = CommPriority::Background;
+  EXPECT_EQ(queue.pop(write, priority, true), 2u);
+  EXPECT_EQ(priority, CommPriority::Urgent);
+  EXPECT_EQ(write.size(), 8u);
+  EXPECT_EQ(queue.pop(write, priority, true), 1u);
+  EXPECT_EQ(priority, CommPriority::Heartbeat);
+  EXPECT_EQ(write, frame(3));
+  EXPECT_EQ(queue.num_writes(), 2u);
+  SUCCEED();
+}
+
+TEST(TestCommTxQueue, ControlReplaced) {
+  auto queue = CommTxQueue();
+  ASSERT_TRUE(queue.push(frame(1), CommPriority::Control));
+  ASSERT_TRUE(queue.push(frame(2, 6), CommPriority::Control));
+  EXPECT_EQ(queue.size(), 1u);
+  auto write = std::vector<uint8_t>();
+  auto priority = CommPriority::Background;
+  EXPECT_EQ(queue.pop(write, priority), 1u);
+  EXPECT_EQ(write, frame(2, 6));
+  const auto & stats = queue.get_statistics(CommPriority::Control);
+  EXPECT_EQ(stats.frames_written, 1u);
+  EXPECT_EQ(stats.frames_replaced, 1u);
+  SUCCEED();
+}
+
+TEST(TestCommTxQueue, Full) {
+  auto queue = CommTxQueue();
+  for (size_t i = 0; i < CommTxQueue::DEPTH; ++i) {
+    ASSERT_TRUE(queue.push(frame(static_cast<uint8_t>(i)), CommPriority::Background));
+  }
+  EXPECT_FALSE(queue.push(frame(0xFF), CommPriority::Background));
+  // Other priorities have their own room
+  EXPECT_TRUE(queue.push(frame(0xEE), CommPriority::Urgent));
+  EXPECT_FALSE(
+    queue.push(
+      frame(0xDD, tritonai::gkc::GkcFrameFormat::MAX_EXTENDED_FRAME_SIZE + 1),
+      CommPriority::Heartbeat));
+  const auto & stats = queue.get_statistics(CommPriority::Background);
+  EXPECT_EQ(stats.frames_dropped, 1u);
+  EXPECT_EQ(stats.depth, CommTxQueue::DEPTH);
+  EXPECT_EQ(stats.max_depth, CommTxQueue::DEPTH);
+  EXPECT_EQ(queue.get_statistics(CommPriority::Heartbeat).frames_dropped, 1u);
+  SUCCEED();
+}
+
+TEST(TestCommTxQueue, WriteSize) {
+  static constexpr size_t FRAME_SIZE = tritonai::gkc::GkcFrameFormat::MAX_EXTENDED_FRAME_SIZE;
+  static constexpr size_t FRAMES_PER_WRITE = CommTxQueue::MAX_WRITE_SIZE / FRAME_SIZE;
+  auto queue = CommTxQueue();
+  for (size_t i = 0; i <= FRAMES_PER_WRITE; ++i) {
+    ASSERT_TRUE(queue.push(frame(static_cast<uint8_t>(i), FRAME_SIZE), CommPriority::Background));
+  }
+  auto write = std::vector<uint8_t>();
+  auto priority = CommPriority::Background;
+  EXPECT_EQ(queue.pop(write, priority), FRAMES_PER_WRITE);
+  EXPECT_EQ(write.size(), FRAMES_PER_WRITE * FRAME_SIZE);
+  EXPECT_EQ(queue.pop(write, priority), 1u);
+  EXPECT_EQ(write, frame(static_cast<uint8_t>(FRAMES_PER_WRITE), FRAME_SIZE));
+  EXPECT_EQ(queue.num_writes(), 2u);
+  SUCCEED();
+}
+
+TEST(TestCommTxQueue, QueuedTime) {
+  auto queue = CommTxQueue();
+  const auto start = CommTxQueue::Clock::now();
+  ASSERT_TRUE(queue.push(frame(1), CommPriority::Heartbeat, start));
+  ASSERT_TRUE(queue.push(frame(2), CommPriority::Heartbeat, start + std::chrono::milliseconds(1)));
+  auto write = std::vector<uint8_t>();
+  auto priority = CommPriority::Background;
+  EXPECT_EQ(queue.pop(write, priority, false, start + std::chrono::milliseconds(3)), 2u);
+  const auto & stats = queue.get_statistics(CommPriority::Heartbeat);
+  EXPECT_EQ(stats.max_queued_time, std::chrono::milliseconds(3));
+  EXPECT_EQ(stats.total_queued_time, std::chrono::milliseconds(5));
+  EXPECT_EQ(stats.depth, 0u);
+  EXPECT_EQ(stats.max_depth, 2u);
+  SUCCEED();
+}
+
+TEST(TestCommInterface, CoalesceWhileWriting) {
+  auto comm = FakeComm();
+  // Frames sent while the first write is in progress go out together, in priority order
+  comm.on_write = [&comm]() {
+      EXPECT_EQ(comm.send(frame(4), CommPriority::Background), 4u);
+      EXPECT_EQ(comm.send(frame(3), CommPriority::Control), 4u);
+      EXPECT_EQ(comm.send(frame(2), CommPriority::Control), 4u);
+      EXPECT_EQ(comm.send(frame(1), CommPriority::Urgent), 4u);
+    };
+  EXPECT_EQ(comm.send(frame(0), CommPriority::Heartbeat), 4u);
+  ASSERT_EQ(comm.writes.size(), 2u);
+  EXPECT_EQ(comm.writes[0], frame(0));
+  auto expected = std::vector<uint8_t>();
+  for (const uint8_t i : {1, 2, 4}) {
+    const auto bytes = frame(i);
+    expected.insert(expected.end(), bytes.begin(), bytes.end());
+  }
+  EXPECT_EQ(comm.writes[1], expected);
+  EXPECT_EQ(comm.priorities[0], CommPriority::Heartbeat);
+  EXPECT_EQ(comm.priorities[1], CommPriority::Urgent);
+  EXPECT_EQ(comm.get_tx_statistics(CommPriority::Control).frames_replaced, 1u);
+  EXPECT_EQ(comm.get_tx_statistics(CommPriority::Urgent).frames_written, 1u);
+  SUCCEED();
+}
+
+TEST(TestCommInterface, UrgentDuringBulk) {
+  static constexpr size_t FRAME_SIZE = tritonai::gkc::GkcFrameFormat::MAX_EXTENDED_FRAME_SIZE;
+  auto comm = FakeComm();
+  // An urgent frame sent while a bulk transfer is being written waits for one frame at most
+  comm.on_write = [&comm]() {
+      for (uint8_t i = 1; i < 4; ++i) {
+        EXPECT_EQ(comm.send(frame(i, FRAME_SIZE), CommPriority::Background), FRAME_SIZE);
+      }
+      EXPECT_EQ(comm.send(frame(0xEE), CommPriority::Urgent), 4u);
+    };
+  EXPECT_EQ(comm.send(frame(0, FRAME_SIZE), CommPriority::Background), FRAME_SIZE);
+  ASSERT_EQ(comm.writes.size(), 5u);
+  EXPECT_EQ(comm.writes[0], frame(0, FRAME_SIZE));
+  EXPECT_EQ(comm.writes[1], frame(0xEE));
+  EXPECT_EQ(comm.priorities[1], CommPriority::Urgent);
+  for (uint8_t i = 1; i < 4; ++i) {
+    EXPECT_EQ(comm.writes[i + 1], frame(i, FRAME_SIZE));
+  }
+  SUCCEED();
+}
+
+TEST(TestEthernetInterface, Configure) {
+  auto handler = RecordingHandler();
+  auto comm = TestEthernetInterface(&handler);
+  EXPECT_TRUE(comm.configure(ethernet_configs(50000)));
+  EXPECT_FALSE(comm.configure(ethernet_configs(50000, 64)));
+  EXPECT_FALSE(comm.configure(ethernet_configs(50000, 46, "192.168.1")));
+  EXPECT_FALSE(comm.is_open());
+  EXPECT_EQ(comm.get_io_type(), tritonai::gkc::CommIO::Ethernet);
+  SUCCEED();
+}
+
+TEST(TestEthernetInterface, Loopback) {
+  auto peer = LoopbackPeer();
+  auto stranger = LoopbackPeer();
+  auto handler = RecordingHandler();
+  auto comm = TestEthernetInterface(&handler);
+  ASSERT_TRUE(comm.configure(ethernet_configs(peer.port())));
+  ASSERT_TRUE(comm.open());
+  ASSERT_TRUE(comm.is_open());
+  ASSERT_NE(comm.get_local_port(), 0);
+
+  // Only datagrams of the MCU are received
+  stranger.send_to(comm.get_local_port(), frame(0xEE, 8));
+  auto expected = std::vector<uint8_t>();
+  for (uint8_t i = 1; i <= 3; ++i) {
+    const auto datagram = frame(i, 24);
+    peer.send_to(comm.get_local_port(), datagram);
+    expected.insert(expected.end(), datagram.begin(), datagram.end());
+  }
+  EXPECT_EQ(handler.wait_for(expected.size()), expected);
+
+  // A frame is one datagram
+  EXPECT_EQ(comm.send(frame(4, 24), CommPriority::Control), 24u);
+  EXPECT_EQ(peer.receive(), frame(4, 24));
+
+  // Longer writes are split into datagrams that are not fragmented
+  static constexpr size_t MAX_DATAGRAM_SIZE = tritonai::gkc::EthernetInterface::MAX_DATAGRAM_SIZE;
+  auto write = std::vector<uint8_t>(2 * MAX_DATAGRAM_SIZE + 56);
+  for (size_t i = 0; i < write.size(); ++i) {
+    write[i] = static_cast<uint8_t>(i);
+  }
+  EXPECT_EQ(comm.write(write, CommPriority::Background), write.size());
+  auto received = std::vector<uint8_t>();
+  for (const size_t size : {MAX_DATAGRAM_SIZE, MAX_DATAGRAM_SIZE, size_t{56}}) {
+    const auto datagram = peer.receive();
+    EXPECT_EQ(datagram.size(), size);
+    received.insert(received.end(), datagram.begin(), datagram.end());
+  }
+  EXPECT_EQ(received, write);
+
+  EXPECT_TRUE(comm.close());
+  EXPECT_FALSE(comm.is_open());
+  EXPECT_EQ(comm.send(frame(5)), 4u);  // queued, but nothing to write to
+  SUCCEED();
+}
+
+TEST(TestEthernetInterface, ClosedRemotePortIdles) {
+  // Sending to a port nobody listens on makes the kernel report ICMP port unreachable as a
+  // pending error on the connected socket
+  uint16_t closed_port = 0;
+  {
+    auto peer = LoopbackPeer();
+    closed_port = peer.port();
+  }
+  auto handler = RecordingHandler();
+  auto comm = TestEthernetInterface(&handler);
+  ASSERT_TRUE(comm.configure(ethernet_configs(closed_port)));
+  ASSERT_TRUE(comm.open());
+  EXPECT_EQ(comm.send(frame(1, 24), CommPriority::Control), 24u);
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+  // The receive thread must not spin on the error
+  const auto cpu_time = []() {
+      timespec time {};
+      clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time);
+      return std::chrono::seconds(time.tv_sec) + std::chrono::nanoseconds(time.tv_nsec);
+    };
+  const auto start = cpu_time();
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+  const auto busy = std::chrono::duration_cast<std::chrono::milliseconds>(cpu_time() - start);
+  EXPECT_LT(busy.count(), 100);
+
+  EXPECT_TRUE(comm.close());
+  SUCCEED();
+}
+
+TEST(TestCanFragmenter, RoundTrip) {
+  auto message = std::vector<uint8_t>(100);
+  for (size_t i = 0; i < message.size(); ++i) {
+    message[i] = static_cast<uint8_t>(i);
+  }
+  // 5 bytes after the first header, then 7 per classic CAN frame
+  for (const auto & max_payload_size : {size_t{8}, size_t{64}}) {
+    const auto payloads = split(message, max_payload_size);
+    const size_t first = max_payload_size - tritonai::gkc::CanFragmenter::FIRST_HEADER_SIZE;
+    const size_t rest = max_payload_size - tritonai::gkc::CanFragmenter::HEADER_SIZE;
+    EXPECT_EQ(payloads.size(), 1 + (message.size() - first + rest - 1) / rest);
+    auto reassembler = tritonai::gkc::CanReassembler();
+    for (size_t i = 0; i < payloads.size(); ++i) {
+      EXPECT_LE(payloads[i].size(), max_payload_size);
+      EXPECT_EQ(reassembler.push(payloads[i]), i + 1 == payloads.size());
+    }
+    const auto received = reassembler.message();
+    EXPECT_EQ(std::vector<uint8_t>(received.begin(), received.end()), message);
+    EXPECT_EQ(reassembler.num_dropped(), 0u);
+  }
+  // A message that fits in the first CAN frame
+  auto reassembler = tritonai::gkc::CanReassembler();
+  const auto payloads = split(frame(7, 5), 8);
+  ASSERT_EQ(payloads.size(), 1u);
+  EXPECT_TRUE(reassembler.push(payloads[0]));
+  EXPECT_EQ(reassembler.message().size(), 5u);
+  SUCCEED();
+}
+
+TEST(TestCanFragmenter, Padding) {
+  // CAN-FD frames are padded to a valid length, e.g. 12 for 10 bytes
+  auto payload = split(frame(7, 7), 64)[0];
+  payload.resize(12, 0);
+  auto reassembler = tritonai::gkc::CanReassembler();
+  EXPECT_TRUE(reassembler.push(payload));
+  const auto received = reassembler.message();
+  EXPECT_EQ(std::vector<uint8_t>(received.begin(), received.end()), frame(7, 7));
+  SUCCEED();
+}
+
+TEST(TestCanFragmenter, MissingFrame) {
+  auto reassembler = tritonai::gkc::CanReassembler();
+  const auto message = frame(1, 40);
+  auto payloads = split(message, 8);
+  // A frame in the middle is lost
+  payloads.erase(payloads.begin() + 2);
+  for (const auto & payload : payloads) {
+    EXPECT_FALSE(reassembler.push(payload));
+  }
+  EXPECT_EQ(reassembler.num_dropped(), 1u);
+  // The start of a message is lost
+  payloads = split(message, 8);
+  for (size_t i = 1; i < payloads.size(); ++i) {
+    EXPECT_FALSE(reassembler.push(payloads[i]));
+  }
+  // The end of a message is lost
+  EXPECT_FALSE(reassembler.push(payloads[0]));
+  payloads = split(frame(2, 20), 8);
+  for (size_t i = 0; i < payloads.size(); ++i) {
+    EXPECT_EQ(reassembler.push(payloads[i]), i + 1 == payloads.size());
+  }
+  EXPECT_EQ(reassembler.message().size(), 20u);
+  EXPECT_EQ(reassembler.num_dropped(), 2u);
+  SUCCEED();
+}
+
+TEST(TestCanInterface, Configure) {
+  auto handler = RecordingHandler();
+  auto comm = tritonai::gkc::CanInterface(&handler);
+  EXPECT_TRUE(comm.configure(can_configs(0x100, 0x180)));
+  EXPECT_FALSE(comm.configure(can_configs(0x101, 0x180)));  // not aligned
+  EXPECT_FALSE(comm.configure(can_configs(0x100, 0x100)));
+  EXPECT_FALSE(comm.configure(can_configs(0x100, 0x800)));  // not an 11-bit ID
+  EXPECT_EQ(comm.get_io_type(), tritonai::gkc::CommIO::CAN);
+  SUCCEED();
+}
+
+// Needs a virtual CAN interface:
+// sudo ip link add dev vcan0 type vcan && sudo ip link set up vcan0
+TEST(TestCanInterface, Vcan) {
+  if (!if_nametoindex("vcan0")) {
+    GTEST_SKIP() << "vcan0 is not available";
+  }
+  // The PC and the MCU side, each receiving the other's IDs
+  auto pc_handler = RecordingHandler();
+  auto mcu_handler = RecordingHandler();
+  auto pc = tritonai::gkc::CanInterface(&pc_handler);
+  auto mcu = tritonai::gkc::CanInterface(&mcu_handler);
+  ASSERT_TRUE(pc.configure(can_configs(0x100, 0x180)));
+  ASSERT_TRUE(mcu.configure(can_configs(0x180, 0x100)));
+  ASSERT_TRUE(pc.open());
+  ASSERT_TRUE(mcu.open());
+
+  // Frames of other IDs are filtered out
+  const int raw = socket(PF_CAN, SOCK_RAW, CAN_RAW);
+  sockaddr_can address {};
+  address.can_family = AF_CAN;
+  address.can_ifindex = static_cast<int>(if_nametoindex("vcan0"));
+  ASSERT_EQ(bind(raw, reinterpret_cast<const sockaddr *>(&address), sizeof(address)), 0);
+  can_frame stray {};
+  stray.can_id = 0x184;
+  stray.can_dlc = 8;
+  std::fill(std::begin(stray.data), std::end(stray.data), 0x80);
+  EXPECT_EQ(::write(raw, &stray, sizeof(stray)), static_cast<ssize_t>(sizeof(stray)));
+  close(raw);
+
+  const auto control = frame(1, 24);
+  EXPECT_EQ(pc.send(control, CommPriority::Control), control.size());
+  EXPECT_EQ(mcu_handler.wait_for(control.size()), control);
+  auto telemetry = std::vector<uint8_t>(300);
+  for (size_t i = 0; i < telemetry.size(); ++i) {
+    telemetry[i] = static_cast<uint8_t>(i);
+  }
+  EXPECT_EQ(mcu.send(telemetry), telemetry.size());
+  EXPECT_EQ(pc_handler.wait_for(telemetry.size()), telemetry);
+  SUCCEED();
+}
+
+TEST(TestSimInterface, Configure) {
+  auto handler = RecordingHandler();
+  auto comm = tritonai::gkc::SimInterface(&handler);
+  auto configs = sim_configs("legacy", false);
+  EXPECT_TRUE(comm.configure(configs));
+  configs.at("sim_heartbeat_hz") = tritonai::gkc::Configurable(static_cast<int64_t>(0));
+  EXPECT_FALSE(comm.configure(configs));
+  EXPECT_EQ(comm.get_io_type(), tritonai::gkc::CommIO::Sim);
+  SUCCEED();
+}
+
+TEST(TestSimInterface, Lifecycle) {
+  auto gkc = tritonai::gkc::GkcInterface(sim_configs("legacy", false));
+  ASSERT_TRUE(wait_for_handshake(gkc));
+  EXPECT_EQ(gkc.get_state(), GkcLifecycle::Uninitialized);
+  EXPECT_TRUE(gkc.initialize(sim_config_packet(), 50));
+  EXPECT_TRUE(wait_until([&gkc]() {return gkc.get_state() == GkcLifecycle::Inactive;}));
+  EXPECT_FLOAT_EQ(gkc.get_sensors().values.brake_pressure, 2000.0f);  // parking brake
+  EXPECT_TRUE(gkc.activate(50));
+
+  // The wheels follow the throttle
+  auto control = tritonai::gkc::ControlGkcPacket();
+  control.throttle = 0.5f;
+  control.steering = 1.0f;  // beyond the left limit
+  EXPECT_TRUE(gkc.send_control(control));
+  EXPECT_TRUE(wait_until([&gkc]() {return gkc.get_sensors().values.wheel_speed_fl > 10.0f;}));
+  EXPECT_FLOAT_EQ(gkc.get_sensors().values.steering_angle_rad, 0.5f);
+
+  // Pausing while moving stops the vehicle instead
+  EXPECT_FALSE(gkc.deactivate(50));
+  EXPECT_EQ(gkc.get_state(), GkcLifecycle::Emergency);
+  EXPECT_TRUE(gkc.release_emergency_stop(50));
+  EXPECT_EQ(gkc.get_state(), GkcLifecycle::Uninitialized);
+  SUCCEED();
+}
+
+TEST(TestSimInterface, CompactCobsShutdown) {
+  auto gkc = tritonai::gkc::GkcInterface(sim_configs("cobs", true));
+  ASSERT_TRUE(wait_for_handshake(gkc));
+  EXPECT_TRUE(gkc.initialize(sim_config_packet(), 50));
+  EXPECT_TRUE(wait_until([&gkc]() {return gkc.get_state() == GkcLifecycle::Inactive;}));
+  EXPECT_NEAR(
+    gkc.get_sensors().values.voltage, tritonai::gkc::SimMcu::BATTERY_VOLTAGE,
+    tritonai::gkc::CompactSensorGkcPacket::VOLTAGE_RESOLUTION);
+
+  // Shutdowns end in emergency stop
+  EXPECT_TRUE(gkc.shutdown(50));
+  EXPECT_TRUE(wait_until([&gkc]() {return gkc.get_state() == GkcLifecycle::Emergency;}));
+  while (const auto log = gkc.get_next_log()) {
+    ADD_FAILURE() << log->what;
+  }
+  SUCCEED();
+}
+
+TEST(TestSimInterface, PullBulkMaxSize) {
+  auto gkc = tritonai::gkc::GkcInterface(sim_configs("legacy", false));
+  ASSERT_TRUE(wait_for_handshake(gkc));
+  auto pulled = std::async(std::launch::async, [&gkc]() {return gkc.pull_bulk(7, 1024, 5000);});
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  // An offer beyond the limit fails the pull right away, without allocating it
+  auto start = tritonai::gkc::BulkStartGkcPacket();
+  start.transfer_id = 1;
+  start.resource = 7;
+  start.total_size = 64 << 20;
+  start.chunk_size = 1000;
+  start.window = 4;
+  gkc.packet_callback(start);
+  ASSERT_EQ(pulled.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+  EXPECT_EQ(pulled.get(), nullptr);
+  SUCCEED();
+}
+
+TEST(TestSimMcu, LogRateLimit) {
+  using tritonai::gkc::SimMcu;
+  auto num_logs = 0;
+  const auto count_logs = [&num_logs](const tritonai::gkc::GkcBufferView & frame) {
+      const auto first_byte = frame[tritonai::gkc::GkcFrameFormat::NUM_BYTES_BEFORE_PAYLOAD];
+      num_logs += first_byte == tritonai::gkc::LogPacket::FIRST_BYTE;
+    };
+  auto now = SimMcu::Clock::time_point();
+  auto mcu = SimMcu(
+    count_logs, std::chrono::seconds(10), SimMcu::Clock::duration::zero(),
+    std::chrono::seconds(1), now);
+  auto log_filter = tritonai::gkc::LogFilterGkcPacket();
+  log_filter.min_level = tritonai::gkc::LogFilterGkcPacket::WARNING;
+  log_filter.max_logs_per_second = 3;
+  mcu.receive(*log_filter.encode()->encode(), now);
+
+  // Every rejected transition is a warning
+  auto transition = tritonai::gkc::StateTransitionGkcPacket();
+  transition.requested_state = GkcLifecycle::Active;
+  const auto request = transition.encode()->encode();
+  for (int i = 0; i < 10; ++i) {
+    mcu.receive(*request, now + std::chrono::milliseconds(10 * i));
+  }
+  EXPECT_EQ(num_logs, 3);
+
+  // The limit is per second
+  now += std::chrono::milliseconds(1500);
+  for (int i = 0; i < 10; ++i) {
+    mcu.receive(*request, now);
+  }
+  EXPECT_EQ(num_logs, 6);
+  SUCCEED();
+}
+
+TEST(TestCommImpairment, Reproducible) {
+  using tritonai::gkc::CommImpairment;
+  auto parameters = CommImpairment::Parameters();
+  parameters.loss_rate = 0.01;
+  parameters.corruption_rate = 0.01;
+  auto bytes = std::vector<uint8_t>(100000);
+  for (size_t i = 0; i < bytes.size(); ++i) {
+    bytes[i] = static_cast<uint8_t>(i);
+  }
+
+  // The same bytes are impaired in one write as in many
+  auto impairment = CommImpairment(parameters, 1);
+  auto impaired = bytes;
+  impairment.apply(impaired);
+  auto chunked_impairment = CommImpairment(parameters, 1);
+  auto chunked = std::vector<uint8_t>();
+  for (size_t i = 0; i < bytes.size(); i += 1000) {
+    auto chunk = std::vector<uint8_t>(bytes.begin() + i, bytes.begin() + i + 1000);
+    chunked_impairment.apply(chunk);
+    chunked.insert(chunked.end(), chunk.begin(), chunk.end());
+  }
+  EXPECT_EQ(impaired, chunked);
+
+  const auto & stats = impairment.get_statistics();
+  EXPECT_EQ(stats.bytes_sent, bytes.size());
+  EXPECT_EQ(impaired.size(), bytes.size() - stats.bytes_lost);
+  EXPECT_NEAR(static_cast<double>(stats.bytes_lost), 1000.0, 200.0);
+  EXPECT_NEAR(static_cast<double>(stats.bytes_corrupted), 990.0, 200.0);
+
+  auto other_impairment = CommImpairment(parameters, 2);
+  auto other = bytes;
+  other_impairment.apply(other);
+  EXPECT_NE(impaired, other);
+  SUCCEED();
+}
+
+TEST(TestCommImpairment, Timing) {
+  using tritonai::gkc::CommImpairment;
+  using std::chrono::milliseconds;
+  auto parameters = CommImpairment::Parameters();
+  parameters.delay = milliseconds(10);
+  parameters.bandwidth_bps = 8000;  // a byte per millisecond
+  auto impairment = CommImpairment(parameters, 1);
+  const auto now = CommImpairment::Clock::time_point();
+  auto bytes = std::vector<uint8_t>(100);
+  const auto since = [&now](const CommImpairment::Clock::time_point & arrival) {
+      return std::chrono::duration_cast<milliseconds>(arrival - now).count();
+    };
+  EXPECT_EQ(since(impairment.apply(bytes, now)), 110);
+  // Waits for the write before it
+  bytes.resize(10);
+  EXPECT_EQ(since(impairment.apply(bytes, now)), 120);
+  EXPECT_EQ(since(impairment.apply(bytes, now + milliseconds(200))), 220);
+
+  // Writes stay in order however the jitter falls
+  parameters.bandwidth_bps = 0;
+  parameters.jitter = milliseconds(50);
+  auto jittery = CommImpairment(parameters, 1);
+  auto last_arrival = now;
+  for (int i = 0; i < 100; ++i) {
+    const auto sent = now + milliseconds(i);
+    const auto arrival = jittery.apply(bytes, sent);
+    EXPECT_GE(arrival, last_arrival);
+    EXPECT_GE(arrival, sent + parameters.delay);
+    EXPECT_LE(arrival, now + milliseconds(99) + parameters.delay + parameters.jitter);
+    last_arrival = arrival;
+  }
+  SUCCEED();
+}
+
+class TestImpairedInterface : public tritonai::gkc::ImpairedInterface
+{
+public:
+  using ImpairedInterface::ImpairedInterface;
+  std::function<void()> on_write {};
+
+protected:
+  size_t write(const tritonai::gkc::GkcBufferView & buffer, const CommPriority & priority)
+  {
+    if (on_write) {
+      auto hook = std::move(on_write);
+      on_write = nullptr;
+      hook();
+    }
+    return ImpairedInterface::write(buffer, priority);
+  }
+};
+
+TEST(TestImpairedInterface, SinglePriority) {
+  auto inner = std::make_shared<FakeComm>();
+  inner->tx_single_priority_ = true;
+  auto comm = TestImpairedInterface(nullptr, inner);
+  ASSERT_TRUE(comm.configure(sim_configs("legacy", false)));
+  ASSERT_TRUE(comm.open());
+  // Frames of several priorities are pending at once, but every write has one priority
+  comm.on_write = [&comm]() {
+      EXPECT_EQ(comm.send(frame(2), CommPriority::Background), 4u);
+      EXPECT_EQ(comm.send(frame(1), CommPriority::Urgent), 4u);
+    };
+  EXPECT_EQ(comm.send(frame(0), CommPriority::Heartbeat), 4u);
+  EXPECT_TRUE(wait_until([&inner]() {return inner->num_writes >= 3;}));
+  EXPECT_TRUE(comm.close());
+  ASSERT_EQ(inner->writes.size(), 3u);
+  EXPECT_EQ(inner->writes[1], frame(1));
+  EXPECT_EQ(inner->writes[2], frame(2));
+  EXPECT_EQ(inner->priorities[1], CommPriority::Urgent);
+  EXPECT_EQ(inner->priorities[2], CommPriority::Background);
+  SUCCEED();
+}
+
+TEST(TestImpairedInterface, SimDelay) {
+  auto configs = sim_configs("legacy", false);
+  configs.at("impairment_enabled") = tritonai::gkc::Configurable(true);
+  configs.at("impairment_delay_ms") = tritonai::gkc::Configurable(static_cast<int64_t>(20));
+  auto gkc = tritonai::gkc::GkcInterface(configs);
+  ASSERT_TRUE(wait_for_handshake(gkc));
+
+  // The new state takes a round trip of 40 ms to be reported
+  EXPECT_FALSE(gkc.initialize(sim_config_packet(), 10));
+  EXPECT_TRUE(wait_until([&gkc]() {return gkc.get_state() == GkcLifecycle::Initializing;}));
+  SUCCEED();
+}
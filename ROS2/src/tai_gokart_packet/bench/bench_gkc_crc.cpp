@@ -0,0 +1,49 @@
+/**
+ * @file bench_gkc_crc.cpp
+ * @brief CRC-16 cost per payload size
+ * @version 0.1
+ *
+ * @copyright Copyright 2026 Triton AI
+ *
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+#include <vector>
+
+#include "tai_gokart_packet/gkc_crc.hpp"
+
+namespace
+{
+std::vector<uint8_t> random_payload(const size_t & size)
+{
+  std::vector<uint8_t> payload(size, 0);
+  for (auto & byte : payload) {
+    byte = static_cast<uint8_t>(std::rand());
+  }
+  return payload;
+}
+}  // namespace
+
+// Payload sizes of 1 to 255 bytes
+static void BM_Crc16Bytewise(benchmark::State & state)
+{
+  const auto payload = random_payload(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+      tritonai::gkc::GkcCrc16::update_bytewise(0, payload.data(), payload.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * payload.size());
+}
+BENCHMARK(BM_Crc16Bytewise)->DenseRange(1, 255, 1)->MinTime(0.05);
+
+static void BM_Crc16(benchmark::State & state)
+{
+  const auto payload = random_payload(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(tritonai::gkc::GkcCrc16::compute(payload.data(), payload.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * payload.size());
+}
+BENCHMARK(BM_Crc16)->DenseRange(1, 255, 1)->MinTime(0.05);
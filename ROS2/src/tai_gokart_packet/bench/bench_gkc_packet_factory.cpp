@@ -0,0 +1,296 @@
+/**
+ * @file bench_gkc_packet_factory.cpp
+ * @brief Throughput of GkcPacketFactory::Receive and of the whole encode-receive pipeline
+ * @version 0.1
+ *
+ * @copyright Copyright 2026 Triton AI
+ *
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <string>
+#include <vector>
+
+#include "tai_gokart_packet/gkc_packets.hpp"
+#include "tai_gokart_packet/gkc_packet_factory.hpp"
+
+namespace
+{
+using tritonai::gkc::GkcBuffer;
+using ByteStream = std::vector<uint8_t>;
+
+class NullSub : public tritonai::gkc::GkcPacketSubscriber
+{
+public:
+  void packet_callback(const tritonai::gkc::Handshake1GkcPacket &) {++count;}
+  void packet_callback(const tritonai::gkc::Handshake2GkcPacket &) {++count;}
+  void packet_callback(const tritonai::gkc::GetFirmwareVersionGkcPacket &) {++count;}
+  void packet_callback(const tritonai::gkc::FirmwareVersionGkcPacket &) {++count;}
+  void packet_callback(const tritonai::gkc::ResetMcuGkcPacket &) {++count;}
+  void packet_callback(const tritonai::gkc::HeartbeatGkcPacket &) {++count;}
+  void packet_callback(const tritonai::gkc::ConfigGkcPacket &) {++count;}
+  void packet_callback(const tritonai::gkc::StateTransitionGkcPacket &) {++count;}
+  void packet_callback(const tritonai::gkc::ControlGkcPacket &) {++count;}
+  void packet_callback(const tritonai::gkc::SensorGkcPacket &) {++count;}
+  void packet_callback(const tritonai::gkc::Shutdown1GkcPacket &) {++count;}
+  void packet_callback(const tritonai::gkc::Shutdown2GkcPacket &) {++count;}
+  void packet_callback(const tritonai::gkc::LogPacket &) {++count;}
+  void packet_callback(const tritonai::gkc::LogIdGkcPacket &) {++count;}
+  void packet_callback(const tritonai::gkc::LogFilterGkcPacket &) {++count;}
+  void packet_callback(const tritonai::gkc::CompactSensorGkcPacket &) {++count;}
+  void packet_callback(const tritonai::gkc::CompactControlGkcPacket &) {++count;}
+  void packet_callback(const tritonai::gkc::SensorDeltaGkcPacket &) {++count;}
+  void packet_callback(const tritonai::gkc::SensorResyncGkcPacket &) {++count;}
+  void packet_callback(const tritonai::gkc::SensorBatchGkcPacket & packet)
+  {
+    ++count;
+    num_samples += packet.num_samples;
+  }
+  void packet_callback(const tritonai::gkc::BulkRequestGkcPacket &) {++count;}
+  void packet_callback(const tritonai::gkc::BulkStartGkcPacket &) {++count;}
+  void packet_callback(const tritonai::gkc::BulkChunkGkcPacket &) {++count;}
+  void packet_callback(const tritonai::gkc::BulkAckGkcPacket &) {++count;}
+
+  uint64_t count = 0;
+  uint64_t num_samples = 0;  // in SensorBatchGkcPacket
+};
+
+void quiet(std::string) {}
+
+// A mix shaped like the MCU's stream: mostly sensors, some heartbeats and logs
+class PacketMix
+{
+public:
+  PacketMix()
+  {
+    sensor.values = {};
+    sensor.values.wheel_speed_fl = 123.0;
+    sensor.values.voltage = 48.0;
+    hb.state = 3;
+    log.level = tritonai::gkc::LogPacket::Severity::INFO;
+    log.what = "Brake pressure sensor reading stable.";
+  }
+
+  const tritonai::gkc::GkcPacket & operator[](const size_t & i) const
+  {
+    if (i % 10 == 9) {
+      return log;
+    } else if (i % 5 == 4) {
+      return hb;
+    }
+    return sensor;
+  }
+
+private:
+  tritonai::gkc::SensorGkcPacket sensor;
+  tritonai::gkc::HeartbeatGkcPacket hb;
+  tritonai::gkc::LogPacket log;
+};
+
+std::vector<GkcBuffer> make_frames(const size_t & num_frames)
+{
+  const auto mix = PacketMix();
+  std::vector<GkcBuffer> frames;
+  for (size_t i = 0; i < num_frames; ++i) {
+    frames.push_back(*mix[i].encode()->encode());
+  }
+  return frames;
+}
+
+ByteStream make_stream(const size_t & num_frames)
+{
+  ByteStream stream;
+  for (const auto & frame : make_frames(num_frames)) {
+    stream.insert(stream.end(), frame.begin(), frame.end());
+  }
+  return stream;
+}
+
+std::vector<ByteStream> split(const ByteStream & stream, const size_t & chunk_size)
+{
+  std::vector<ByteStream> chunks;
+  for (size_t i = 0; i < stream.size(); i += chunk_size) {
+    const auto end = std::min(stream.size(), i + chunk_size);
+    chunks.emplace_back(stream.begin() + i, stream.begin() + end);
+  }
+  return chunks;
+}
+
+// Frames per second, and time per frame (in seconds; the console prints e.g. "37.5n")
+void set_frame_counters(benchmark::State & state, const uint64_t & num_frames)
+{
+  state.counters["frames_per_second"] = benchmark::Counter(
+    static_cast<double>(num_frames), benchmark::Counter::kIsRate);
+  state.counters["time_per_frame"] = benchmark::Counter(
+    static_cast<double>(num_frames), benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+
+constexpr size_t NUM_FRAMES = 1000;
+}  // namespace
+
+// Feed the factory one complete frame per call, as a packet-oriented link would
+static void BM_FactoryReceiveAligned(benchmark::State & state)
+{
+  auto sub = NullSub();
+  auto factory = tritonai::gkc::GkcPacketFactory(&sub, quiet);
+  const auto frames = make_frames(NUM_FRAMES);
+  for (auto _ : state) {
+    for (const auto & frame : frames) {
+      factory.Receive(frame);
+    }
+  }
+  if (sub.count != NUM_FRAMES * state.iterations()) {
+    state.SkipWithError("Frames were lost.");
+  }
+  set_frame_counters(state, sub.count);
+}
+BENCHMARK(BM_FactoryReceiveAligned);
+
+// Feed a stream of 1000 frames to the factory in chunks of `range(0)` bytes,
+// regardless of frame boundaries
+static void BM_FactoryReceive(benchmark::State & state)
+{
+  auto sub = NullSub();
+  auto factory = tritonai::gkc::GkcPacketFactory(&sub, quiet);
+  const auto chunks = split(make_stream(NUM_FRAMES), state.range(0));
+  for (auto _ : state) {
+    for (const auto & chunk : chunks) {
+      factory.Receive(chunk);
+    }
+  }
+  if (sub.count != NUM_FRAMES * state.iterations()) {
+    state.SkipWithError("Frames were lost.");
+  }
+  set_frame_counters(state, sub.count);
+}
+BENCHMARK(BM_FactoryReceive)->Arg(16)->Arg(256)->Arg(2048);
+
+// Like BM_FactoryReceive in 256-byte chunks, but one frame in every `range(0)` has
+// a flipped payload byte and must be dropped by the checksum
+static void BM_FactoryReceiveCorrupted(benchmark::State & state)
+{
+  auto sub = NullSub();
+  auto factory = tritonai::gkc::GkcPacketFactory(&sub, quiet);
+  auto frames = make_frames(NUM_FRAMES);
+  size_t num_corrupted = 0;
+  for (size_t i = 0; i < frames.size(); i += state.range(0)) {
+    frames[i][3] ^= 0x5A;
+    ++num_corrupted;
+  }
+  ByteStream stream;
+  for (const auto & frame : frames) {
+    stream.insert(stream.end(), frame.begin(), frame.end());
+  }
+  const auto chunks = split(stream, 256);
+  for (auto _ : state) {
+    for (const auto & chunk : chunks) {
+      factory.Receive(chunk);
+    }
+  }
+  if (sub.count != (NUM_FRAMES - num_corrupted) * state.iterations()) {
+    state.SkipWithError("Valid frames were lost.");
+  }
+  set_frame_counters(state, sub.count);
+}
+BENCHMARK(BM_FactoryReceiveCorrupted)->Arg(100)->Arg(10);
+
+// Like BM_FactoryReceive in 256-byte chunks, with `range(0)` bytes of line noise
+// (no start bytes) between frames
+static void BM_FactoryReceiveNoisy(benchmark::State & state)
+{
+  auto sub = NullSub();
+  auto factory = tritonai::gkc::GkcPacketFactory(&sub, quiet);
+  ByteStream noise(state.range(0));
+  for (size_t i = 0; i < noise.size(); ++i) {
+    noise[i] = static_cast<uint8_t>(0x10 + i * 7 % 0xE0);
+  }
+  ByteStream stream;
+  for (const auto & frame : make_frames(NUM_FRAMES)) {
+    stream.insert(stream.end(), noise.begin(), noise.end());
+    stream.insert(stream.end(), frame.begin(), frame.end());
+  }
+  const auto chunks = split(stream, 256);
+  for (auto _ : state) {
+    for (const auto & chunk : chunks) {
+      factory.Receive(chunk);
+    }
+  }
+  if (sub.count != NUM_FRAMES * state.iterations()) {
+    state.SkipWithError("Frames were lost.");
+  }
+  set_frame_counters(state, sub.count);
+  state.SetBytesProcessed(state.iterations() * stream.size());
+}
+BENCHMARK(BM_FactoryReceiveNoisy)->Arg(16)->Arg(256);
+
+// The whole pipeline: encode 1000 frames into a transmit buffer on one side,
+// hand it over in 256-byte chunks and receive them on the other side
+static void BM_Pipeline(benchmark::State & state)
+{
+  static constexpr size_t CHUNK_SIZE = 256;
+  auto sub = NullSub();
+  auto factory = tritonai::gkc::GkcPacketFactory(&sub, quiet);
+  const auto mix = PacketMix();
+  std::vector<uint8_t> tx(NUM_FRAMES * tritonai::gkc::GkcFrameFormat::MAX_FRAME_SIZE);
+  for (auto _ : state) {
+    size_t tx_size = 0;
+    for (size_t i = 0; i < NUM_FRAMES; ++i) {
+      tx_size += factory.Send(
+        mix[i], tritonai::gkc::GkcMutableBufferView(tx.data() + tx_size, tx.size() - tx_size));
+    }
+    for (size_t i = 0; i < tx_size; i += CHUNK_SIZE) {
+      factory.Receive(
+        tritonai::gkc::GkcBufferView(tx.data() + i, std::min(CHUNK_SIZE, tx_size - i)));
+    }
+  }
+  if (sub.count != NUM_FRAMES * state.iterations()) {
+    state.SkipWithError("Frames were lost.");
+  }
+  set_frame_counters(state, sub.count);
+}
+BENCHMARK(BM_Pipeline);
+
+// Send and receive `NUM_FRAMES` sensor samples, as one SensorGkcPacket per sample
+// (`range(0)` is 0) or as SensorBatchGkcPackets of `range(0)` samples each
+static void BM_SensorSamples(benchmark::State & state)
+{
+  static constexpr size_t CHUNK_SIZE = 256;
+  const size_t batch_size = state.range(0);
+  auto sub = NullSub();
+  auto factory = tritonai::gkc::GkcPacketFactory(&sub, quiet);
+  auto sensor = tritonai::gkc::SensorGkcPacket();
+  sensor.values = {};
+  sensor.values.wheel_speed_fl = 123.0;
+  sensor.values.voltage = 48.0;
+  auto batch = tritonai::gkc::SensorBatchGkcPacket();
+  batch.num_samples = batch_size;
+  for (size_t i = 0; i < batch_size; ++i) {
+    batch.samples[i] = {static_cast<uint16_t>(i * 1000), sensor.values};
+  }
+  const auto & packet = batch_size ? static_cast<const tritonai::gkc::GkcPacket &>(batch) :
+    static_cast<const tritonai::gkc::GkcPacket &>(sensor);
+  const size_t num_frames = batch_size ? NUM_FRAMES / batch_size : NUM_FRAMES;
+  std::vector<uint8_t> tx(num_frames * tritonai::gkc::GkcFrameFormat::MAX_FRAME_SIZE);
+  for (auto _ : state) {
+    size_t tx_size = 0;
+    for (size_t i = 0; i < num_frames; ++i) {
+      tx_size += factory.Send(
+        packet, tritonai::gkc::GkcMutableBufferView(tx.data() + tx_size, tx.size() - tx_size));
+    }
+    for (size_t i = 0; i < tx_size; i += CHUNK_SIZE) {
+      factory.Receive(
+        tritonai::gkc::GkcBufferView(tx.data() + i, std::min(CHUNK_SIZE, tx_size - i)));
+    }
+    state.counters["bytes_per_sample"] = static_cast<double>(tx_size) / NUM_FRAMES;
+  }
+  const uint64_t num_samples = batch_size ? sub.num_samples : sub.count;
+  if (num_samples != NUM_FRAMES * state.iterations()) {
+    state.SkipWithError("Samples were lost.");
+  }
+  state.counters["samples_per_second"] = benchmark::Counter(
+    static_cast<double>(num_samples), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_SensorSamples)->Arg(0)->Arg(5)->Arg(10);
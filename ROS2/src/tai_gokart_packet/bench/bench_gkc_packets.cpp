@@ -0,0 +1,118 @@
+/**
+ * @file bench_gkc_packets.cpp
+ * @brief Encoding and decoding cost of each packet type
+ * @version 0.1
+ *
+ * @copyright Copyright 2026 Triton AI
+ *
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+
+#include "tai_gokart_packet/gkc_logs.hpp"
+#include "tai_gokart_packet/gkc_packets.hpp"
+
+namespace
+{
+using tritonai::gkc::GkcFrameFormat;
+
+template<typename T>
+T make_packet()
+{
+  return T {};
+}
+
+template<>
+tritonai::gkc::LogPacket make_packet()
+{
+  auto log = tritonai::gkc::LogPacket();
+  log.level = tritonai::gkc::LogPacket::Severity::INFO;
+  log.what = "Brake pressure sensor reading stable.";
+  return log;
+}
+
+template<>
+tritonai::gkc::LogIdGkcPacket make_packet()
+{
+  return tritonai::gkc::GkcLogs::brake_fault(2100.0f);
+}
+}  // namespace
+
+// Encode a complete frame into a stack buffer
+template<typename T>
+static void BM_EncodeInto(benchmark::State & state)
+{
+  const auto packet = make_packet<T>();
+  std::array<uint8_t, GkcFrameFormat::MAX_FRAME_SIZE> frame {};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(packet.encode_into(frame));
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * packet.encode_into(frame));
+}
+
+// Encode a complete frame through the heap-allocated RawGkcPacket and GkcBuffer
+template<typename T>
+static void BM_EncodeShared(benchmark::State & state)
+{
+  const auto packet = make_packet<T>();
+  for (auto _ : state) {
+    auto frame = packet.encode()->encode();
+    benchmark::DoNotOptimize(frame->data());
+  }
+}
+
+// Decode a validated payload
+template<typename T>
+static void BM_Decode(benchmark::State & state)
+{
+  std::array<uint8_t, GkcFrameFormat::MAX_FRAME_SIZE> frame {};
+  const auto payload_size =
+    make_packet<T>().encode_into(frame) - GkcFrameFormat::NUM_NON_PAYLOAD_BYTES;
+  const auto payload = tritonai::gkc::GkcBufferView(
+    frame.data() + GkcFrameFormat::NUM_BYTES_BEFORE_PAYLOAD, payload_size);
+  auto packet = T();
+  for (auto _ : state) {
+    packet.decode(payload);
+    benchmark::DoNotOptimize(&packet);
+    benchmark::ClobberMemory();
+  }
+}
+
+#define GKC_BENCHMARK_PACKET(T) \
+  BENCHMARK_TEMPLATE(BM_EncodeInto, tritonai::gkc::T); \
+  BENCHMARK_TEMPLATE(BM_EncodeShared, tritonai::gkc::T); \
+  BENCHMARK_TEMPLATE(BM_Decode, tritonai::gkc::T)
+
+GKC_BENCHMARK_PACKET(Handshake1GkcPacket);
+GKC_BENCHMARK_PACKET(Handshake2GkcPacket);
+GKC_BENCHMARK_PACKET(GetFirmwareVersionGkcPacket);
+GKC_BENCHMARK_PACKET(FirmwareVersionGkcPacket);
+GKC_BENCHMARK_PACKET(ResetMcuGkcPacket);
+GKC_BENCHMARK_PACKET(HeartbeatGkcPacket);
+GKC_BENCHMARK_PACKET(ConfigGkcPacket);
+GKC_BENCHMARK_PACKET(StateTransitionGkcPacket);
+GKC_BENCHMARK_PACKET(ControlGkcPacket);
+GKC_BENCHMARK_PACKET(SensorGkcPacket);
+GKC_BENCHMARK_PACKET(Shutdown1GkcPacket);
+GKC_BENCHMARK_PACKET(Shutdown2GkcPacket);
+GKC_BENCHMARK_PACKET(LogPacket);
+GKC_BENCHMARK_PACKET(LogIdGkcPacket);
+GKC_BENCHMARK_PACKET(CompactSensorGkcPacket);
+GKC_BENCHMARK_PACKET(CompactControlGkcPacket);
+GKC_BENCHMARK_PACKET(SensorDeltaGkcPacket);
+GKC_BENCHMARK_PACKET(SensorResyncGkcPacket);
+GKC_BENCHMARK_PACKET(SensorBatchGkcPacket);
+
+// Expand a log by ID into text, as the PC does after decoding it
+static void BM_ExpandLog(benchmark::State & state)
+{
+  const auto packet = make_packet<tritonai::gkc::LogIdGkcPacket>();
+  for (auto _ : state) {
+    auto log = tritonai::gkc::GkcLogTable::expand(packet);
+    benchmark::DoNotOptimize(log.what.data());
+  }
+}
+BENCHMARK(BM_ExpandLog);
@@ -0,0 +1,192 @@
+/**
+ * @file gkc_log_defs.hpp
+ * @brief Log IDs, formats and builders
+ * Generated by tools/gkc_codegen.py from schema/gkc_packets.yaml. Do not edit.
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2026 [Triton AI]
+ *
+ */
+
+#ifndef TAI_GOKART_PACKET__GENERATED__GKC_LOG_DEFS_HPP_
+#define TAI_GOKART_PACKET__GENERATED__GKC_LOG_DEFS_HPP_
+
+#ifndef TAI_GOKART_PACKET__GKC_LOGS_HPP_
+#error "Include tai_gokart_packet/gkc_logs.hpp instead."
+#endif
+
+namespace tritonai
+{
+namespace gkc
+{
+/**
+ * @brief IDs of the logs sent as `LogIdGkcPacket`
+ */
+enum class GkcLogId : uint16_t
+{
+  CONTROL_TIMEOUT = 1,
+  COMM_TIMEOUT = 2,
+  SENSOR_TIMEOUT = 3,
+  TRANSITION_REJECTED = 4,
+  BRAKE_FAULT = 5,
+  THROTTLE_FAULT = 6,
+  STEERING_FAULT = 7,
+  LOW_VOLTAGE = 8,
+  EMERGENCY_STOP = 9,
+  MALFORMED_FRAMES = 10,
+  LOGS_SUPPRESSED = 11
+};
+
+struct GkcLogFormat
+{
+  GkcLogId id;
+  const char * name;
+  LogIdGkcPacket::Severity level;  // default of `GkcLogs`
+  const char * format;  // printf format, one conversion per argument
+  size_t num_args;
+  GkcLogArg args[4];  // types, in the order of the payload
+};
+
+/**
+ * @brief Format of every log, sorted by ID
+ */
+inline constexpr GkcLogFormat GKC_LOG_FORMATS[] = {
+  {GkcLogId::CONTROL_TIMEOUT, "CONTROL_TIMEOUT", LogIdGkcPacket::WARNING,
+    "No control for %u ms.", 1, {GkcLogArg::UInt32}},
+  {GkcLogId::COMM_TIMEOUT, "COMM_TIMEOUT", LogIdGkcPacket::WARNING,
+    "No heartbeat for %u ms.", 1, {GkcLogArg::UInt32}},
+  {GkcLogId::SENSOR_TIMEOUT, "SENSOR_TIMEOUT", LogIdGkcPacket::WARNING,
+    "Sensor %u not polled for %u ms.", 2, {GkcLogArg::UInt8, GkcLogArg::UInt32}},
+  {GkcLogId::TRANSITION_REJECTED, "TRANSITION_REJECTED", LogIdGkcPacket::WARNING,
+    "Cannot go from state %u to state %u.", 2, {GkcLogArg::UInt8, GkcLogArg::UInt8}},
+  {GkcLogId::BRAKE_FAULT, "BRAKE_FAULT", LogIdGkcPacket::ERROR,
+    "Brake fault at %.1f psi.", 1, {GkcLogArg::Float}},
+  {GkcLogId::THROTTLE_FAULT, "THROTTLE_FAULT", LogIdGkcPacket::ERROR,
+    "Throttle fault at %.3f.", 1, {GkcLogArg::Float}},
+  {GkcLogId::STEERING_FAULT, "STEERING_FAULT", LogIdGkcPacket::ERROR,
+    "Steering fault at %.3f rad, servo at %.3f rad.", 2, {GkcLogArg::Float, GkcLogArg::Float}},
+  {GkcLogId::LOW_VOLTAGE, "LOW_VOLTAGE", LogIdGkcPacket::WARNING,
+    "Battery low at %.2f V.", 1, {GkcLogArg::Float}},
+  {GkcLogId::EMERGENCY_STOP, "EMERGENCY_STOP", LogIdGkcPacket::FATAL,
+    "Emergency stop, remote %s.", 1, {GkcLogArg::Bool}},
+  {GkcLogId::MALFORMED_FRAMES, "MALFORMED_FRAMES", LogIdGkcPacket::INFO,
+    "Dropped %u malformed frames.", 1, {GkcLogArg::UInt32}},
+  {GkcLogId::LOGS_SUPPRESSED, "LOGS_SUPPRESSED", LogIdGkcPacket::WARNING,
+    "%u logs over the rate limit.", 1, {GkcLogArg::UInt32}},
+};
+inline constexpr size_t GKC_NUM_LOG_FORMATS =
+  sizeof(GKC_LOG_FORMATS) / sizeof(GKC_LOG_FORMATS[0]);
+
+/**
+ * @brief Builders of `LogIdGkcPacket`, one per log, with its default level
+ */
+class GkcLogs
+{
+public:
+  // No control for %u ms.
+  static LogIdGkcPacket control_timeout(const uint32_t & elapsed_ms)
+  {
+    auto packet = make(GkcLogId::CONTROL_TIMEOUT, LogIdGkcPacket::WARNING, 4);
+    GkcPacketUtils::write_to_buffer(packet.args.data(), elapsed_ms);
+    return packet;
+  }
+
+  // No heartbeat for %u ms.
+  static LogIdGkcPacket comm_timeout(const uint32_t & elapsed_ms)
+  {
+    auto packet = make(GkcLogId::COMM_TIMEOUT, LogIdGkcPacket::WARNING, 4);
+    GkcPacketUtils::write_to_buffer(packet.args.data(), elapsed_ms);
+    return packet;
+  }
+
+  // Sensor %u not polled for %u ms.
+  static LogIdGkcPacket sensor_timeout(const uint8_t & sensor, const uint32_t & elapsed_ms)
+  {
+    auto packet = make(GkcLogId::SENSOR_TIMEOUT, LogIdGkcPacket::WARNING, 5);
+    GkcPacketUtils::write_to_buffer(packet.args.data(), sensor);
+    GkcPacketUtils::write_to_buffer(packet.args.data() + 1, elapsed_ms);
+    return packet;
+  }
+
+  // Cannot go from state %u to state %u.
+  static LogIdGkcPacket transition_rejected(const uint8_t & from, const uint8_t & to)
+  {
+    auto packet = make(GkcLogId::TRANSITION_REJECTED, LogIdGkcPacket::WARNING, 2);
+    GkcPacketUtils::write_to_buffer(packet.args.data(), from);
+    GkcPacketUtils::write_to_buffer(packet.args.data() + 1, to);
+    return packet;
+  }
+
+  // Brake fault at %.1f psi.
+  static LogIdGkcPacket brake_fault(const float & pressure_psi)
+  {
+    auto packet = make(GkcLogId::BRAKE_FAULT, LogIdGkcPacket::ERROR, 4);
+    GkcPacketUtils::write_to_buffer(packet.args.data(), pressure_psi);
+    return packet;
+  }
+
+  // Throttle fault at %.3f.
+  static LogIdGkcPacket throttle_fault(const float & position)
+  {
+    auto packet = make(GkcLogId::THROTTLE_FAULT, LogIdGkcPacket::ERROR, 4);
+    GkcPacketUtils::write_to_buffer(packet.args.data(), position);
+    return packet;
+  }
+
+  // Steering fault at %.3f rad, servo at %.3f rad.
+  static LogIdGkcPacket steering_fault(
+    const float & steering_angle_rad, const float & servo_angle_rad)
+  {
+    auto packet = make(GkcLogId::STEERING_FAULT, LogIdGkcPacket::ERROR, 8);
+    GkcPacketUtils::write_to_buffer(packet.args.data(), steering_angle_rad);
+    GkcPacketUtils::write_to_buffer(packet.args.data() + 4, servo_angle_rad);
+    return packet;
+  }
+
+  // Battery low at %.2f V.
+  static LogIdGkcPacket low_voltage(const float & voltage)
+  {
+    auto packet = make(GkcLogId::LOW_VOLTAGE, LogIdGkcPacket::WARNING, 4);
+    GkcPacketUtils::write_to_buffer(packet.args.data(), voltage);
+    return packet;
+  }
+
+  // Emergency stop, remote %s.
+  static LogIdGkcPacket emergency_stop(const bool & remote)
+  {
+    auto packet = make(GkcLogId::EMERGENCY_STOP, LogIdGkcPacket::FATAL, 1);
+    GkcPacketUtils::write_to_buffer(packet.args.data(), remote);
+    return packet;
+  }
+
+  // Dropped %u malformed frames.
+  static LogIdGkcPacket malformed_frames(const uint32_t & count)
+  {
+    auto packet = make(GkcLogId::MALFORMED_FRAMES, LogIdGkcPacket::INFO, 4);
+    GkcPacketUtils::write_to_buffer(packet.args.data(), count);
+    return packet;
+  }
+
+  // %u logs over the rate limit.
+  static LogIdGkcPacket logs_suppressed(const uint32_t & count)
+  {
+    auto packet = make(GkcLogId::LOGS_SUPPRESSED, LogIdGkcPacket::WARNING, 4);
+    GkcPacketUtils::write_to_buffer(packet.args.data(), count);
+    return packet;
+  }
+
+private:
+  static LogIdGkcPacket make(
+    const GkcLogId & id, const LogIdGkcPacket::Severity & level,
+    const size_t & args_size)
+  {
+    auto packet = LogIdGkcPacket();
+    packet.level = level;
+    packet.id = static_cast<uint16_t>(id);
+    packet.args.resize(args_size);
+    return packet;
+  }
+};
+}  // namespace gkc
+}  // namespace tritonai
+#endif  // TAI_GOKART_PACKET__GENERATED__GKC_LOG_DEFS_HPP_
@@ -0,0 +1,102 @@
+/**
+ * @file gkc_msg_conversions.hpp
+ * @brief Conversions between packets and the ROS messages in tai_gokart_msgs
+ * Generated by tools/gkc_codegen.py from schema/gkc_packets.yaml. Do not edit.
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2026 [Triton AI]
+ *
+ */
+
+#ifndef TAI_GOKART_PACKET__GENERATED__GKC_MSG_CONVERSIONS_HPP_
+#define TAI_GOKART_PACKET__GENERATED__GKC_MSG_CONVERSIONS_HPP_
+
+#include "tai_gokart_packet/gkc_packets.hpp"
+
+namespace tritonai
+{
+namespace gkc
+{
+/**
+ * @brief Copy every field of `ControlGkcPacket` into a message
+ * with the same field names, e.g. `tai_gokart_msgs::msg::GkcCommand`
+ */
+template<typename MsgT>
+void to_msg(const ControlGkcPacket & packet, MsgT & msg)
+{
+  msg.throttle = packet.throttle;
+  msg.steering = packet.steering;
+  msg.brake = packet.brake;
+}
+
+/**
+ * @brief Copy every field of `ControlGkcPacket` from a message
+ * with the same field names, e.g. `tai_gokart_msgs::msg::GkcCommand`
+ */
+template<typename MsgT>
+void from_msg(const MsgT & msg, ControlGkcPacket & packet)
+{
+  packet.throttle = msg.throttle;
+  packet.steering = msg.steering;
+  packet.brake = msg.brake;
+}
+
+/**
+ * @brief Copy every field of `SensorGkcPacket::SensorValues` into a message
+ * with the same field names, e.g. `tai_gokart_msgs::msg::GkcState`
+ */
+template<typename MsgT>
+void to_msg(const SensorGkcPacket::SensorValues & values, MsgT & msg)
+{
+  msg.wheel_speed_fl = values.wheel_speed_fl;
+  msg.wheel_speed_fr = values.wheel_speed_fr;
+  msg.wheel_speed_rl = values.wheel_speed_rl;
+  msg.wheel_speed_rr = values.wheel_speed_rr;
+  msg.voltage = values.voltage;
+  msg.amperage = values.amperage;
+  msg.brake_pressure = values.brake_pressure;
+  msg.throttle_pos = values.throttle_pos;
+  msg.steering_angle_rad = values.steering_angle_rad;
+  msg.servo_angle_rad = values.servo_angle_rad;
+  msg.fault_brake = values.fault_brake;
+  msg.fault_throttle = values.fault_throttle;
+  msg.fault_steering = values.fault_steering;
+  msg.fault_fatal = values.fault_fatal;
+  msg.fault_error = values.fault_error;
+  msg.fault_warning = values.fault_warning;
+  msg.fault_info = values.fault_info;
+}
+
+/**
+ * @brief Copy every field of `SensorGkcPacket::SensorValues` from a message
+ * with the same field names, e.g. `tai_gokart_msgs::msg::GkcState`
+ */
+template<typename MsgT>
+void from_msg(const MsgT & msg, SensorGkcPacket::SensorValues & values)
+{
+  values.wheel_speed_fl = msg.wheel_speed_fl;
+  values.wheel_speed_fr = msg.wheel_speed_fr;
+  values.wheel_speed_rl = msg.wheel_speed_rl;
+  values.wheel_speed_rr = msg.wheel_speed_rr;
+  values.voltage = msg.voltage;
+  values.amperage = msg.amperage;
+  values.brake_pressure = msg.brake_pressure;
+  values.throttle_pos = msg.throttle_pos;
+  values.steering_angle_rad = msg.steering_angle_rad;
+  values.servo_angle_rad = msg.servo_angle_rad;
+  values.fault_brake = msg.fault_brake;
+  values.fault_throttle = msg.fault_throttle;
+  values.fault_steering = msg.fault_steering;
+  values.fault_fatal = msg.fault_fatal;
+  values.fault_error = msg.fault_error;
+  values.fault_warning = msg.fault_warning;
+  values.fault_info = msg.fault_info;
+}
+
+template<typename MsgT>
+void to_msg(const SensorGkcPacket & packet, MsgT & msg) {to_msg(packet.values, msg);}
+template<typename MsgT>
+void from_msg(const MsgT & msg, SensorGkcPacket & packet) {from_msg(msg, packet.values);}
+}  // namespace gkc
+}  // namespace tritonai
+#endif  // TAI_GOKART_PACKET__GENERATED__GKC_MSG_CONVERSIONS_HPP_
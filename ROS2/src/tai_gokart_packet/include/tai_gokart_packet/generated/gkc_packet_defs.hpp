@@ -0,0 +1,535 @@
+/**
+ * @file gkc_packet_defs.hpp
+ * @brief Packet classes
+ * Generated by tools/gkc_codegen.py from schema/gkc_packets.yaml. Do not edit.
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2026 [Triton AI]
+ *
+ */
+
+#ifndef TAI_GOKART_PACKET__GENERATED__GKC_PACKET_DEFS_HPP_
+#define TAI_GOKART_PACKET__GENERATED__GKC_PACKET_DEFS_HPP_
+
+#ifndef TAI_GOKART_PACKET__GKC_PACKETS_HPP_
+#error "Include tai_gokart_packet/gkc_packets.hpp instead."
+#endif
+
+namespace tritonai
+{
+namespace gkc
+{
+class Handshake1GkcPacket : public GkcPacket
+{
+public:
+  static constexpr uint8_t FIRST_BYTE = 0x04;
+  uint32_t seq_number = 0;
+  uint8_t capabilities = 0;  // `GkcCapabilities` bits, only sent if not 0
+  static constexpr size_t PAYLOAD_SIZE = 5;
+  size_t payload_size() const
+  {
+    return capabilities ? PAYLOAD_SIZE + 1 : PAYLOAD_SIZE;
+  }
+  void encode_payload(uint8_t * payload) const;
+  using GkcPacket::decode;
+  void decode(const GkcBufferView & payload);
+  void publish(GkcPacketSubscriber & sub) {sub.packet_callback(*this);}
+};
+
+class Handshake2GkcPacket : public GkcPacket
+{
+public:
+  static constexpr uint8_t FIRST_BYTE = 0x05;
+  uint32_t seq_number = 0;
+  uint8_t capabilities = 0;  // `GkcCapabilities` bits, only sent if not 0
+  static constexpr size_t PAYLOAD_SIZE = 5;
+  size_t payload_size() const
+  {
+    return capabilities ? PAYLOAD_SIZE + 1 : PAYLOAD_SIZE;
+  }
+  void encode_payload(uint8_t * payload) const;
+  using GkcPacket::decode;
+  void decode(const GkcBufferView & payload);
+  void publish(GkcPacketSubscriber & sub) {sub.packet_callback(*this);}
+};
+
+class GetFirmwareVersionGkcPacket : public GkcPacket
+{
+public:
+  static constexpr uint8_t FIRST_BYTE = 0x06;
+  static constexpr size_t PAYLOAD_SIZE = 1;
+  size_t payload_size() const {return PAYLOAD_SIZE;}
+  void encode_payload(uint8_t * payload) const;
+  using GkcPacket::decode;
+  void decode(const GkcBufferView & payload);
+  void publish(GkcPacketSubscriber & sub) {sub.packet_callback(*this);}
+};
+
+class FirmwareVersionGkcPacket : public GkcPacket
+{
+public:
+  static constexpr uint8_t FIRST_BYTE = 0x07;
+  uint8_t major = 0;
+  uint8_t minor = 0;
+  uint8_t patch = 0;
+  static constexpr size_t PAYLOAD_SIZE = 4;
+  size_t payload_size() const {return PAYLOAD_SIZE;}
+  void encode_payload(uint8_t * payload) const;
+  using GkcPacket::decode;
+  void decode(const GkcBufferView & payload);
+  void publish(GkcPacketSubscriber & sub) {sub.packet_callback(*this);}
+};
+
+class ResetMcuGkcPacket : public GkcPacket
+{
+public:
+  static constexpr uint8_t FIRST_BYTE = 0xFF;
+  uint32_t magic_number = 0;
+  static constexpr size_t PAYLOAD_SIZE = 5;
+  size_t payload_size() const {return PAYLOAD_SIZE;}
+  void encode_payload(uint8_t * payload) const;
+  using GkcPacket::decode;
+  void decode(const GkcBufferView & payload);
+  void publish(GkcPacketSubscriber & sub) {sub.packet_callback(*this);}
+};
+
+class HeartbeatGkcPacket : public GkcPacket
+{
+public:
+  static constexpr uint8_t FIRST_BYTE = 0xAA;
+  uint8_t rolling_counter = 0;
+  uint8_t state = 0;
+  static constexpr size_t PAYLOAD_SIZE = 3;
+  size_t payload_size() const {return PAYLOAD_SIZE;}
+  void encode_payload(uint8_t * payload) const;
+  using GkcPacket::decode;
+  void decode(const GkcBufferView & payload);
+  void publish(GkcPacketSubscriber & sub) {sub.packet_callback(*this);}
+};
+
+class ConfigGkcPacket : public GkcPacket
+{
+public:
+  static constexpr uint8_t FIRST_BYTE = 0xA0;
+  struct __attribute__((packed)) Configurables
+  {
+    // steering config (refers to average front wheel angle in radian)
+    float max_steering_left;
+    float max_steering_right;
+    float neutral_steering;  // should be between max and min
+
+    // throttle config (unit is implementation-dependant, typically unit-less out of 1.0)
+    float max_throttle;
+    float min_throttle;
+    float zero_throttle;  // should be smaller than min
+
+    // brake config (in psi)
+    float max_brake;
+    float min_brake;
+    float zero_brake;  // should be smaller than min
+
+    // watchdog timeouts (in millisecond)
+    uint32_t control_timeout_ms;  // timeout for control packets
+    uint32_t comm_timeout_ms;  // timeout for heartbeat packets
+    uint32_t sensor_timeout_ms;  // timeout between two sensor pollings
+  } values;
+  static constexpr size_t PAYLOAD_SIZE = 49;
+  static_assert(sizeof(Configurables) + 1 == PAYLOAD_SIZE, "Configurables must be packed.");
+  size_t payload_size() const {return PAYLOAD_SIZE;}
+  void encode_payload(uint8_t * payload) const;
+  using GkcPacket::decode;
+  void decode(const GkcBufferView & payload);
+  void publish(GkcPacketSubscriber & sub) {sub.packet_callback(*this);}
+};
+
+class StateTransitionGkcPacket : public GkcPacket
+{
+public:
+  static constexpr uint8_t FIRST_BYTE = 0xA1;
+  uint8_t requested_state = 0;
+  static constexpr size_t PAYLOAD_SIZE = 2;
+  size_t payload_size() const {return PAYLOAD_SIZE;}
+  void encode_payload(uint8_t * payload) const;
+  using GkcPacket::decode;
+  void decode(const GkcBufferView & payload);
+  void publish(GkcPacketSubscriber & sub) {sub.packet_callback(*this);}
+};
+
+class LogFilterGkcPacket : public GkcPacket
+{
+public:
+  static constexpr uint8_t FIRST_BYTE = 0xA4;
+  enum Severity
+  {
+    INFO = 0,
+    WARNING = 1,
+    ERROR = 2,
+    FATAL = 3
+  } min_level = INFO;
+  uint16_t max_logs_per_second = 0;  // 0 for no limit, fatal logs excepted
+  static constexpr size_t PAYLOAD_SIZE = 4;
+  size_t payload_size() const {return PAYLOAD_SIZE;}
+  void encode_payload(uint8_t * payload) const;
+  using GkcPacket::decode;
+  void decode(const GkcBufferView & payload);
+  void publish(GkcPacketSubscriber & sub) {sub.packet_callback(*this);}
+};
+
+class ControlGkcPacket : public GkcPacket
+{
+public:
+  static constexpr uint8_t FIRST_BYTE = 0xAB;
+  float throttle = 0;  // paddle percentage out of 1.0
+  float steering = 0;  // average front wheel angle in radian
+  float brake = 0;  // target brake pressure in psi
+  static constexpr size_t PAYLOAD_SIZE = 13;
+  size_t payload_size() const {return PAYLOAD_SIZE;}
+  void encode_payload(uint8_t * payload) const;
+  using GkcPacket::decode;
+  void decode(const GkcBufferView & payload);
+  void publish(GkcPacketSubscriber & sub) {sub.packet_callback(*this);}
+};
+
+class SensorGkcPacket : public GkcPacket
+{
+public:
+  static constexpr uint8_t FIRST_BYTE = 0xAC;
+  struct __attribute__((packed)) SensorValues
+  {
+    float wheel_speed_fl;  // wheel speeds in rpm
+    float wheel_speed_fr;
+    float wheel_speed_rl;
+    float wheel_speed_rr;
+
+    float voltage;  // battery voltage in volt
+    float amperage;  // battery current draw in amp
+
+    float brake_pressure;  // brake pressure in psi
+    float throttle_pos;  // throttle paddle position out of 1.0
+    float steering_angle_rad;  // (left +, right -) average wheel angle of the front wheels in rad
+    float servo_angle_rad;  // (left +, right -) servo offset from center in rad
+
+    bool fault_brake;  // fault flag in actuation subsystem
+    bool fault_throttle;
+    bool fault_steering;
+
+    bool fault_fatal;  // fault flag with severity level
+    bool fault_error;
+    bool fault_warning;
+    bool fault_info;
+  } values;
+  static constexpr size_t PAYLOAD_SIZE = 48;
+  static_assert(sizeof(SensorValues) + 1 == PAYLOAD_SIZE, "SensorValues must be packed.");
+  size_t payload_size() const {return PAYLOAD_SIZE;}
+  void encode_payload(uint8_t * payload) const;
+  using GkcPacket::decode;
+  void decode(const GkcBufferView & payload);
+  void publish(GkcPacketSubscriber & sub) {sub.packet_callback(*this);}
+};
+
+class Shutdown1GkcPacket : public GkcPacket
+{
+public:
+  static constexpr uint8_t FIRST_BYTE = 0xA2;
+  uint32_t seq_number = 0;
+  static constexpr size_t PAYLOAD_SIZE = 5;
+  size_t payload_size() const {return PAYLOAD_SIZE;}
+  void encode_payload(uint8_t * payload) const;
+  using GkcPacket::decode;
+  void decode(const GkcBufferView & payload);
+  void publish(GkcPacketSubscriber & sub) {sub.packet_callback(*this);}
+};
+
+class Shutdown2GkcPacket : public GkcPacket
+{
+public:
+  static constexpr uint8_t FIRST_BYTE = 0xA3;
+  uint32_t seq_number = 0;
+  static constexpr size_t PAYLOAD_SIZE = 5;
+  size_t payload_size() const {return PAYLOAD_SIZE;}
+  void encode_payload(uint8_t * payload) const;
+  using GkcPacket::decode;
+  void decode(const GkcBufferView & payload);
+  void publish(GkcPacketSubscriber & sub) {sub.packet_callback(*this);}
+};
+
+class LogPacket : public GkcPacket
+{
+public:
+  static constexpr uint8_t FIRST_BYTE = 0xAD;
+  enum Severity
+  {
+    INFO = 0,
+    WARNING = 1,
+    ERROR = 2,
+    FATAL = 3
+  } level = INFO;
+  static constexpr size_t MAX_WHAT_SIZE = GkcFrameFormat::MAX_PAYLOAD_SIZE - 2;
+#ifndef GKC_PACKET_MCU_PROFILE
+  typedef std::string String;
+#else
+  typedef GkcFixedString<MAX_WHAT_SIZE> String;
+#endif
+  String what;
+  static constexpr size_t MIN_PAYLOAD_SIZE = 2;
+  size_t payload_size() const;  // `what` beyond `MAX_WHAT_SIZE` is truncated
+  void encode_payload(uint8_t * payload) const;
+  using GkcPacket::decode;
+  void decode(const GkcBufferView & payload);
+  void publish(GkcPacketSubscriber & sub) {sub.packet_callback(*this);}
+};
+
+class LogIdGkcPacket : public GkcPacket
+{
+public:
+  static constexpr uint8_t FIRST_BYTE = 0xB7;
+  enum Severity
+  {
+    INFO = 0,
+    WARNING = 1,
+    ERROR = 2,
+    FATAL = 3
+  } level = INFO;
+  uint16_t id = 0;  // `GkcLogId`
+  static constexpr size_t MAX_ARGS_SIZE = 16;
+  typedef GkcInlineBuffer<MAX_ARGS_SIZE> Bytes;
+  Bytes args;  // arguments in the types of the log
+  static constexpr size_t MIN_PAYLOAD_SIZE = 4;
+  size_t payload_size() const;  // `args` beyond `MAX_ARGS_SIZE` is truncated
+  void encode_payload(uint8_t * payload) const;
+  using GkcPacket::decode;
+  void decode(const GkcBufferView & payload);
+  void publish(GkcPacketSubscriber & sub) {sub.packet_callback(*this);}
+};
+
+/**
+ * @brief `SensorGkcPacket` in a compact encoding
+ */
+class CompactSensorGkcPacket : public GkcPacket
+{
+public:
+  static constexpr uint8_t FIRST_BYTE = 0xAE;
+  SensorGkcPacket::SensorValues values;
+  // resolution of the fixed-point fields
+  static constexpr float WHEEL_SPEED_FL_RESOLUTION = 0.1f;
+  static constexpr float WHEEL_SPEED_FR_RESOLUTION = 0.1f;
+  static constexpr float WHEEL_SPEED_RL_RESOLUTION = 0.1f;
+  static constexpr float WHEEL_SPEED_RR_RESOLUTION = 0.1f;
+  static constexpr float VOLTAGE_RESOLUTION = 0.01f;
+  static constexpr float AMPERAGE_RESOLUTION = 0.01f;
+  static constexpr float BRAKE_PRESSURE_RESOLUTION = 0.1f;
+  static constexpr float THROTTLE_POS_RESOLUTION = 0.0001f;
+  static constexpr float STEERING_ANGLE_RAD_RESOLUTION = 0.0001f;
+  static constexpr float SERVO_ANGLE_RAD_RESOLUTION = 0.0001f;
+  static constexpr size_t PAYLOAD_SIZE = 22;
+  size_t payload_size() const {return PAYLOAD_SIZE;}
+  CompactSensorGkcPacket() = default;
+  explicit CompactSensorGkcPacket(const SensorGkcPacket & packet);
+  SensorGkcPacket expand() const;
+  void encode_payload(uint8_t * payload) const;
+  using GkcPacket::decode;
+  void decode(const GkcBufferView & payload);
+  void publish(GkcPacketSubscriber & sub) {sub.packet_callback(*this);}
+};
+
+/**
+ * @brief `ControlGkcPacket` in a compact encoding
+ */
+class CompactControlGkcPacket : public GkcPacket
+{
+public:
+  static constexpr uint8_t FIRST_BYTE = 0xAF;
+  float throttle = 0;  // paddle percentage out of 1.0
+  float steering = 0;  // average front wheel angle in radian
+  float brake = 0;  // target brake pressure in psi
+  // resolution of the fixed-point fields
+  static constexpr float THROTTLE_RESOLUTION = 0.0001f;
+  static constexpr float STEERING_RESOLUTION = 0.0001f;
+  static constexpr float BRAKE_RESOLUTION = 0.1f;
+  static constexpr size_t PAYLOAD_SIZE = 7;
+  size_t payload_size() const {return PAYLOAD_SIZE;}
+  CompactControlGkcPacket() = default;
+  explicit CompactControlGkcPacket(const ControlGkcPacket & packet);
+  ControlGkcPacket expand() const;
+  void encode_payload(uint8_t * payload) const;
+  using GkcPacket::decode;
+  void decode(const GkcBufferView & payload);
+  void publish(GkcPacketSubscriber & sub) {sub.packet_callback(*this);}
+};
+
+/**
+ * @brief The fields of `CompactSensorGkcPacket` that changed since a keyframe
+ */
+class SensorDeltaGkcPacket : public GkcPacket
+{
+public:
+  typedef CompactSensorGkcPacket Compact;
+  static constexpr uint8_t FIRST_BYTE = 0xB0;
+  static constexpr size_t NUM_FIELDS = 11;
+  static constexpr uint16_t ALL_FIELDS = 0x07FF;
+  static constexpr uint16_t KEYFRAME = 0x8000;  // flag in `changed`
+  uint8_t keyframe_id = 0;  // keyframe that the unchanged fields are taken from
+  uint16_t changed = 0;  // bit i is set if field i of `Compact` is sent
+  SensorGkcPacket::SensorValues values;  // only the changed fields are valid
+  static constexpr size_t MIN_PAYLOAD_SIZE = 4;
+  size_t payload_size() const;
+  // Set `changed` to the fields of `values` that differ from `keyframe` once encoded
+  void set_changes(const SensorGkcPacket::SensorValues & keyframe);
+  // Copy the changed fields into `keyframe`
+  void apply_to(SensorGkcPacket::SensorValues & keyframe) const;
+  void encode_payload(uint8_t * payload) const;
+  using GkcPacket::decode;
+  void decode(const GkcBufferView & payload);
+  void publish(GkcPacketSubscriber & sub) {sub.packet_callback(*this);}
+
+private:
+  // where the fields are in the payload of `Compact`
+  static constexpr uint8_t FIELD_OFFSETS[NUM_FIELDS + 1] = {
+    1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 22};
+};
+
+class SensorResyncGkcPacket : public GkcPacket
+{
+public:
+  static constexpr uint8_t FIRST_BYTE = 0xB1;
+  uint8_t keyframe_id = 0;  // last keyframe received
+  static constexpr size_t PAYLOAD_SIZE = 2;
+  size_t payload_size() const {return PAYLOAD_SIZE;}
+  void encode_payload(uint8_t * payload) const;
+  using GkcPacket::decode;
+  void decode(const GkcBufferView & payload);
+  void publish(GkcPacketSubscriber & sub) {sub.packet_callback(*this);}
+};
+
+/**
+ * @brief Up to `MAX_SAMPLES` timestamped samples of `CompactSensorGkcPacket`
+ */
+class SensorBatchGkcPacket : public GkcPacket
+{
+public:
+  typedef CompactSensorGkcPacket Compact;
+  static constexpr uint8_t FIRST_BYTE = 0xB2;
+  static constexpr size_t MIN_PAYLOAD_SIZE = 6;
+  // time offset and the payload of `Compact` without its first byte
+  static constexpr size_t SAMPLE_SIZE = sizeof(uint16_t) + Compact::PAYLOAD_SIZE - 1;
+  static constexpr size_t MAX_SAMPLES =
+    (GkcFrameFormat::MAX_PAYLOAD_SIZE - MIN_PAYLOAD_SIZE) / SAMPLE_SIZE;
+  struct Sample
+  {
+    uint16_t time_offset_us;  // since `timestamp_us`
+    SensorGkcPacket::SensorValues values;
+  };
+  uint32_t timestamp_us = 0;  // MCU time of the batch in microsecond
+  uint8_t num_samples = 0;  // samples beyond `MAX_SAMPLES` are not sent
+  std::array<Sample, MAX_SAMPLES> samples;
+  size_t payload_size() const;
+  void encode_payload(uint8_t * payload) const;
+  using GkcPacket::decode;
+  void decode(const GkcBufferView & payload);
+  void publish(GkcPacketSubscriber & sub) {sub.packet_callback(*this);}
+};
+
+class BulkRequestGkcPacket : public GkcPacket
+{
+public:
+  static constexpr uint8_t FIRST_BYTE = 0xB3;
+  uint16_t resource = 0;  // what to send, defined by the application
+  static constexpr size_t PAYLOAD_SIZE = 3;
+  size_t payload_size() const {return PAYLOAD_SIZE;}
+  void encode_payload(uint8_t * payload) const;
+  using GkcPacket::decode;
+  void decode(const GkcBufferView & payload);
+  void publish(GkcPacketSubscriber & sub) {sub.packet_callback(*this);}
+};
+
+class BulkStartGkcPacket : public GkcPacket
+{
+public:
+  static constexpr uint8_t FIRST_BYTE = 0xB4;
+  uint8_t transfer_id = 0;
+  uint16_t resource = 0;
+  uint32_t total_size = 0;  // in byte
+  uint16_t chunk_size = 0;  // of every chunk but the last, in byte
+  uint8_t window = 0;  // chunks sent ahead of the acknowledgement
+  uint32_t crc = 0;  // CRC-32 of the whole data
+  static constexpr size_t PAYLOAD_SIZE = 15;
+  size_t payload_size() const {return PAYLOAD_SIZE;}
+  void encode_payload(uint8_t * payload) const;
+  using GkcPacket::decode;
+  void decode(const GkcBufferView & payload);
+  void publish(GkcPacketSubscriber & sub) {sub.packet_callback(*this);}
+};
+
+class BulkChunkGkcPacket : public GkcPacket
+{
+public:
+  static constexpr uint8_t FIRST_BYTE = 0xB5;
+  uint8_t transfer_id = 0;
+  uint16_t seq = 0;  // index of the chunk
+  static constexpr size_t MAX_DATA_SIZE = GkcFrameFormat::MAX_EXTENDED_PAYLOAD_SIZE - 4;
+  typedef GkcInlineBuffer<MAX_DATA_SIZE> Bytes;
+  Bytes data;
+  static constexpr size_t MIN_PAYLOAD_SIZE = 4;
+  size_t payload_size() const;  // `data` beyond `MAX_DATA_SIZE` is truncated
+  void encode_payload(uint8_t * payload) const;
+  using GkcPacket::decode;
+  void decode(const GkcBufferView & payload);
+  void publish(GkcPacketSubscriber & sub) {sub.packet_callback(*this);}
+};
+
+class BulkAckGkcPacket : public GkcPacket
+{
+public:
+  static constexpr uint8_t FIRST_BYTE = 0xB6;
+  uint8_t transfer_id = 0;
+  uint16_t next_seq = 0;  // every chunk before it was received
+  enum Status
+  {
+    IN_PROGRESS = 0,
+    GAP = 1,
+    COMPLETE = 2,
+    CRC_ERROR = 3,
+    REJECTED = 4
+  } status = IN_PROGRESS;
+  static constexpr size_t PAYLOAD_SIZE = 5;
+  size_t payload_size() const {return PAYLOAD_SIZE;}
+  void encode_payload(uint8_t * payload) const;
+  using GkcPacket::decode;
+  void decode(const GkcBufferView & payload);
+  void publish(GkcPacketSubscriber & sub) {sub.packet_callback(*this);}
+};
+
+template<typename ... Ts>
+struct GkcPacketTypeList {};
+
+/**
+ * @brief All packets the factory can receive
+ */
+using GkcPacketTypes = GkcPacketTypeList<
+  Handshake1GkcPacket,
+  Handshake2GkcPacket,
+  GetFirmwareVersionGkcPacket,
+  FirmwareVersionGkcPacket,
+  ResetMcuGkcPacket,
+  HeartbeatGkcPacket,
+  ConfigGkcPacket,
+  StateTransitionGkcPacket,
+  LogFilterGkcPacket,
+  ControlGkcPacket,
+  SensorGkcPacket,
+  Shutdown1GkcPacket,
+  Shutdown2GkcPacket,
+  LogPacket,
+  LogIdGkcPacket,
+  CompactSensorGkcPacket,
+  CompactControlGkcPacket,
+  SensorDeltaGkcPacket,
+  SensorResyncGkcPacket,
+  SensorBatchGkcPacket,
+  BulkRequestGkcPacket,
+  BulkStartGkcPacket,
+  BulkChunkGkcPacket,
+  BulkAckGkcPacket>;
+}  // namespace gkc
+}  // namespace tritonai
+#endif  // TAI_GOKART_PACKET__GENERATED__GKC_PACKET_DEFS_HPP_
@@ -0,0 +1,670 @@
+/**
+ * @file gkc_packet_defs.ipp
+ * @brief Packet codecs
+ * Generated by tools/gkc_codegen.py from schema/gkc_packets.yaml. Do not edit.
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2026 [Triton AI]
+ *
+ */
+
+#ifndef TAI_GOKART_PACKET__GENERATED__GKC_PACKET_DEFS_IPP_
+#define TAI_GOKART_PACKET__GENERATED__GKC_PACKET_DEFS_IPP_
+
+#include <algorithm>
+#include <cstring>
+
+#include "tai_gokart_packet/gkc_packets.hpp"
+
+namespace tritonai
+{
+namespace gkc
+{
+/*
+Handshake1GkcPacket
+*/
+GKC_PACKET_INLINE void Handshake1GkcPacket::encode_payload(uint8_t * payload) const
+{
+  payload[0] = FIRST_BYTE;
+  GkcPacketUtils::write_to_buffer(payload + 1, seq_number);
+  if (capabilities) {
+    GkcPacketUtils::write_to_buffer(payload + 5, capabilities);
+  }
+}
+
+GKC_PACKET_INLINE void Handshake1GkcPacket::decode(const GkcBufferView & payload)
+{
+  GkcPacketUtils::read_from_buffer(payload.data() + 1, seq_number);
+  // Peers that do not know `capabilities` send a shorter payload
+  if (payload.size() >= PAYLOAD_SIZE + 1) {
+    GkcPacketUtils::read_from_buffer(payload.data() + 5, capabilities);
+  } else {
+    capabilities = 0;
+  }
+}
+
+/*
+Handshake2GkcPacket
+*/
+GKC_PACKET_INLINE void Handshake2GkcPacket::encode_payload(uint8_t * payload) const
+{
+  payload[0] = FIRST_BYTE;
+  GkcPacketUtils::write_to_buffer(payload + 1, seq_number);
+  if (capabilities) {
+    GkcPacketUtils::write_to_buffer(payload + 5, capabilities);
+  }
+}
+
+GKC_PACKET_INLINE void Handshake2GkcPacket::decode(const GkcBufferView & payload)
+{
+  GkcPacketUtils::read_from_buffer(payload.data() + 1, seq_number);
+  // Peers that do not know `capabilities` send a shorter payload
+  if (payload.size() >= PAYLOAD_SIZE + 1) {
+    GkcPacketUtils::read_from_buffer(payload.data() + 5, capabilities);
+  } else {
+    capabilities = 0;
+  }
+}
+
+/*
+GetFirmwareVersionGkcPacket
+*/
+GKC_PACKET_INLINE void GetFirmwareVersionGkcPacket::encode_payload(uint8_t * payload) const
+{
+  payload[0] = FIRST_BYTE;
+}
+
+GKC_PACKET_INLINE void GetFirmwareVersionGkcPacket::decode(const GkcBufferView & payload)
+{
+  (void)payload;
+}
+
+/*
+FirmwareVersionGkcPacket
+*/
+GKC_PACKET_INLINE void FirmwareVersionGkcPacket::encode_payload(uint8_t * payload) const
+{
+  payload[0] = FIRST_BYTE;
+  GkcPacketUtils::write_to_buffer(payload + 1, major);
+  GkcPacketUtils::write_to_buffer(payload + 2, minor);
+  GkcPacketUtils::write_to_buffer(payload + 3, patch);
+}
+
+GKC_PACKET_INLINE void FirmwareVersionGkcPacket::decode(const GkcBufferView & payload)
+{
+  GkcPacketUtils::read_from_buffer(payload.data() + 1, major);
+  GkcPacketUtils::read_from_buffer(payload.data() + 2, minor);
+  GkcPacketUtils::read_from_buffer(payload.data() + 3, patch);
+}
+
+/*
+ResetMcuGkcPacket
+*/
+GKC_PACKET_INLINE void ResetMcuGkcPacket::encode_payload(uint8_t * payload) const
+{
+  payload[0] = FIRST_BYTE;
+  GkcPacketUtils::write_to_buffer(payload + 1, magic_number);
+}
+
+GKC_PACKET_INLINE void ResetMcuGkcPacket::decode(const GkcBufferView & payload)
+{
+  GkcPacketUtils::read_from_buffer(payload.data() + 1, magic_number);
+}
+
+/*
+HeartbeatGkcPacket
+*/
+GKC_PACKET_INLINE void HeartbeatGkcPacket::encode_payload(uint8_t * payload) const
+{
+  payload[0] = FIRST_BYTE;
+  GkcPacketUtils::write_to_buffer(payload + 1, rolling_counter);
+  GkcPacketUtils::write_to_buffer(payload + 2, state);
+}
+
+GKC_PACKET_INLINE void HeartbeatGkcPacket::decode(const GkcBufferView & payload)
+{
+  GkcPacketUtils::read_from_buffer(payload.data() + 1, rolling_counter);
+  GkcPacketUtils::read_from_buffer(payload.data() + 2, state);
+}
+
+/*
+ConfigGkcPacket
+*/
+GKC_PACKET_INLINE void ConfigGkcPacket::encode_payload(uint8_t * payload) const
+{
+  payload[0] = FIRST_BYTE;
+  GkcPacketUtils::write_to_buffer(payload + 1, values);
+}
+
+GKC_PACKET_INLINE void ConfigGkcPacket::decode(const GkcBufferView & payload)
+{
+  GkcPacketUtils::read_from_buffer(payload.data() + 1, values);
+}
+
+/*
+StateTransitionGkcPacket
+*/
+GKC_PACKET_INLINE void StateTransitionGkcPacket::encode_payload(uint8_t * payload) const
+{
+  payload[0] = FIRST_BYTE;
+  GkcPacketUtils::write_to_buffer(payload + 1, requested_state);
+}
+
+GKC_PACKET_INLINE void StateTransitionGkcPacket::decode(const GkcBufferView & payload)
+{
+  GkcPacketUtils::read_from_buffer(payload.data() + 1, requested_state);
+}
+
+/*
+LogFilterGkcPacket
+*/
+GKC_PACKET_INLINE void LogFilterGkcPacket::encode_payload(uint8_t * payload) const
+{
+  payload[0] = FIRST_BYTE;
+  payload[1] = static_cast<uint8_t>(min_level);
+  GkcPacketUtils::write_to_buffer(payload + 2, max_logs_per_second);
+}
+
+GKC_PACKET_INLINE void LogFilterGkcPacket::decode(const GkcBufferView & payload)
+{
+  min_level = static_cast<Severity>(payload[1]);
+  GkcPacketUtils::read_from_buffer(payload.data() + 2, max_logs_per_second);
+}
+
+/*
+ControlGkcPacket
+*/
+GKC_PACKET_INLINE void ControlGkcPacket::encode_payload(uint8_t * payload) const
+{
+  payload[0] = FIRST_BYTE;
+  GkcPacketUtils::write_to_buffer(payload + 1, throttle);
+  GkcPacketUtils::write_to_buffer(payload + 5, steering);
+  GkcPacketUtils::write_to_buffer(payload + 9, brake);
+}
+
+GKC_PACKET_INLINE void ControlGkcPacket::decode(const GkcBufferView & payload)
+{
+  GkcPacketUtils::read_from_buffer(payload.data() + 1, throttle);
+  GkcPacketUtils::read_from_buffer(payload.data() + 5, steering);
+  GkcPacketUtils::read_from_buffer(payload.data() + 9, brake);
+}
+
+/*
+SensorGkcPacket
+*/
+GKC_PACKET_INLINE void SensorGkcPacket::encode_payload(uint8_t * payload) const
+{
+  payload[0] = FIRST_BYTE;
+  GkcPacketUtils::write_to_buffer(payload + 1, values);
+}
+
+GKC_PACKET_INLINE void SensorGkcPacket::decode(const GkcBufferView & payload)
+{
+  GkcPacketUtils::read_from_buffer(payload.data() + 1, values);
+}
+
+/*
+Shutdown1GkcPacket
+*/
+GKC_PACKET_INLINE void Shutdown1GkcPacket::encode_payload(uint8_t * payload) const
+{
+  payload[0] = FIRST_BYTE;
+  GkcPacketUtils::write_to_buffer(payload + 1, seq_number);
+}
+
+GKC_PACKET_INLINE void Shutdown1GkcPacket::decode(const GkcBufferView & payload)
+{
+  GkcPacketUtils::read_from_buffer(payload.data() + 1, seq_number);
+}
+
+/*
+Shutdown2GkcPacket
+*/
+GKC_PACKET_INLINE void Shutdown2GkcPacket::encode_payload(uint8_t * payload) const
+{
+  payload[0] = FIRST_BYTE;
+  GkcPacketUtils::write_to_buffer(payload + 1, seq_number);
+}
+
+GKC_PACKET_INLINE void Shutdown2GkcPacket::decode(const GkcBufferView & payload)
+{
+  GkcPacketUtils::read_from_buffer(payload.data() + 1, seq_number);
+}
+
+/*
+LogPacket
+*/
+GKC_PACKET_INLINE size_t LogPacket::payload_size() const
+{
+  return std::min(what.size(), MAX_WHAT_SIZE) + MIN_PAYLOAD_SIZE;
+}
+
+GKC_PACKET_INLINE void LogPacket::encode_payload(uint8_t * payload) const
+{
+  payload[0] = FIRST_BYTE;
+  payload[1] = static_cast<uint8_t>(level);
+  std::copy(what.begin(), what.begin() + (payload_size() - MIN_PAYLOAD_SIZE), payload + 2);
+}
+
+GKC_PACKET_INLINE void LogPacket::decode(const GkcBufferView & payload)
+{
+  level = static_cast<Severity>(payload[1]);
+  // char pointer overload: assigning from uint8_t iterators goes through a temporary string
+  what.assign(
+    reinterpret_cast<const char *>(payload.data() + 2), payload.size() - 2);
+}
+
+/*
+LogIdGkcPacket
+*/
+GKC_PACKET_INLINE size_t LogIdGkcPacket::payload_size() const
+{
+  return std::min(args.size(), MAX_ARGS_SIZE) + MIN_PAYLOAD_SIZE;
+}
+
+GKC_PACKET_INLINE void LogIdGkcPacket::encode_payload(uint8_t * payload) const
+{
+  payload[0] = FIRST_BYTE;
+  payload[1] = static_cast<uint8_t>(level);
+  GkcPacketUtils::write_to_buffer(payload + 2, id);
+  std::copy(args.begin(), args.begin() + (payload_size() - MIN_PAYLOAD_SIZE), payload + 4);
+}
+
+GKC_PACKET_INLINE void LogIdGkcPacket::decode(const GkcBufferView & payload)
+{
+  level = static_cast<Severity>(payload[1]);
+  GkcPacketUtils::read_from_buffer(payload.data() + 2, id);
+  // Bytes beyond the capacity of `args` are dropped
+  args.assign(
+    payload.begin() + std::min<size_t>(payload.size(), 4),
+    payload.begin() + std::min<size_t>(payload.size(), 4 + args.capacity()));
+}
+
+/*
+CompactSensorGkcPacket
+*/
+GKC_PACKET_INLINE CompactSensorGkcPacket::CompactSensorGkcPacket(
+  const SensorGkcPacket & packet)
+{
+  values = packet.values;
+}
+
+GKC_PACKET_INLINE SensorGkcPacket CompactSensorGkcPacket::expand() const
+{
+  auto packet = SensorGkcPacket();
+  packet.values = values;
+  return packet;
+}
+
+GKC_PACKET_INLINE void CompactSensorGkcPacket::encode_payload(uint8_t * payload) const
+{
+  payload[0] = FIRST_BYTE;
+  GkcPacketUtils::write_fixed_point<int16_t>(
+    payload + 1, values.wheel_speed_fl, WHEEL_SPEED_FL_RESOLUTION);
+  GkcPacketUtils::write_fixed_point<int16_t>(
+    payload + 3, values.wheel_speed_fr, WHEEL_SPEED_FR_RESOLUTION);
+  GkcPacketUtils::write_fixed_point<int16_t>(
+    payload + 5, values.wheel_speed_rl, WHEEL_SPEED_RL_RESOLUTION);
+  GkcPacketUtils::write_fixed_point<int16_t>(
+    payload + 7, values.wheel_speed_rr, WHEEL_SPEED_RR_RESOLUTION);
+  GkcPacketUtils::write_fixed_point<uint16_t>(
+    payload + 9, values.voltage, VOLTAGE_RESOLUTION);
+  GkcPacketUtils::write_fixed_point<int16_t>(
+    payload + 11, values.amperage, AMPERAGE_RESOLUTION);
+  GkcPacketUtils::write_fixed_point<uint16_t>(
+    payload + 13, values.brake_pressure, BRAKE_PRESSURE_RESOLUTION);
+  GkcPacketUtils::write_fixed_point<int16_t>(
+    payload + 15, values.throttle_pos, THROTTLE_POS_RESOLUTION);
+  GkcPacketUtils::write_fixed_point<int16_t>(
+    payload + 17, values.steering_angle_rad, STEERING_ANGLE_RAD_RESOLUTION);
+  GkcPacketUtils::write_fixed_point<int16_t>(
+    payload + 19, values.servo_angle_rad, SERVO_ANGLE_RAD_RESOLUTION);
+  payload[21] = static_cast<uint8_t>(
+    (values.fault_brake << 0) |
+    (values.fault_throttle << 1) |
+    (values.fault_steering << 2) |
+    (values.fault_fatal << 3) |
+    (values.fault_error << 4) |
+    (values.fault_warning << 5) |
+    (values.fault_info << 6));
+}
+
+GKC_PACKET_INLINE void CompactSensorGkcPacket::decode(const GkcBufferView & payload)
+{
+  values.wheel_speed_fl = GkcPacketUtils::read_fixed_point<int16_t>(
+    payload.data() + 1, WHEEL_SPEED_FL_RESOLUTION);
+  values.wheel_speed_fr = GkcPacketUtils::read_fixed_point<int16_t>(
+    payload.data() + 3, WHEEL_SPEED_FR_RESOLUTION);
+  values.wheel_speed_rl = GkcPacketUtils::read_fixed_point<int16_t>(
+    payload.data() + 5, WHEEL_SPEED_RL_RESOLUTION);
+  values.wheel_speed_rr = GkcPacketUtils::read_fixed_point<int16_t>(
+    payload.data() + 7, WHEEL_SPEED_RR_RESOLUTION);
+  values.voltage = GkcPacketUtils::read_fixed_point<uint16_t>(
+    payload.data() + 9, VOLTAGE_RESOLUTION);
+  values.amperage = GkcPacketUtils::read_fixed_point<int16_t>(
+    payload.data() + 11, AMPERAGE_RESOLUTION);
+  values.brake_pressure = GkcPacketUtils::read_fixed_point<uint16_t>(
+    payload.data() + 13, BRAKE_PRESSURE_RESOLUTION);
+  values.throttle_pos = GkcPacketUtils::read_fixed_point<int16_t>(
+    payload.data() + 15, THROTTLE_POS_RESOLUTION);
+  values.steering_angle_rad = GkcPacketUtils::read_fixed_point<int16_t>(
+    payload.data() + 17, STEERING_ANGLE_RAD_RESOLUTION);
+  values.servo_angle_rad = GkcPacketUtils::read_fixed_point<int16_t>(
+    payload.data() + 19, SERVO_ANGLE_RAD_RESOLUTION);
+  values.fault_brake = payload[21] & 0x01;
+  values.fault_throttle = payload[21] & 0x02;
+  values.fault_steering = payload[21] & 0x04;
+  values.fault_fatal = payload[21] & 0x08;
+  values.fault_error = payload[21] & 0x10;
+  values.fault_warning = payload[21] & 0x20;
+  values.fault_info = payload[21] & 0x40;
+}
+
+/*
+CompactControlGkcPacket
+*/
+GKC_PACKET_INLINE CompactControlGkcPacket::CompactControlGkcPacket(
+  const ControlGkcPacket & packet)
+{
+  throttle = packet.throttle;
+  steering = packet.steering;
+  brake = packet.brake;
+}
+
+GKC_PACKET_INLINE ControlGkcPacket CompactControlGkcPacket::expand() const
+{
+  auto packet = ControlGkcPacket();
+  packet.throttle = throttle;
+  packet.steering = steering;
+  packet.brake = brake;
+  return packet;
+}
+
+GKC_PACKET_INLINE void CompactControlGkcPacket::encode_payload(uint8_t * payload) const
+{
+  payload[0] = FIRST_BYTE;
+  GkcPacketUtils::write_fixed_point<int16_t>(
+    payload + 1, throttle, THROTTLE_RESOLUTION);
+  GkcPacketUtils::write_fixed_point<int16_t>(
+    payload + 3, steering, STEERING_RESOLUTION);
+  GkcPacketUtils::write_fixed_point<uint16_t>(
+    payload + 5, brake, BRAKE_RESOLUTION);
+}
+
+GKC_PACKET_INLINE void CompactControlGkcPacket::decode(const GkcBufferView & payload)
+{
+  throttle = GkcPacketUtils::read_fixed_point<int16_t>(
+    payload.data() + 1, THROTTLE_RESOLUTION);
+  steering = GkcPacketUtils::read_fixed_point<int16_t>(
+    payload.data() + 3, STEERING_RESOLUTION);
+  brake = GkcPacketUtils::read_fixed_point<uint16_t>(
+    payload.data() + 5, BRAKE_RESOLUTION);
+}
+
+/*
+SensorDeltaGkcPacket
+*/
+GKC_PACKET_INLINE size_t SensorDeltaGkcPacket::payload_size() const
+{
+  size_t size = MIN_PAYLOAD_SIZE;
+  for (size_t i = 0; i < NUM_FIELDS; ++i) {
+    if (changed & (1 << i)) {
+      size += FIELD_OFFSETS[i + 1] - FIELD_OFFSETS[i];
+    }
+  }
+  return size;
+}
+
+GKC_PACKET_INLINE void SensorDeltaGkcPacket::set_changes(
+  const SensorGkcPacket::SensorValues & keyframe)
+{
+  uint8_t now[Compact::PAYLOAD_SIZE];
+  uint8_t before[Compact::PAYLOAD_SIZE];
+  auto compact = Compact();
+  compact.values = values;
+  compact.encode_payload(now);
+  compact.values = keyframe;
+  compact.encode_payload(before);
+  changed = 0;
+  for (size_t i = 0; i < NUM_FIELDS; ++i) {
+    const size_t offset = FIELD_OFFSETS[i];
+    if (std::memcmp(now + offset, before + offset, FIELD_OFFSETS[i + 1] - offset) != 0) {
+      changed |= 1 << i;
+    }
+  }
+}
+
+GKC_PACKET_INLINE void SensorDeltaGkcPacket::apply_to(
+  SensorGkcPacket::SensorValues & keyframe) const
+{
+  if (changed & 0x0001) {
+    keyframe.wheel_speed_fl = values.wheel_speed_fl;
+  }
+  if (changed & 0x0002) {
+    keyframe.wheel_speed_fr = values.wheel_speed_fr;
+  }
+  if (changed & 0x0004) {
+    keyframe.wheel_speed_rl = values.wheel_speed_rl;
+  }
+  if (changed & 0x0008) {
+    keyframe.wheel_speed_rr = values.wheel_speed_rr;
+  }
+  if (changed & 0x0010) {
+    keyframe.voltage = values.voltage;
+  }
+  if (changed & 0x0020) {
+    keyframe.amperage = values.amperage;
+  }
+  if (changed & 0x0040) {
+    keyframe.brake_pressure = values.brake_pressure;
+  }
+  if (changed & 0x0080) {
+    keyframe.throttle_pos = values.throttle_pos;
+  }
+  if (changed & 0x0100) {
+    keyframe.steering_angle_rad = values.steering_angle_rad;
+  }
+  if (changed & 0x0200) {
+    keyframe.servo_angle_rad = values.servo_angle_rad;
+  }
+  if (changed & 0x0400) {
+    keyframe.fault_brake = values.fault_brake;
+    keyframe.fault_throttle = values.fault_throttle;
+    keyframe.fault_steering = values.fault_steering;
+    keyframe.fault_fatal = values.fault_fatal;
+    keyframe.fault_error = values.fault_error;
+    keyframe.fault_warning = values.fault_warning;
+    keyframe.fault_info = values.fault_info;
+  }
+}
+
+GKC_PACKET_INLINE void SensorDeltaGkcPacket::encode_payload(uint8_t * payload) const
+{
+  uint8_t fields[Compact::PAYLOAD_SIZE];
+  auto compact = Compact();
+  compact.values = values;
+  compact.encode_payload(fields);
+  payload[0] = FIRST_BYTE;
+  payload[1] = keyframe_id;
+  GkcPacketUtils::write_to_buffer(payload + 2, changed);
+  uint8_t * next = payload + MIN_PAYLOAD_SIZE;
+  for (size_t i = 0; i < NUM_FIELDS; ++i) {
+    if (changed & (1 << i)) {
+      next = std::copy(fields + FIELD_OFFSETS[i], fields + FIELD_OFFSETS[i + 1], next);
+    }
+  }
+}
+
+GKC_PACKET_INLINE void SensorDeltaGkcPacket::decode(const GkcBufferView & payload)
+{
+  // A payload shorter than `changed` announces does not change anything
+  changed = 0;
+  if (payload.size() < MIN_PAYLOAD_SIZE) {
+    return;
+  }
+  keyframe_id = payload[1];
+  GkcPacketUtils::read_from_buffer(payload.data() + 2, changed);
+  if (payload.size() < payload_size()) {
+    changed = 0;
+    return;
+  }
+  uint8_t fields[Compact::PAYLOAD_SIZE] = {};
+  const uint8_t * next = payload.data() + MIN_PAYLOAD_SIZE;
+  for (size_t i = 0; i < NUM_FIELDS; ++i) {
+    if (changed & (1 << i)) {
+      const size_t size = FIELD_OFFSETS[i + 1] - FIELD_OFFSETS[i];
+      std::copy(next, next + size, fields + FIELD_OFFSETS[i]);
+      next += size;
+    }
+  }
+  auto compact = Compact();
+  compact.decode(GkcBufferView(fields, Compact::PAYLOAD_SIZE));
+  values = compact.values;
+}
+
+/*
+SensorResyncGkcPacket
+*/
+GKC_PACKET_INLINE void SensorResyncGkcPacket::encode_payload(uint8_t * payload) const
+{
+  payload[0] = FIRST_BYTE;
+  GkcPacketUtils::write_to_buffer(payload + 1, keyframe_id);
+}
+
+GKC_PACKET_INLINE void SensorResyncGkcPacket::decode(const GkcBufferView & payload)
+{
+  GkcPacketUtils::read_from_buffer(payload.data() + 1, keyframe_id);
+}
+
+/*
+SensorBatchGkcPacket
+*/
+GKC_PACKET_INLINE size_t SensorBatchGkcPacket::payload_size() const
+{
+  return MIN_PAYLOAD_SIZE + std::min<size_t>(num_samples, MAX_SAMPLES) * SAMPLE_SIZE;
+}
+
+GKC_PACKET_INLINE void SensorBatchGkcPacket::encode_payload(uint8_t * payload) const
+{
+  const auto count = static_cast<uint8_t>(std::min<size_t>(num_samples, MAX_SAMPLES));
+  payload[0] = FIRST_BYTE;
+  GkcPacketUtils::write_to_buffer(payload + 1, timestamp_us);
+  payload[5] = count;
+  uint8_t fields[Compact::PAYLOAD_SIZE];
+  auto compact = Compact();
+  uint8_t * next = payload + MIN_PAYLOAD_SIZE;
+  for (size_t i = 0; i < count; ++i) {
+    next = GkcPacketUtils::write_to_buffer(next, samples[i].time_offset_us);
+    compact.values = samples[i].values;
+    compact.encode_payload(fields);
+    next = std::copy(fields + 1, fields + Compact::PAYLOAD_SIZE, next);
+  }
+}
+
+GKC_PACKET_INLINE void SensorBatchGkcPacket::decode(const GkcBufferView & payload)
+{
+  // Only the samples that are complete in the payload are decoded
+  num_samples = 0;
+  if (payload.size() < MIN_PAYLOAD_SIZE) {
+    return;
+  }
+  GkcPacketUtils::read_from_buffer(payload.data() + 1, timestamp_us);
+  const size_t count = std::min<size_t>(
+    {payload[5], MAX_SAMPLES, (payload.size() - MIN_PAYLOAD_SIZE) / SAMPLE_SIZE});
+  uint8_t fields[Compact::PAYLOAD_SIZE] = {Compact::FIRST_BYTE};
+  auto compact = Compact();
+  const uint8_t * next = payload.data() + MIN_PAYLOAD_SIZE;
+  for (size_t i = 0; i < count; ++i) {
+    next = GkcPacketUtils::read_from_buffer(next, samples[i].time_offset_us);
+    std::copy(next, next + Compact::PAYLOAD_SIZE - 1, fields + 1);
+    next += Compact::PAYLOAD_SIZE - 1;
+    compact.decode(GkcBufferView(fields, Compact::PAYLOAD_SIZE));
+    samples[i].values = compact.values;
+  }
+  num_samples = static_cast<uint8_t>(count);
+}
+
+/*
+BulkRequestGkcPacket
+*/
+GKC_PACKET_INLINE void BulkRequestGkcPacket::encode_payload(uint8_t * payload) const
+{
+  payload[0] = FIRST_BYTE;
+  GkcPacketUtils::write_to_buffer(payload + 1, resource);
+}
+
+GKC_PACKET_INLINE void BulkRequestGkcPacket::decode(const GkcBufferView & payload)
+{
+  GkcPacketUtils::read_from_buffer(payload.data() + 1, resource);
+}
+
+/*
+BulkStartGkcPacket
+*/
+GKC_PACKET_INLINE void BulkStartGkcPacket::encode_payload(uint8_t * payload) const
+{
+  payload[0] = FIRST_BYTE;
+  GkcPacketUtils::write_to_buffer(payload + 1, transfer_id);
+  GkcPacketUtils::write_to_buffer(payload + 2, resource);
+  GkcPacketUtils::write_to_buffer(payload + 4, total_size);
+  GkcPacketUtils::write_to_buffer(payload + 8, chunk_size);
+  GkcPacketUtils::write_to_buffer(payload + 10, window);
+  GkcPacketUtils::write_to_buffer(payload + 11, crc);
+}
+
+GKC_PACKET_INLINE void BulkStartGkcPacket::decode(const GkcBufferView & payload)
+{
+  GkcPacketUtils::read_from_buffer(payload.data() + 1, transfer_id);
+  GkcPacketUtils::read_from_buffer(payload.data() + 2, resource);
+  GkcPacketUtils::read_from_buffer(payload.data() + 4, total_size);
+  GkcPacketUtils::read_from_buffer(payload.data() + 8, chunk_size);
+  GkcPacketUtils::read_from_buffer(payload.data() + 10, window);
+  GkcPacketUtils::read_from_buffer(payload.data() + 11, crc);
+}
+
+/*
+BulkChunkGkcPacket
+*/
+GKC_PACKET_INLINE size_t BulkChunkGkcPacket::payload_size() const
+{
+  return std::min(data.size(), MAX_DATA_SIZE) + MIN_PAYLOAD_SIZE;
+}
+
+GKC_PACKET_INLINE void BulkChunkGkcPacket::encode_payload(uint8_t * payload) const
+{
+  payload[0] = FIRST_BYTE;
+  GkcPacketUtils::write_to_buffer(payload + 1, transfer_id);
+  GkcPacketUtils::write_to_buffer(payload + 2, seq);
+  std::copy(data.begin(), data.begin() + (payload_size() - MIN_PAYLOAD_SIZE), payload + 4);
+}
+
+GKC_PACKET_INLINE void BulkChunkGkcPacket::decode(const GkcBufferView & payload)
+{
+  GkcPacketUtils::read_from_buffer(payload.data() + 1, transfer_id);
+  GkcPacketUtils::read_from_buffer(payload.data() + 2, seq);
+  // Bytes beyond the capacity of `data` are dropped
+  data.assign(
+    payload.begin() + std::min<size_t>(payload.size(), 4),
+    payload.begin() + std::min<size_t>(payload.size(), 4 + data.capacity()));
+}
+
+/*
+BulkAckGkcPacket
+*/
+GKC_PACKET_INLINE void BulkAckGkcPacket::encode_payload(uint8_t * payload) const
+{
+  payload[0] = FIRST_BYTE;
+  GkcPacketUtils::write_to_buffer(payload + 1, transfer_id);
+  GkcPacketUtils::write_to_buffer(payload + 2, next_seq);
+  payload[4] = static_cast<uint8_t>(status);
+}
+
+GKC_PACKET_INLINE void BulkAckGkcPacket::decode(const GkcBufferView & payload)
+{
+  GkcPacketUtils::read_from_buffer(payload.data() + 1, transfer_id);
+  GkcPacketUtils::read_from_buffer(payload.data() + 2, next_seq);
+  status = static_cast<Status>(payload[4]);
+}
+}  // namespace gkc
+}  // namespace tritonai
+#endif  // TAI_GOKART_PACKET__GENERATED__GKC_PACKET_DEFS_IPP_
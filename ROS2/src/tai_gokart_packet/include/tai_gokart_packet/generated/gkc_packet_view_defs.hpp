@@ -0,0 +1,79 @@
+/**
+ * @file gkc_packet_view_defs.hpp
+ * @brief Packet views
+ * Generated by tools/gkc_codegen.py from schema/gkc_packets.yaml. Do not edit.
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2026 [Triton AI]
+ *
+ */
+
+#ifndef TAI_GOKART_PACKET__GENERATED__GKC_PACKET_VIEW_DEFS_HPP_
+#define TAI_GOKART_PACKET__GENERATED__GKC_PACKET_VIEW_DEFS_HPP_
+
+#ifndef TAI_GOKART_PACKET__GKC_PACKET_VIEWS_HPP_
+#error "Include tai_gokart_packet/gkc_packet_views.hpp instead."
+#endif
+
+namespace tritonai
+{
+namespace gkc
+{
+class HeartbeatView : public GkcPacketView<HeartbeatGkcPacket>
+{
+public:
+  using GkcPacketView::GkcPacketView;
+  uint8_t rolling_counter() const {return load<uint8_t>(1);}
+  uint8_t state() const {return load<uint8_t>(2);}
+};
+
+class ControlView : public GkcPacketView<ControlGkcPacket>
+{
+public:
+  using GkcPacketView::GkcPacketView;
+  float throttle() const {return load<float>(1);}
+  float steering() const {return load<float>(5);}
+  float brake() const {return load<float>(9);}
+};
+
+class SensorView : public GkcPacketView<SensorGkcPacket>
+{
+public:
+  using GkcPacketView::GkcPacketView;
+  float wheel_speed_fl() const {return load<float>(1);}
+  float wheel_speed_fr() const {return load<float>(5);}
+  float wheel_speed_rl() const {return load<float>(9);}
+  float wheel_speed_rr() const {return load<float>(13);}
+  float voltage() const {return load<float>(17);}
+  float amperage() const {return load<float>(21);}
+  float brake_pressure() const {return load<float>(25);}
+  float throttle_pos() const {return load<float>(29);}
+  float steering_angle_rad() const {return load<float>(33);}
+  float servo_angle_rad() const {return load<float>(37);}
+  bool fault_brake() const {return load<bool>(41);}
+  bool fault_throttle() const {return load<bool>(42);}
+  bool fault_steering() const {return load<bool>(43);}
+  bool fault_fatal() const {return load<bool>(44);}
+  bool fault_error() const {return load<bool>(45);}
+  bool fault_warning() const {return load<bool>(46);}
+  bool fault_info() const {return load<bool>(47);}
+};
+
+template<>
+struct GkcPacketViewOf<HeartbeatGkcPacket>
+{
+  typedef HeartbeatView type;
+};
+template<>
+struct GkcPacketViewOf<ControlGkcPacket>
+{
+  typedef ControlView type;
+};
+template<>
+struct GkcPacketViewOf<SensorGkcPacket>
+{
+  typedef SensorView type;
+};
+}  // namespace gkc
+}  // namespace tritonai
+#endif  // TAI_GOKART_PACKET__GENERATED__GKC_PACKET_VIEW_DEFS_HPP_
@@ -0,0 +1,427 @@
+/**
+ * @file gkc_bulk_transfer.hpp
+ * @brief Windowed transfer of data longer than a frame
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2026 [Triton AI]
+ *
+ */
+
+#ifndef TAI_GOKART_PACKET__GKC_BULK_TRANSFER_HPP_
+#define TAI_GOKART_PACKET__GKC_BULK_TRANSFER_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include "tai_gokart_packet/gkc_crc.hpp"
+#include "tai_gokart_packet/gkc_packets.hpp"
+
+namespace tritonai
+{
+namespace gkc
+{
+/**
+ * @brief Sender side of a bulk transfer, with go-back-N retransmission.
+ *
+ * Up to `window` chunks are sent ahead of the cumulative acknowledgement, so that the link
+ * stays busy while acknowledgements travel back. When the receiver reports a gap, or after
+ * `timeout_ms` without progress, sending resumes from the first unacknowledged chunk.
+ *
+ * Usage: `start()`, then call `poll()` regularly and pass every `BulkAckGkcPacket` to
+ * `on_ack()`, until `state()` is `Complete` or `Failed`.
+ */
+class GkcBulkSender
+{
+public:
+  enum class State
+  {
+    Idle,
+    Sending,
+    Complete,  // the receiver has all the data and checked its CRC
+    Failed  // rejected by the receiver, bad CRC, or too many timeouts
+  };
+
+  struct Statistics
+  {
+    uint64_t chunks_sent = 0;  // retransmissions included
+    uint64_t retransmissions = 0;  // chunks sent again after a gap or a timeout
+    uint64_t timeouts = 0;
+  };
+
+  /**
+   * @param window chunks sent ahead of the acknowledgement, at most 255
+   * @param timeout_ms time without progress before going back to the first unacknowledged chunk
+   * @param max_timeouts timeouts in a row before the transfer fails
+   */
+  explicit GkcBulkSender(
+    const size_t & window = 16, const uint32_t & timeout_ms = 100,
+    const size_t & max_timeouts = 10)
+  : window_(std::min<size_t>(std::max<size_t>(window, 1), UINT8_MAX)),
+    timeout_ms_(timeout_ms), max_timeouts_(max_timeouts) {}
+
+  /**
+   * @brief Start sending `data`. It must stay valid and unchanged until the transfer ends.
+   *
+   * @param resource what the data is, defined by the application
+   * @param data bytes to send
+   * @param chunk_size bytes per chunk, at most `BulkChunkGkcPacket::MAX_DATA_SIZE`. Unless
+   * extended frames are agreed on, chunks must fit a standard frame (`MAX_STANDARD_CHUNK_SIZE`).
+   * @param now_ms current time in millisecond
+   * @return false if `chunk_size` is out of range or the data needs more than 65535 chunks
+   */
+  bool start(
+    const uint16_t & resource, const GkcBufferView & data, const size_t & chunk_size,
+    const uint32_t & now_ms)
+  {
+    if (!chunk_size || chunk_size > BulkChunkGkcPacket::MAX_DATA_SIZE) {
+      return false;
+    }
+    const size_t num_chunks = (data.size() + chunk_size - 1) / chunk_size;
+    if (num_chunks > UINT16_MAX) {
+      return false;
+    }
+    ++start_.transfer_id;
+    start_.resource = resource;
+    start_.total_size = static_cast<uint32_t>(data.size());
+    start_.chunk_size = static_cast<uint16_t>(chunk_size);
+    start_.window = static_cast<uint8_t>(window_);
+    start_.crc = GkcCrc32::compute(data.data(), data.size());
+    chunk_.transfer_id = start_.transfer_id;
+    data_ = data;
+    num_chunks_ = num_chunks;
+    base_ = next_ = sent_end_ = 0;
+    acknowledged_ = false;
+    send_start_ = true;
+    num_timeouts_ = 0;
+    last_progress_ms_ = now_ms;
+    stats_ = {};
+    state_ = State::Sending;
+    return true;
+  }
+
+  /**
+   * @brief Send as much as the window allows, after going back if the timeout expired
+   *
+   * @param now_ms current time in millisecond
+   * @param send called with every packet to send. Returns false if the link cannot take it
+   * right now, which ends the poll.
+   * @return size_t number of packets sent
+   */
+  template<typename Send>
+  size_t poll(const uint32_t & now_ms, Send && send)
+  {
+    if (state_ != State::Sending) {
+      return 0;
+    }
+    if (now_ms - last_progress_ms_ >= timeout_ms_) {
+      ++stats_.timeouts;
+      if (++num_timeouts_ > max_timeouts_) {
+        state_ = State::Failed;
+        return 0;
+      }
+      // The announcement may be what got lost
+      send_start_ = !acknowledged_;
+      next_ = base_;
+      last_progress_ms_ = now_ms;
+    }
+
+    size_t num_sent = 0;
+    if (send_start_) {
+      if (!send(start_)) {
+        return num_sent;
+      }
+      send_start_ = false;
+      ++num_sent;
+    }
+    const size_t end = std::min(num_chunks_, base_ + window_);
+    while (next_ < end) {
+      const size_t offset = next_ * start_.chunk_size;
+      chunk_.seq = static_cast<uint16_t>(next_);
+      const size_t size = std::min<size_t>(start_.chunk_size, data_.size() - offset);
+      chunk_.data.assign(data_.begin() + offset, data_.begin() + offset + size);
+      if (!send(chunk_)) {
+        break;
+      }
+      ++stats_.chunks_sent;
+      if (next_ < sent_end_) {
+        ++stats_.retransmissions;
+      }
+      sent_end_ = std::max(sent_end_, ++next_);
+      ++num_sent;
+    }
+    return num_sent;
+  }
+
+  /**
+   * @brief Handle an acknowledgement from the receiver
+   *
+   * @param ack the acknowledgement
+   * @param now_ms current time in millisecond
+   */
+  void on_ack(const BulkAckGkcPacket & ack, const uint32_t & now_ms)
+  {
+    if (state_ != State::Sending || ack.transfer_id != start_.transfer_id) {
+      return;
+    }
+    switch (ack.status) {
+      case BulkAckGkcPacket::COMPLETE:
+        state_ = State::Complete;
+        return;
+      case BulkAckGkcPacket::CRC_ERROR:
+      case BulkAckGkcPacket::REJECTED:
+        state_ = State::Failed;
+        return;
+      default:
+        break;
+    }
+    const bool progress = !acknowledged_ || (ack.next_seq > base_ && ack.next_seq <= sent_end_);
+    acknowledged_ = true;
+    send_start_ = false;
+    if (progress) {
+      base_ = std::max<size_t>(base_, ack.next_seq);
+      next_ = std::max(next_, base_);
+      num_timeouts_ = 0;
+      last_progress_ms_ = now_ms;
+    }
+    if (ack.status == BulkAckGkcPacket::GAP) {
+      // Every chunk after the gap was dropped
+      next_ = base_;
+    }
+  }
+
+  /**
+   * @brief Abandon the transfer, e.g. after a timeout of the application. The data is no
+   * longer used.
+   */
+  void reset() {state_ = State::Idle;}
+
+  State state() const {return state_;}
+  const BulkStartGkcPacket & transfer() const {return start_;}
+  // Chunks the receiver has acknowledged
+  size_t num_acknowledged() const {return base_;}
+  size_t num_chunks() const {return num_chunks_;}
+  const Statistics & get_statistics() const {return stats_;}
+
+  // Largest chunk that fits a standard frame
+  static constexpr size_t MAX_STANDARD_CHUNK_SIZE =
+    GkcFrameFormat::MAX_PAYLOAD_SIZE - BulkChunkGkcPacket::MIN_PAYLOAD_SIZE;
+
+private:
+  size_t window_;
+  uint32_t timeout_ms_;
+  size_t max_timeouts_;
+  State state_ = State::Idle;
+  BulkStartGkcPacket start_ {};
+  BulkChunkGkcPacket chunk_ {};
+  GkcBufferView data_ {};
+  size_t num_chunks_ = 0;
+  size_t base_ = 0;  // first unacknowledged chunk
+  size_t next_ = 0;  // next chunk to send
+  size_t sent_end_ = 0;  // every chunk before it was sent at least once
+  bool acknowledged_ = false;  // the receiver answered the announcement
+  bool send_start_ = false;
+  size_t num_timeouts_ = 0;
+  uint32_t last_progress_ms_ = 0;
+  Statistics stats_ {};
+};
+
+/**
+ * @brief Receiver side of a bulk transfer.
+ *
+ * Chunks are only accepted in order, and the CRC-32 is computed as they arrive. The receiver
+ * acknowledges four times per window, reports a gap once per missing chunk, and repeats
+ * its final status for as long as the sender keeps sending.
+ */
+class GkcBulkReceiver
+{
+public:
+  enum class State
+  {
+    Idle,
+    Receiving,
+    Complete,  // all data received, CRC checked
+    Failed  // rejected or bad CRC
+  };
+
+  struct Statistics
+  {
+    uint64_t chunks_received = 0;  // accepted in order
+    uint64_t chunks_dropped = 0;  // out of order, repeated or of the wrong size
+  };
+
+  /**
+   * @brief Whether `packet` announces a transfer other than the current one. Only then does
+   * `start()` use its destination; repeated announcements are just acknowledged again.
+   */
+  bool is_new(const BulkStartGkcPacket & packet) const
+  {
+    return state_ == State::Idle || packet.transfer_id != start_.transfer_id ||
+           packet.resource != start_.resource || packet.total_size != start_.total_size ||
+           packet.chunk_size != start_.chunk_size || packet.crc != start_.crc;
+  }
+
+  /**
+   * @brief Handle the announcement of a transfer
+   *
+   * @param packet the announcement
+   * @param destination where the data goes, at least `packet.total_size` bytes.
+   * It must stay valid until the transfer ends. A smaller one rejects the transfer.
+   * @param send called with the acknowledgement to send
+   * @return State state after the announcement
+   */
+  template<typename Send>
+  State start(
+    const BulkStartGkcPacket & packet, const GkcMutableBufferView & destination, Send && send)
+  {
+    if (is_new(packet)) {
+      start_ = packet;
+      destination_ = destination;
+      num_chunks_ = packet.chunk_size ?
+        (packet.total_size + packet.chunk_size - 1) / packet.chunk_size : 0;
+      expected_ = acknowledged_ = 0;
+      gap_reported_ = false;
+      has_duplicate_ = false;
+      crc_.init();
+      ack_interval_ = std::max<size_t>(packet.window / 4, 1);
+      stats_ = {};
+      state_ = State::Receiving;
+      if (destination.size() < packet.total_size || (packet.total_size && !packet.chunk_size) ||
+        num_chunks_ > UINT16_MAX)
+      {
+        fail(BulkAckGkcPacket::REJECTED);
+      } else if (num_chunks_ == 0) {
+        finish();
+      }
+    }
+    acknowledge(send);
+    return state_;
+  }
+
+  /**
+   * @brief Handle a chunk
+   *
+   * @param chunk the chunk
+   * @param send called with the acknowledgement to send, if any
+   * @return State state after the chunk
+   */
+  template<typename Send>
+  State receive(const BulkChunkGkcPacket & chunk, Send && send)
+  {
+    if (state_ == State::Idle || chunk.transfer_id != start_.transfer_id) {
+      return state_;
+    }
+    if (state_ != State::Receiving) {
+      // The sender missed the final status
+      acknowledge(send);
+      return state_;
+    }
+
+    const size_t offset = expected_ * start_.chunk_size;
+    if (chunk.seq != expected_ ||
+      chunk.data.size() != std::min<size_t>(start_.chunk_size, start_.total_size - offset))
+    {
+      ++stats_.chunks_dropped;
+      if (chunk.seq > expected_ && !gap_reported_) {
+        gap_reported_ = true;
+        acknowledge(send, BulkAckGkcPacket::GAP);
+      } else if (chunk.seq < expected_) {
+        // The sender went back because acknowledgements were lost. Tell it once per round.
+        if (!has_duplicate_ || chunk.seq <= last_duplicate_) {
+          acknowledge(send);
+        }
+        has_duplicate_ = true;
+        last_duplicate_ = chunk.seq;
+      }
+      return state_;
+    }
+
+    std::copy(chunk.data.begin(), chunk.data.end(), destination_.begin() + offset);
+    crc_.update(chunk.data.data(), chunk.data.size());
+    ++expected_;
+    ++stats_.chunks_received;
+    gap_reported_ = false;
+    has_duplicate_ = false;
+    if (expected_ == num_chunks_) {
+      finish();
+      acknowledge(send);
+    } else if (expected_ - acknowledged_ >= ack_interval_) {
+      acknowledge(send);
+    }
+    return state_;
+  }
+
+  /**
+   * @brief Abandon the transfer. The destination is no longer written, and chunks are ignored
+   * until the next announcement.
+   */
+  void reset() {state_ = State::Idle;}
+
+  State state() const {return state_;}
+  const BulkStartGkcPacket & transfer() const {return start_;}
+  // Bytes received so far, in order
+  size_t received_size() const
+  {
+    return std::min<size_t>(expected_ * start_.chunk_size, start_.total_size);
+  }
+  const Statistics & get_statistics() const {return stats_;}
+
+private:
+  void finish()
+  {
+    if (crc_.finalize() == start_.crc) {
+      state_ = State::Complete;
+    } else {
+      fail(BulkAckGkcPacket::CRC_ERROR);
+    }
+  }
+
+  void fail(const BulkAckGkcPacket::Status & status)
+  {
+    state_ = State::Failed;
+    failure_ = status;
+  }
+
+  template<typename Send>
+  void acknowledge(Send && send, const BulkAckGkcPacket::Status & status)
+  {
+    ack_.transfer_id = start_.transfer_id;
+    ack_.next_seq = static_cast<uint16_t>(expected_);
+    ack_.status = status;
+    acknowledged_ = expected_;
+    send(ack_);
+  }
+
+  template<typename Send>
+  void acknowledge(Send && send)
+  {
+    switch (state_) {
+      case State::Complete:
+        acknowledge(send, BulkAckGkcPacket::COMPLETE);
+        break;
+      case State::Failed:
+        acknowledge(send, failure_);
+        break;
+      default:
+        acknowledge(send, BulkAckGkcPacket::IN_PROGRESS);
+    }
+  }
+
+  State state_ = State::Idle;
+  BulkStartGkcPacket start_ {};
+  BulkAckGkcPacket ack_ {};
+  BulkAckGkcPacket::Status failure_ = BulkAckGkcPacket::REJECTED;
+  GkcMutableBufferView destination_ {};
+  size_t num_chunks_ = 0;
+  size_t expected_ = 0;  // next chunk in order
+  size_t acknowledged_ = 0;  // `expected_` as of the last acknowledgement
+  size_t ack_interval_ = 1;
+  bool gap_reported_ = false;
+  bool has_duplicate_ = false;  // since the last chunk in order
+  size_t last_duplicate_ = 0;
+  GkcCrc32 crc_ {};
+  Statistics stats_ {};
+};
+}  // namespace gkc
+}  // namespace tritonai
+#endif  // TAI_GOKART_PACKET__GKC_BULK_TRANSFER_HPP_
@@ -0,0 +1,98 @@
+/**
+ * @file gkc_cobs.hpp
+ * @brief Consistent Overhead Byte Stuffing
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2026 [Triton AI]
+ *
+ */
+
+#ifndef TAI_GOKART_PACKET__GKC_COBS_HPP_
+#define TAI_GOKART_PACKET__GKC_COBS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace tritonai
+{
+namespace gkc
+{
+/**
+ * @brief COBS (Cheshire and Baker, 1999) removes every 0x00 from a block of bytes,
+ * so that 0x00 can delimit frames.
+ */
+class GkcCobs
+{
+public:
+  static constexpr uint8_t DELIMITER = 0x00;
+
+  /**
+   * @brief worst-case encoded size of `size` bytes, excluding the delimiter
+   */
+  static constexpr size_t max_encoded_size(const size_t & size) {return size + size / 254 + 1;}
+
+  /**
+   * @brief Encode `size` bytes
+   *
+   * @param src bytes to encode
+   * @param size number of bytes to encode
+   * @param dst destination of at least `max_encoded_size(size)` bytes. It may only overlap
+   * `src` if `src` is the last `size` of these bytes: the output never overtakes the input.
+   * @return size_t number of bytes written, excluding the delimiter
+   */
+  static size_t encode(const uint8_t * src, const size_t & size, uint8_t * dst)
+  {
+    size_t code_idx = 0;
+    size_t dst_idx = 1;
+    uint8_t code = 1;
+    for (size_t i = 0; i < size; ++i) {
+      if (src[i] == DELIMITER) {
+        dst[code_idx] = code;
+        code_idx = dst_idx++;
+        code = 1;
+        continue;
+      }
+      dst[dst_idx++] = src[i];
+      // A full block only opens another one if more bytes follow
+      if (++code == 0xFF && i + 1 < size) {
+        dst[code_idx] = code;
+        code_idx = dst_idx++;
+        code = 1;
+      }
+    }
+    dst[code_idx] = code;
+    return dst_idx;
+  }
+
+  /**
+   * @brief Decode an encoded block (delimiter not included)
+   *
+   * @tparam Source anything indexable by `size_t` that yields bytes, e.g. a pointer
+   * @param src encoded bytes
+   * @param size number of encoded bytes
+   * @param dst destination of at least `size` bytes
+   * @return size_t number of bytes decoded; 0 if the block is not valid COBS
+   */
+  template<typename Source>
+  static size_t decode(const Source & src, const size_t & size, uint8_t * dst)
+  {
+    size_t src_idx = 0;
+    size_t dst_idx = 0;
+    while (src_idx < size) {
+      const uint8_t code = src[src_idx++];
+      if (code == DELIMITER || src_idx + code - 1 > size) {
+        return 0;
+      }
+      for (uint8_t i = 1; i < code; ++i) {
+        dst[dst_idx++] = src[src_idx++];
+      }
+      if (code != 0xFF && src_idx != size) {
+        dst[dst_idx++] = DELIMITER;
+      }
+    }
+    return dst_idx;
+  }
+};
+}  // namespace gkc
+}  // namespace tritonai
+#endif  // TAI_GOKART_PACKET__GKC_COBS_HPP_
@@ -0,0 +1,169 @@
+/**
+ * @file gkc_crc.hpp
+ * @brief CRC-16 checksum of packet payloads, CRC-32 of bulk transfers
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2026 [Triton AI]
+ *
+ */
+
+#ifndef TAI_GOKART_PACKET__GKC_CRC_HPP_
+#define TAI_GOKART_PACKET__GKC_CRC_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace tritonai
+{
+namespace gkc
+{
+typedef std::array<std::array<uint16_t, 256>, 8> GkcCrc16Tables;
+
+/**
+ * @brief TABLES[k][b] is the CRC-16/XMODEM checksum of byte `b` followed by `k` zero bytes
+ */
+constexpr GkcCrc16Tables make_crc16_tables(const uint16_t & polynomial)
+{
+  GkcCrc16Tables tables {};
+  for (uint32_t b = 0; b < 256; ++b) {
+    uint16_t crc = static_cast<uint16_t>(b << 8);
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ polynomial) :
+        static_cast<uint16_t>(crc << 1);
+    }
+    tables[0][b] = crc;
+  }
+  for (size_t k = 1; k < 8; ++k) {
+    for (size_t b = 0; b < 256; ++b) {
+      const uint16_t prev = tables[k - 1][b];
+      tables[k][b] = tables[0][prev >> 8] ^ static_cast<uint16_t>(prev << 8);
+    }
+  }
+  return tables;
+}
+
+inline constexpr GkcCrc16Tables GKC_CRC16_TABLES = make_crc16_tables(0x1021);
+
+/**
+ * @brief CRC-16/XMODEM (polynomial 0x1021, initial value 0, no reflection),
+ * bit-compatible with the VESC checksum (https://github.com/vedderb/bldc/blob/master/crc.c).
+ *
+ * Incremental usage: `init()`, `update()` any number of times, then `finalize()`.
+ * Inputs of `SLICE_MIN_SIZE` bytes or more are processed 8 bytes at a time (slicing-by-8).
+ */
+class GkcCrc16
+{
+public:
+  static constexpr size_t SLICE_MIN_SIZE = 16;
+
+  void init() {crc_ = 0;}
+
+  /**
+   * @brief Feed more bytes into the checksum
+   *
+   * @param data start of the bytes
+   * @param size number of bytes
+   */
+  void update(const uint8_t * data, const size_t & size)
+  {
+    crc_ = size < SLICE_MIN_SIZE ? update_bytewise(crc_, data, size) :
+      update_sliced(crc_, data, size);
+  }
+
+  uint16_t finalize() const {return crc_;}
+
+  /**
+   * @brief Checksum of a contiguous range in one call
+   */
+  static uint16_t compute(const uint8_t * data, const size_t & size)
+  {
+    auto crc = GkcCrc16();
+    crc.update(data, size);
+    return crc.finalize();
+  }
+
+  /**
+   * @brief One table lookup per byte
+   */
+  static uint16_t update_bytewise(uint16_t crc, const uint8_t * data, const size_t & size)
+  {
+    for (size_t i = 0; i < size; ++i) {
+      crc = TABLES[0][(crc >> 8) ^ data[i]] ^ static_cast<uint16_t>(crc << 8);
+    }
+    return crc;
+  }
+
+  /**
+   * @brief Eight independent table lookups per 8 bytes, bytewise for the remainder
+   */
+  static uint16_t update_sliced(uint16_t crc, const uint8_t * data, const size_t & size)
+  {
+    const uint8_t * const end = data + (size & ~static_cast<size_t>(7));
+    for (; data != end; data += 8) {
+      crc = TABLES[7][data[0] ^ (crc >> 8)] ^ TABLES[6][data[1] ^ (crc & 0xFF)] ^
+        TABLES[5][data[2]] ^ TABLES[4][data[3]] ^ TABLES[3][data[4]] ^
+        TABLES[2][data[5]] ^ TABLES[1][data[6]] ^ TABLES[0][data[7]];
+    }
+    return update_bytewise(crc, data, size & 7);
+  }
+
+private:
+  static constexpr const GkcCrc16Tables & TABLES = GKC_CRC16_TABLES;
+
+  uint16_t crc_ = 0;
+};
+
+typedef std::array<uint32_t, 256> GkcCrc32Table;
+
+/**
+ * @brief TABLE[b] is the reflected CRC-32 remainder of byte `b`
+ */
+constexpr GkcCrc32Table make_crc32_table(const uint32_t & reflected_polynomial)
+{
+  GkcCrc32Table table {};
+  for (uint32_t b = 0; b < 256; ++b) {
+    uint32_t crc = b;
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc & 1) ? (crc >> 1) ^ reflected_polynomial : crc >> 1;
+    }
+    table[b] = crc;
+  }
+  return table;
+}
+
+inline constexpr GkcCrc32Table GKC_CRC32_TABLE = make_crc32_table(0xEDB88320);
+
+/**
+ * @brief CRC-32/ISO-HDLC, as in zlib and Ethernet. Checks the data of a whole bulk transfer,
+ * which is too long for the frame checksum to cover.
+ *
+ * Incremental usage: `init()`, `update()` any number of times, then `finalize()`.
+ */
+class GkcCrc32
+{
+public:
+  void init() {crc_ = 0xFFFFFFFF;}
+
+  void update(const uint8_t * data, const size_t & size)
+  {
+    for (size_t i = 0; i < size; ++i) {
+      crc_ = GKC_CRC32_TABLE[(crc_ ^ data[i]) & 0xFF] ^ (crc_ >> 8);
+    }
+  }
+
+  uint32_t finalize() const {return ~crc_;}
+
+  static uint32_t compute(const uint8_t * data, const size_t & size)
+  {
+    auto crc = GkcCrc32();
+    crc.update(data, size);
+    return crc.finalize();
+  }
+
+private:
+  uint32_t crc_ = 0xFFFFFFFF;
+};
+}  // namespace gkc
+}  // namespace tritonai
+#endif  // TAI_GOKART_PACKET__GKC_CRC_HPP_
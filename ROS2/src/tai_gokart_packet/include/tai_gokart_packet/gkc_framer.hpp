@@ -0,0 +1,132 @@
+/**
+ * @file gkc_framer.hpp
+ * @brief Find and validate frames in an incoming byte stream
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2026 [Triton AI]
+ *
+ */
+
+#ifndef TAI_GOKART_PACKET__GKC_FRAMER_HPP_
+#define TAI_GOKART_PACKET__GKC_FRAMER_HPP_
+
+#include <array>
+#include <atomic>
+
+#include "tai_gokart_packet/gkc_packets.hpp"
+#include "tai_gokart_packet/gkc_ring_buffer.hpp"
+
+namespace tritonai
+{
+namespace gkc
+{
+/**
+ * @brief Buffers an incoming byte stream and extracts validated payloads.
+ *
+ * Usage: `push()` the received bytes, then call `next()` until it returns false.
+ * Every instance owns its buffer, so several framers can run side by side.
+ *
+ * Legacy framing: a candidate frame that is malformed or fails the checksum only costs its
+ * start byte. Parsing resumes from the next start byte, which may begin a valid frame inside
+ * the rejected one.
+ *
+ * COBS framing: frames end at the next delimiter, so a bad frame costs exactly its own bytes.
+ *
+ * Extended frames are only accepted once enabled, so that a stray 0x03 of a legacy stream
+ * is not taken for the start of a long frame.
+ */
+class GkcFramer
+{
+public:
+  static constexpr size_t CAPACITY = 4096;
+  static_assert(
+    CAPACITY >= GkcFrameFormat::MAX_EXTENDED_FRAME_SIZE, "The buffer must hold any frame.");
+
+  struct Statistics
+  {
+    uint64_t resyncs = 0;  // candidate frames rejected, parsing resumed from the next start byte
+    uint64_t bytes_discarded = 0;  // bytes skipped that were not part of a valid frame
+    uint64_t malformed = 0;  // candidates with a bad end byte or payload size
+    uint64_t checksum_errors = 0;  // candidates failing the checksum
+  };
+
+  explicit GkcFramer(GkcDebugCallback debug);
+
+  /**
+   * @brief Buffer incoming bytes
+   *
+   * @param data received bytes
+   * @param size number of received bytes
+   * @return size_t number of bytes buffered. If less than `size`, parse with `next()`
+   * to free up space and push the rest.
+   */
+  size_t push(const uint8_t * data, const size_t & size);
+
+  /**
+   * @brief Extract the next valid frame from the buffer
+   *
+   * @param payload set to the payload of the frame. It stays valid until the next call
+   * to `next()` or `push()`.
+   * @return true if a frame is found; false if more bytes are needed
+   */
+  bool next(GkcBufferView & payload);
+
+  /**
+   * @brief number of bytes buffered but not yet parsed
+   */
+  size_t buffered() const {return ring_.size();}
+
+  void reset() {ring_.clear();}
+
+  /**
+   * @brief Change how the following bytes are delimited. Buffered bytes are kept.
+   * May be called from another thread than the one receiving.
+   */
+  void set_framing(const GkcFraming & framing)
+  {
+    framing_.store(framing, std::memory_order_relaxed);
+  }
+  GkcFraming get_framing() const {return framing_.load(std::memory_order_relaxed);}
+
+  /**
+   * @brief Accept payloads up to `GkcFrameFormat::MAX_EXTENDED_PAYLOAD_SIZE`, as agreed on
+   * with `GkcCapabilities::EXTENDED_FRAMES`. Buffered bytes are kept.
+   */
+  void set_extended_frames(const bool & enabled)
+  {
+    extended_frames_.store(enabled, std::memory_order_relaxed);
+  }
+  bool get_extended_frames() const {return extended_frames_.load(std::memory_order_relaxed);}
+
+  const Statistics & get_statistics() const {return stats_;}
+
+private:
+  bool next_legacy(GkcBufferView & payload);
+  bool next_cobs(GkcBufferView & payload);
+
+  /**
+   * @brief Give up on the candidate frame at the front of the buffer
+   */
+  void resync();
+
+  /**
+   * @brief Give up on the first `size` bytes of the buffer
+   */
+  void discard(const size_t & size);
+
+  GkcDebugCallback debug_;
+  GkcRingBuffer<CAPACITY> ring_ {};
+  Statistics stats_ {};
+  // switched by the handshake while other threads encode with `get_framing()`
+  std::atomic<GkcFraming> framing_ {GkcFraming::Legacy};
+  std::atomic<bool> extended_frames_ {false};
+  // holds a payload that wraps around the end of the ring, or a decoded COBS frame
+  std::array<uint8_t, GkcFrameFormat::MAX_EXTENDED_FRAME_SIZE> scratch_ {};
+};
+}  // namespace gkc
+}  // namespace tritonai
+
+#ifdef GKC_PACKET_HEADER_ONLY
+#include "tai_gokart_packet/impl/gkc_framer.ipp"
+#endif
+#endif  // TAI_GOKART_PACKET__GKC_FRAMER_HPP_
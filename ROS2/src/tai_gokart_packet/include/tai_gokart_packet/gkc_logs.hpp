@@ -0,0 +1,184 @@
+/**
+ * @file gkc_logs.hpp
+ * @brief Logs sent by ID, and the table to expand them
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2026 [Triton AI]
+ *
+ */
+
+#ifndef TAI_GOKART_PACKET__GKC_LOGS_HPP_
+#define TAI_GOKART_PACKET__GKC_LOGS_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#ifndef GKC_PACKET_MCU_PROFILE
+#include <string>
+#endif
+
+#include "tai_gokart_packet/gkc_packets.hpp"
+
+namespace tritonai
+{
+namespace gkc
+{
+/**
+ * @brief Type of a log argument on the wire
+ */
+enum class GkcLogArg : uint8_t
+{
+  UInt8,
+  UInt16,
+  UInt32,
+  Int8,
+  Int16,
+  Int32,
+  Float,
+  Bool
+};
+}  // namespace gkc
+}  // namespace tritonai
+
+// `GkcLogId`, `GKC_LOG_FORMATS` and the `GkcLogs` builders, generated from the `logs` of
+// schema/gkc_packets.yaml
+#include "tai_gokart_packet/generated/gkc_log_defs.hpp"
+
+namespace tritonai
+{
+namespace gkc
+{
+/**
+ * @brief Lookup and expansion of `LogIdGkcPacket` with `GKC_LOG_FORMATS`.
+ *
+ * The MCU sends `GkcLogs::brake_fault(pressure)` in 11 bytes; the PC expands it to the
+ * `LogPacket` "Brake fault at 2100.0 psi.".
+ */
+class GkcLogTable
+{
+public:
+  /**
+   * @brief Look up the format of a log
+   *
+   * @param id ID of the log
+   * @return const GkcLogFormat* nullptr if the ID is not in the table, e.g. a log of a newer
+   * firmware
+   */
+  static const GkcLogFormat * find(const uint16_t & id)
+  {
+    const auto end = GKC_LOG_FORMATS + GKC_NUM_LOG_FORMATS;
+    const auto it = std::lower_bound(
+      GKC_LOG_FORMATS, end, id, [](const GkcLogFormat & format, const uint16_t & value) {
+        return static_cast<uint16_t>(format.id) < value;
+      });
+    return it != end && static_cast<uint16_t>(it->id) == id ? it : nullptr;
+  }
+
+#ifndef GKC_PACKET_MCU_PROFILE
+  /**
+   * @brief Expand a log into the text of its format. An unknown ID, or missing arguments,
+   * are shown as such in the text instead of being dropped.
+   *
+   * @param packet the log
+   * @return LogPacket the log as text, with the same level
+   */
+  static LogPacket expand(const LogIdGkcPacket & packet);
+
+private:
+  static bool format_arg(
+    const GkcLogArg & type, const std::string & conversion,
+    const LogIdGkcPacket::Bytes & args, size_t & offset, std::string & text);
+
+  template<typename T>
+  static bool read_arg(const LogIdGkcPacket::Bytes & args, size_t & offset, T & value)
+  {
+    if (offset + sizeof(T) > args.size()) {
+      return false;
+    }
+    GkcPacketUtils::read_from_buffer(args.data() + offset, value);
+    offset += sizeof(T);
+    return true;
+  }
+
+  template<typename T>
+  static bool read_integer(
+    const LogIdGkcPacket::Bytes & args, size_t & offset,
+    long long & value)  // NOLINT(runtime/int): printed with the "ll" length modifier
+  {
+    T integer;
+    if (!read_arg(args, offset, integer)) {
+      return false;
+    }
+    value = integer;
+    return true;
+  }
+#endif
+};
+
+/**
+ * @brief MCU side of `LogFilterGkcPacket`: whether to send a log.
+ *
+ * Logs below the minimum level are dropped. At most `max_logs_per_second` logs are sent per
+ * second, counted from the first one, except for fatal logs. The logs dropped over the limit
+ * are counted, e.g. for `GkcLogs::logs_suppressed()`.
+ */
+class GkcLogFilter
+{
+public:
+  void configure(const LogFilterGkcPacket & packet)
+  {
+    min_level_ = packet.min_level;
+    max_logs_per_second_ = packet.max_logs_per_second;
+    num_sent_ = 0;
+  }
+
+  /**
+   * @brief Whether to send a log, counting it if so
+   *
+   * @param level level of the log, e.g. `LogIdGkcPacket::Severity`
+   * @param now_ms current time in millisecond
+   */
+  template<typename Severity>
+  bool allow(const Severity & level, const uint32_t & now_ms)
+  {
+    const auto value = static_cast<uint8_t>(level);
+    if (value < static_cast<uint8_t>(min_level_)) {
+      return false;
+    }
+    if (value >= static_cast<uint8_t>(LogFilterGkcPacket::FATAL) || !max_logs_per_second_) {
+      return true;
+    }
+    if (!num_sent_ || now_ms - window_start_ms_ >= 1000) {
+      window_start_ms_ = now_ms;
+      num_sent_ = 0;
+    }
+    if (num_sent_ >= max_logs_per_second_) {
+      ++num_suppressed_;
+      return false;
+    }
+    ++num_sent_;
+    return true;
+  }
+
+  // Logs dropped over the limit since the last call
+  uint32_t take_num_suppressed()
+  {
+    const auto num_suppressed = num_suppressed_;
+    num_suppressed_ = 0;
+    return num_suppressed;
+  }
+
+private:
+  LogFilterGkcPacket::Severity min_level_ = LogFilterGkcPacket::INFO;
+  uint16_t max_logs_per_second_ = 0;
+  uint32_t window_start_ms_ = 0;
+  uint16_t num_sent_ = 0;  // in the window
+  uint32_t num_suppressed_ = 0;
+};
+}  // namespace gkc
+}  // namespace tritonai
+
+#ifdef GKC_PACKET_HEADER_ONLY
+#include "tai_gokart_packet/impl/gkc_logs.ipp"
+#endif
+#endif  // TAI_GOKART_PACKET__GKC_LOGS_HPP_
@@ -0,0 +1,41 @@
+/**
+ * @file gkc_packet_config.hpp
+ * @brief Build profiles of the packet library
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2026 [Triton AI]
+ *
+ */
+
+#ifndef TAI_GOKART_PACKET__GKC_PACKET_CONFIG_HPP_
+#define TAI_GOKART_PACKET__GKC_PACKET_CONFIG_HPP_
+
+/*
+GKC_PACKET_MCU_PROFILE
+  For the firmware. Only fixed-capacity buffers and static storage: no heap, no exceptions,
+  no RTTI, no iostream. APIs built on std::vector, std::shared_ptr and std::string
+  (RawGkcPacket, GkcPacket::encode(), GkcPacketFactory::Send() returning a buffer) are
+  compiled out. Implies GKC_PACKET_HEADER_ONLY.
+
+GKC_PACKET_HEADER_ONLY
+  Include the implementation from the headers instead of linking the library.
+
+GKC_PACKET_MAX_EXTENDED_PAYLOAD_SIZE
+  Largest payload of an extended frame (default 1024 bytes, at most 65535). Every framer
+  keeps a scratch buffer of one extended frame, so firmware short on RAM may lower it.
+*/
+#if defined(GKC_PACKET_MCU_PROFILE) && !defined(GKC_PACKET_HEADER_ONLY)
+#define GKC_PACKET_HEADER_ONLY
+#endif
+
+#ifndef GKC_PACKET_MAX_EXTENDED_PAYLOAD_SIZE
+#define GKC_PACKET_MAX_EXTENDED_PAYLOAD_SIZE 1024
+#endif
+
+#ifdef GKC_PACKET_HEADER_ONLY
+#define GKC_PACKET_INLINE inline
+#else
+#define GKC_PACKET_INLINE
+#endif
+
+#endif  // TAI_GOKART_PACKET__GKC_PACKET_CONFIG_HPP_
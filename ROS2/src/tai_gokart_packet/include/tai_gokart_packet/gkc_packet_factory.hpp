@@ -12,11 +12,15 @@
 #ifndef TAI_GOKART_PACKET__GKC_PACKET_FACTORY_HPP_
 #define TAI_GOKART_PACKET__GKC_PACKET_FACTORY_HPP_
 
+#ifndef GKC_PACKET_MCU_PROFILE
 #include <iostream>
 #include <memory>
-#include <unordered_map>
 #include <string>
 #include <vector>
+#endif
+#include "tai_gokart_packet/gkc_framer.hpp"
+#include "tai_gokart_packet/gkc_packet_pool.hpp"
+#include "tai_gokart_packet/gkc_packet_views.hpp"
 #include "tai_gokart_packet/gkc_packets.hpp"
 
 namespace tritonai
@@ -26,48 +30,86 @@ namespace gkc
 class GkcPacketFactory
 {
 public:
-  GkcPacketFactory(GkcPacketSubscriber * sub, void(*debug)(std::string));
+  // packets of each type that can be held at the same time
+  static constexpr size_t POOL_SIZE = 2;
+  typedef GkcPacketPools<POOL_SIZE, GkcPacketTypes> PacketPools;
 
-  void Receive(const GkcBuffer & buffer);
-  std::shared_ptr<GkcBuffer> Send(const GkcPacket::SharedPtr & packet);
-  std::shared_ptr<GkcBuffer> Send(const GkcPacket & packet);
+  GkcPacketFactory(GkcPacketSubscriber * sub, GkcDebugCallback debug);
 
-private:
-  typedef GkcPacket::SharedPtr (* Creator)();
-  const std::unordered_map<uint8_t, Creator> fb_lookup = {
-    {Handshake1GkcPacket::FIRST_BYTE,
-      GkcPacketUtils::CreatePacket<Handshake1GkcPacket>},
-    {Handshake2GkcPacket::FIRST_BYTE,
-      GkcPacketUtils::CreatePacket<Handshake2GkcPacket>},
-    {GetFirmwareVersionGkcPacket::FIRST_BYTE,
-      GkcPacketUtils::CreatePacket<GetFirmwareVersionGkcPacket>},
-    {FirmwareVersionGkcPacket::FIRST_BYTE,
-      GkcPacketUtils::CreatePacket<FirmwareVersionGkcPacket>},
-    {ResetMcuGkcPacket::FIRST_BYTE,
-      GkcPacketUtils::CreatePacket<ResetMcuGkcPacket>},
-    {HeartbeatGkcPacket::FIRST_BYTE,
-      GkcPacketUtils::CreatePacket<HeartbeatGkcPacket>},
-    {ConfigGkcPacket::FIRST_BYTE,
-      GkcPacketUtils::CreatePacket<ConfigGkcPacket>},
-    {StateTransitionGkcPacket::FIRST_BYTE,
-      GkcPacketUtils::CreatePacket<StateTransitionGkcPacket>},
-    {ControlGkcPacket::FIRST_BYTE,
-      GkcPacketUtils::CreatePacket<ControlGkcPacket>},
-    {SensorGkcPacket::FIRST_BYTE,
-      GkcPacketUtils::CreatePacket<SensorGkcPacket>},
-    {Shutdown1GkcPacket::FIRST_BYTE,
-      GkcPacketUtils::CreatePacket<Shutdown1GkcPacket>},
-    {Shutdown2GkcPacket::FIRST_BYTE,
-      GkcPacketUtils::CreatePacket<Shutdown2GkcPacket>},
-    {LogPacket::FIRST_BYTE,
-      GkcPacketUtils::CreatePacket<LogPacket>},
+  /**
+   * @brief Parse received bytes and publish every complete packet to the subscriber.
+   * Incomplete packets are kept until the rest of their bytes arrive.
+   *
+   * @param buffer received bytes
+   */
+  void Receive(const GkcBufferView & buffer);
+#ifndef GKC_PACKET_MCU_PROFILE
+  /**
+   * @brief Encode a packet into a new buffer, in an extended frame if it needs one
+   *
+   * @throws std::length_error if the packet does not fit an extended frame either
+   */
+  std::shared_ptr<std::vector<uint8_t>> Send(const GkcPacket::SharedPtr & packet);
+  std::shared_ptr<std::vector<uint8_t>> Send(const GkcPacket & packet);
+#endif
+
+  /**
+   * @brief Encode a packet into a caller-provided buffer without heap allocation
+   *
+   * @param packet packet to encode
+   * @param buffer destination, e.g. a stack buffer of `GkcFrameFormat::MAX_FRAME_SIZE` bytes
+   * @return size_t size of the encoded frame; 0 if `buffer` is too small
+   */
+  size_t Send(const GkcPacket & packet, const GkcMutableBufferView & buffer);
+
+  /**
+   * @brief Select how frames are delimited in both directions, usually as agreed on in the
+   * handshake (see `GkcCapabilities`). Defaults to `GkcFraming::Legacy`.
+   * Safe to call from a subscriber callback: the rest of the received bytes use the new framing.
+   * Safe to call while other threads `Send()`: each frame is encoded in one framing.
+   */
+  void set_framing(const GkcFraming & framing) {_framer.set_framing(framing);}
+  GkcFraming get_framing() const {return _framer.get_framing();}
+
+  /**
+   * @brief Receive extended frames, as agreed on with `GkcCapabilities::EXTENDED_FRAMES`.
+   * Packets longer than `GkcFrameFormat::MAX_PAYLOAD_SIZE` are always sent in them.
+   */
+  void set_extended_frames(const bool & enabled) {_framer.set_extended_frames(enabled);}
+  bool get_extended_frames() const {return _framer.get_extended_frames();}
+
+  struct Statistics
+  {
+    uint64_t packets_received = 0;  // valid frames published to the subscriber
+    uint64_t unknown_first_byte = 0;  // valid frames dropped for an unknown first byte
+    uint64_t undersized_payload = 0;  // valid frames dropped for being too short to decode
   };
 
-  void (* _debug)(std::string);
-  GkcBuffer _buffer = GkcBuffer();
+  const Statistics & get_statistics() const {return _stats;}
+
+  /**
+   * @brief Resyncs and discarded bytes of the receive stream
+   */
+  const GkcFramer::Statistics & get_framer_statistics() const {return _framer.get_statistics();}
+
+  /**
+   * @brief Packets that received frames are decoded into. Steady-state receiving
+   * reuses them instead of allocating.
+   */
+  PacketPools & get_pools() {return _pools;}
+
+private:
+  GkcDebugCallback _debug;
+  GkcFramer _framer;
   GkcPacketSubscriber * _sub;
+  Statistics _stats {};
+  PacketPools _pools {};
 };
 
 }  // namespace gkc
 }  // namespace tritonai
+
+#ifdef GKC_PACKET_HEADER_ONLY
+#include "tai_gokart_packet/impl/gkc_packet_factory.ipp"
+#endif
 #endif  // TAI_GOKART_PACKET__GKC_PACKET_FACTORY_HPP_
@@ -0,0 +1,109 @@
+/**
+ * @file gkc_packet_pool.hpp
+ * @brief Fixed-size pools of reusable packet objects
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2026 [Triton AI]
+ *
+ */
+
+#ifndef TAI_GOKART_PACKET__GKC_PACKET_POOL_HPP_
+#define TAI_GOKART_PACKET__GKC_PACKET_POOL_HPP_
+
+#include <array>
+#include <memory>
+#include <tuple>
+
+#include "tai_gokart_packet/gkc_packets.hpp"
+
+namespace tritonai
+{
+namespace gkc
+{
+/**
+ * @brief `N` preallocated packets of type `T` handed out as recycled handles.
+ *
+ * A handle returns its packet to the pool when destroyed. The packet is not reset,
+ * so members such as `LogPacket::what` keep their capacity for the next frame.
+ * The pool must outlive its handles.
+ *
+ * @tparam T packet type
+ * @tparam N number of packets
+ */
+template<typename T, size_t N>
+class GkcPacketPool
+{
+public:
+  class Recycler
+  {
+public:
+    Recycler() = default;
+    explicit Recycler(GkcPacketPool * pool)
+    : pool_(pool) {}
+    void operator()(T * packet) const {pool_->release(packet);}
+
+private:
+    GkcPacketPool * pool_ = nullptr;
+  };
+  typedef std::unique_ptr<T, Recycler> Handle;
+
+  GkcPacketPool()
+  {
+    for (size_t i = 0; i < N; ++i) {
+      free_[i] = &slots_[i];
+    }
+  }
+  GkcPacketPool(const GkcPacketPool &) = delete;
+  GkcPacketPool & operator=(const GkcPacketPool &) = delete;
+
+  /**
+   * @brief Take a packet out of the pool
+   *
+   * @return Handle the packet; empty if every packet is in use
+   */
+  Handle acquire()
+  {
+    if (!num_free_) {
+      return Handle(nullptr, Recycler(this));
+    }
+    return Handle(free_[--num_free_], Recycler(this));
+  }
+
+  /**
+   * @brief number of packets not in use
+   */
+  size_t available() const {return num_free_;}
+
+private:
+  void release(T * packet) {free_[num_free_++] = packet;}
+
+  std::array<T, N> slots_ {};
+  std::array<T *, N> free_ {};
+  size_t num_free_ = N;
+};
+
+template<size_t N, typename List>
+class GkcPacketPools;
+
+/**
+ * @brief One `GkcPacketPool` per packet type in a `GkcPacketTypeList`
+ */
+template<size_t N, typename ... Ts>
+class GkcPacketPools<N, GkcPacketTypeList<Ts...>>
+{
+public:
+  template<typename T>
+  typename GkcPacketPool<T, N>::Handle acquire()
+  {
+    return std::get<GkcPacketPool<T, N>>(pools_).acquire();
+  }
+
+  template<typename T>
+  size_t available() const {return std::get<GkcPacketPool<T, N>>(pools_).available();}
+
+private:
+  std::tuple<GkcPacketPool<Ts, N>...> pools_ {};
+};
+}  // namespace gkc
+}  // namespace tritonai
+#endif  // TAI_GOKART_PACKET__GKC_PACKET_POOL_HPP_
@@ -1,7 +1,8 @@
 /**
  * @file gkc_packet_subscriber.hpp
  * @author Haoru Xue (hxue@ucsd.edu)
- * @brief
+ * @brief Interface for receiving packets from the factory
+ * Generated by tools/gkc_codegen.py from schema/gkc_packets.yaml. Do not edit.
  * @version 0.1
  * @date 2021-11-04
  *
@@ -23,11 +24,25 @@ class ResetMcuGkcPacket;
 class HeartbeatGkcPacket;
 class ConfigGkcPacket;
 class StateTransitionGkcPacket;
+class LogFilterGkcPacket;
 class ControlGkcPacket;
 class SensorGkcPacket;
 class Shutdown1GkcPacket;
 class Shutdown2GkcPacket;
 class LogPacket;
+class LogIdGkcPacket;
+class CompactSensorGkcPacket;
+class CompactControlGkcPacket;
+class SensorDeltaGkcPacket;
+class SensorResyncGkcPacket;
+class SensorBatchGkcPacket;
+class BulkRequestGkcPacket;
+class BulkStartGkcPacket;
+class BulkChunkGkcPacket;
+class BulkAckGkcPacket;
+class HeartbeatView;
+class ControlView;
+class SensorView;
 /**
  * @brief Subclass this to receive GkcPackets from GkcPacketFactory
  *
@@ -44,11 +59,30 @@ public:
   virtual void packet_callback(const HeartbeatGkcPacket & packet) = 0;
   virtual void packet_callback(const ConfigGkcPacket & packet) = 0;
   virtual void packet_callback(const StateTransitionGkcPacket & packet) = 0;
+  virtual void packet_callback(const LogFilterGkcPacket & packet) = 0;
   virtual void packet_callback(const ControlGkcPacket & packet) = 0;
   virtual void packet_callback(const SensorGkcPacket & packet) = 0;
   virtual void packet_callback(const Shutdown1GkcPacket & packet) = 0;
   virtual void packet_callback(const Shutdown2GkcPacket & packet) = 0;
   virtual void packet_callback(const LogPacket & packet) = 0;
+  virtual void packet_callback(const LogIdGkcPacket & packet) = 0;
+  virtual void packet_callback(const CompactSensorGkcPacket & packet) = 0;
+  virtual void packet_callback(const CompactControlGkcPacket & packet) = 0;
+  virtual void packet_callback(const SensorDeltaGkcPacket & packet) = 0;
+  virtual void packet_callback(const SensorResyncGkcPacket & packet) = 0;
+  virtual void packet_callback(const SensorBatchGkcPacket & packet) = 0;
+  virtual void packet_callback(const BulkRequestGkcPacket & packet) = 0;
+  virtual void packet_callback(const BulkStartGkcPacket & packet) = 0;
+  virtual void packet_callback(const BulkChunkGkcPacket & packet) = 0;
+  virtual void packet_callback(const BulkAckGkcPacket & packet) = 0;
+
+  /**
+   * @brief Optionally inspect a frame in place before it is decoded.
+   * Return true if the view was enough, which skips decoding and `packet_callback`.
+   */
+  virtual bool packet_view_callback(const HeartbeatView & view) {(void)view; return false;}
+  virtual bool packet_view_callback(const ControlView & view) {(void)view; return false;}
+  virtual bool packet_view_callback(const SensorView & view) {(void)view; return false;}
 };
 }  // namespace gkc
 }  // namespace tritonai
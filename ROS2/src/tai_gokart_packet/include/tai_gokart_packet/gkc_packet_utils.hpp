@@ -12,18 +12,262 @@
 #ifndef TAI_GOKART_PACKET__GKC_PACKET_UTILS_HPP_
 #define TAI_GOKART_PACKET__GKC_PACKET_UTILS_HPP_
 
-#include <memory>
-#include <vector>
+#include <cstring>
 #include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#ifndef GKC_PACKET_MCU_PROFILE
+#include <memory>
+#include <stdexcept>
 #include <string>
+#else
+#include <cassert>
+#endif
+
+#include "tai_gokart_packet/gkc_crc.hpp"
+#include "tai_gokart_packet/gkc_packet_config.hpp"
 
 namespace tritonai
 {
 namespace gkc
 {
-using GkcBuffer = std::vector<uint8_t>;
+#ifndef GKC_PACKET_MCU_PROFILE
+typedef void (* GkcDebugCallback)(std::string);
+#else
+typedef void (* GkcDebugCallback)(const char *);
+#endif
 class GkcPacket;
 
+/**
+ * @brief A non-owning view of contiguous elements, e.g. a payload inside a receive buffer
+ *
+ * @tparam T element type (`const uint8_t` for read-only views)
+ */
+template<typename T>
+class GkcSpan
+{
+public:
+  typedef T * iterator;
+
+  constexpr GkcSpan() = default;
+  constexpr GkcSpan(T * data, size_t size)
+  : data_(data), size_(size) {}
+
+  template<typename C, typename = std::enable_if_t<
+      !std::is_same<std::decay_t<C>, GkcSpan>::value &&
+      std::is_convertible<decltype(std::declval<C &>().data()), T *>::value>>
+  GkcSpan(C && container)  // NOLINT(runtime/explicit): views are cheap conversions
+  : data_(container.data()), size_(container.size()) {}
+
+  constexpr T * data() const {return data_;}
+  constexpr size_t size() const {return size_;}
+  constexpr bool empty() const {return size_ == 0;}
+  constexpr iterator begin() const {return data_;}
+  constexpr iterator end() const {return data_ + size_;}
+  constexpr T & operator[](const size_t & i) const {return data_[i];}
+
+  constexpr GkcSpan subspan(const size_t & offset, const size_t & count) const
+  {
+    return GkcSpan(data_ + offset, count);
+  }
+
+private:
+  T * data_ = nullptr;
+  size_t size_ = 0;
+};
+
+using GkcBufferView = GkcSpan<const uint8_t>;
+using GkcMutableBufferView = GkcSpan<uint8_t>;
+
+/**
+ * @brief A string with inline storage for up to `N` characters, for where std::string
+ * is not available. Longer assignments are truncated.
+ */
+template<size_t N>
+class GkcFixedString
+{
+public:
+  typedef const char * const_iterator;
+
+  GkcFixedString() = default;
+  GkcFixedString(const char * str)  // NOLINT(runtime/explicit): mirrors std::string
+  {
+    *this = str;
+  }
+
+  GkcFixedString & assign(const char * str, const size_t & size)
+  {
+    size_ = std::min(size, N);
+    std::memcpy(data_, str, size_);
+    data_[size_] = '\0';
+    return *this;
+  }
+  GkcFixedString & operator=(const char * str) {return assign(str, std::strlen(str));}
+
+  const char * data() const {return data_;}
+  const char * c_str() const {return data_;}
+  size_t size() const {return size_;}
+  bool empty() const {return size_ == 0;}
+  static constexpr size_t capacity() {return N;}
+  const_iterator begin() const {return data_;}
+  const_iterator end() const {return data_ + size_;}
+
+  bool operator==(const char * str) const
+  {
+    return std::strlen(str) == size_ && std::memcmp(data_, str, size_) == 0;
+  }
+
+private:
+  char data_[N + 1] = {};
+  size_t size_ = 0;
+};
+
+/**
+ * @brief A byte buffer with inline storage for up to `N` bytes and the commonly used part of
+ * the `std::vector` interface. It never touches the heap and is trivially copyable, so it can
+ * be copied with `memcpy` and passed around by value.
+ * Growing it beyond `N` bytes, or popping from an empty buffer, throws `std::length_error`
+ * (asserts in the MCU profile) and leaves the buffer unchanged.
+ */
+template<size_t N>
+class GkcInlineBuffer
+{
+  static_assert(N <= UINT16_MAX, "GkcInlineBuffer stores its size in 16 bits.");
+
+public:
+  typedef uint8_t value_type;
+  typedef size_t size_type;
+  typedef uint8_t * iterator;
+  typedef const uint8_t * const_iterator;
+
+  // Bytes beyond size() are left uninitialized, so that construction stays cheap
+  GkcInlineBuffer() {}  // NOLINT(modernize-use-equals-default): keeps data_ uninitialized
+  explicit GkcInlineBuffer(const size_t & size, const uint8_t & value = 0)
+  {
+    resize(size, value);
+  }
+  template<typename InputIt, typename = std::enable_if_t<!std::is_integral<InputIt>::value>>
+  GkcInlineBuffer(InputIt first, InputIt last)
+  {
+    assign(first, last);
+  }
+  GkcInlineBuffer(std::initializer_list<uint8_t> bytes)
+  {
+    assign(bytes.begin(), bytes.end());
+  }
+
+  template<typename InputIt, typename = std::enable_if_t<!std::is_integral<InputIt>::value>>
+  void assign(InputIt first, InputIt last)
+  {
+    size_ = 0;
+    insert(end(), first, last);
+  }
+
+  uint8_t * data() {return data_;}
+  const uint8_t * data() const {return data_;}
+  size_t size() const {return size_;}
+  bool empty() const {return size_ == 0;}
+  static constexpr size_t capacity() {return N;}
+  static constexpr size_t max_size() {return N;}
+
+  iterator begin() {return data_;}
+  iterator end() {return data_ + size_;}
+  const_iterator begin() const {return data_;}
+  const_iterator end() const {return data_ + size_;}
+  const_iterator cbegin() const {return data_;}
+  const_iterator cend() const {return data_ + size_;}
+
+  uint8_t & operator[](const size_t & i) {return data_[i];}
+  const uint8_t & operator[](const size_t & i) const {return data_[i];}
+  uint8_t & front() {return data_[0];}
+  const uint8_t & front() const {return data_[0];}
+  uint8_t & back() {return data_[size_ - 1];}
+  const uint8_t & back() const {return data_[size_ - 1];}
+
+  void clear() {size_ = 0;}
+  void resize(const size_t & size, const uint8_t & value = 0)
+  {
+    if (!check(size <= N, "GkcInlineBuffer::resize beyond capacity")) {
+      return;
+    }
+    if (size > size_) {
+      std::memset(data_ + size_, value, size - size_);
+    }
+    size_ = static_cast<uint16_t>(size);
+  }
+  void push_back(const uint8_t & value)
+  {
+    if (check(size_ < N, "GkcInlineBuffer::push_back beyond capacity")) {
+      data_[size_++] = value;
+    }
+  }
+  void pop_back()
+  {
+    if (check(size_ > 0, "GkcInlineBuffer::pop_back on an empty buffer")) {
+      --size_;
+    }
+  }
+
+  /**
+   * @brief Insert bytes before `pos`
+   *
+   * @return iterator to the first inserted byte
+   */
+  template<typename InputIt, typename = std::enable_if_t<!std::is_integral<InputIt>::value>>
+  iterator insert(const_iterator pos, InputIt first, InputIt last)
+  {
+    const size_t offset = static_cast<size_t>(pos - data_);
+    const size_t count = static_cast<size_t>(std::distance(first, last));
+    if (!check(count <= N - size_, "GkcInlineBuffer::insert beyond capacity")) {
+      return data_ + offset;
+    }
+    std::memmove(data_ + offset + count, data_ + offset, size_ - offset);
+    std::copy_n(first, count, data_ + offset);
+    size_ = static_cast<uint16_t>(size_ + count);
+    return data_ + offset;
+  }
+
+  bool operator==(const GkcInlineBuffer & other) const
+  {
+    return size_ == other.size_ && std::memcmp(data_, other.data_, size_) == 0;
+  }
+  bool operator!=(const GkcInlineBuffer & other) const {return !(*this == other);}
+
+private:
+  static bool check(const bool & ok, const char * what)
+  {
+#ifndef GKC_PACKET_MCU_PROFILE
+    if (!ok) {
+      throw std::length_error(what);
+    }
+#else
+    (void)what;
+    assert(ok);
+#endif
+    return ok;
+  }
+
+  uint16_t size_ = 0;
+  uint8_t data_[N];
+};
+
+/**
+ * @brief Buffer of one complete frame or payload. `GkcFrameFormat::MAX_FRAME_SIZE` bytes,
+ * which `gkc_packets.hpp` checks. Use `std::vector<uint8_t>` for longer streams.
+ */
+using GkcBuffer = GkcInlineBuffer<260>;
+
+/**
+ * @brief How frames are delimited on the wire
+ */
+enum class GkcFraming : uint8_t
+{
+  Legacy = 0,  // 0x02 | payload size | payload | checksum | 0x03
+  Cobs = 1  // COBS(payload | checksum) | 0x00
+};
+
 enum GkcLifecycle
 {
   Uninitialized = 0,
@@ -41,49 +285,21 @@ public:
    * @brief calculate CRC-16 checksum
    * (https://github.com/vedderb/bldc/blob/master/crc.c)
    *
-   * @param payload payload used to calculate checksum
+   * @param data start of the payload used to calculate checksum
+   * @param size number of bytes in the payload
    * @return uint16_t CRC-16 checksum
    */
+  static uint16_t calc_crc16(const uint8_t * data, const size_t & size)
+  {
+    return GkcCrc16::compute(data, size);
+  }
+
   static uint16_t calc_crc16(const GkcBuffer & payload)
   {
-    static const uint16_t crc16_tab[] = {
-      0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50a5, 0x60c6, 0x70e7, 0x8108,
-      0x9129, 0xa14a, 0xb16b, 0xc18c, 0xd1ad, 0xe1ce, 0xf1ef, 0x1231, 0x0210,
-      0x3273, 0x2252, 0x52b5, 0x4294, 0x72f7, 0x62d6, 0x9339, 0x8318, 0xb37b,
-      0xa35a, 0xd3bd, 0xc39c, 0xf3ff, 0xe3de, 0x2462, 0x3443, 0x0420, 0x1401,
-      0x64e6, 0x74c7, 0x44a4, 0x5485, 0xa56a, 0xb54b, 0x8528, 0x9509, 0xe5ee,
-      0xf5cf, 0xc5ac, 0xd58d, 0x3653, 0x2672, 0x1611, 0x0630, 0x76d7, 0x66f6,
-      0x5695, 0x46b4, 0xb75b, 0xa77a, 0x9719, 0x8738, 0xf7df, 0xe7fe, 0xd79d,
-      0xc7bc, 0x48c4, 0x58e5, 0x6886, 0x78a7, 0x0840, 0x1861, 0x2802, 0x3823,
-      0xc9cc, 0xd9ed, 0xe98e, 0xf9af, 0x8948, 0x9969, 0xa90a, 0xb92b, 0x5af5,
-      0x4ad4, 0x7ab7, 0x6a96, 0x1a71, 0x0a50, 0x3a33, 0x2a12, 0xdbfd, 0xcbdc,
-      0xfbbf, 0xeb9e, 0x9b79, 0x8b58, 0xbb3b, 0xab1a, 0x6ca6, 0x7c87, 0x4ce4,
-      0x5cc5, 0x2c22, 0x3c03, 0x0c60, 0x1c41, 0xedae, 0xfd8f, 0xcdec, 0xddcd,
-      0xad2a, 0xbd0b, 0x8d68, 0x9d49, 0x7e97, 0x6eb6, 0x5ed5, 0x4ef4, 0x3e13,
-      0x2e32, 0x1e51, 0x0e70, 0xff9f, 0xefbe, 0xdfdd, 0xcffc, 0xbf1b, 0xaf3a,
-      0x9f59, 0x8f78, 0x9188, 0x81a9, 0xb1ca, 0xa1eb, 0xd10c, 0xc12d, 0xf14e,
-      0xe16f, 0x1080, 0x00a1, 0x30c2, 0x20e3, 0x5004, 0x4025, 0x7046, 0x6067,
-      0x83b9, 0x9398, 0xa3fb, 0xb3da, 0xc33d, 0xd31c, 0xe37f, 0xf35e, 0x02b1,
-      0x1290, 0x22f3, 0x32d2, 0x4235, 0x5214, 0x6277, 0x7256, 0xb5ea, 0xa5cb,
-      0x95a8, 0x8589, 0xf56e, 0xe54f, 0xd52c, 0xc50d, 0x34e2, 0x24c3, 0x14a0,
-      0x0481, 0x7466, 0x6447, 0x5424, 0x4405, 0xa7db, 0xb7fa, 0x8799, 0x97b8,
-      0xe75f, 0xf77e, 0xc71d, 0xd73c, 0x26d3, 0x36f2, 0x0691, 0x16b0, 0x6657,
-      0x7676, 0x4615, 0x5634, 0xd94c, 0xc96d, 0xf90e, 0xe92f, 0x99c8, 0x89e9,
-      0xb98a, 0xa9ab, 0x5844, 0x4865, 0x7806, 0x6827, 0x18c0, 0x08e1, 0x3882,
-      0x28a3, 0xcb7d, 0xdb5c, 0xeb3f, 0xfb1e, 0x8bf9, 0x9bd8, 0xabbb, 0xbb9a,
-      0x4a75, 0x5a54, 0x6a37, 0x7a16, 0x0af1, 0x1ad0, 0x2ab3, 0x3a92, 0xfd2e,
-      0xed0f, 0xdd6c, 0xcd4d, 0xbdaa, 0xad8b, 0x9de8, 0x8dc9, 0x7c26, 0x6c07,
-      0x5c64, 0x4c45, 0x3ca2, 0x2c83, 0x1ce0, 0x0cc1, 0xef1f, 0xff3e, 0xcf5d,
-      0xdf7c, 0xaf9b, 0xbfba, 0x8fd9, 0x9ff8, 0x6e17, 0x7e36, 0x4e55, 0x5e74,
-      0x2e93, 0x3eb2, 0x0ed1, 0x1ef0};
-
-    uint16_t checksum = 0;
-    for (const auto & byte : payload) {
-      checksum = crc16_tab[(((checksum >> 8) ^ byte) & 0xFF)] ^ (checksum << 8);
-    }
-    return checksum;
+    return calc_crc16(payload.data(), payload.size());
   }
 
+#ifndef GKC_PACKET_MCU_PROFILE
   static void debug_cout(std::string str);
 
   template<typename T>
@@ -92,72 +308,80 @@ public:
     auto packet_ptr = std::shared_ptr<GkcPacket>(new T);
     return packet_ptr;
   }
+#else
+  static void debug_none(const char * str) {(void)str;}
+#endif
 
   /**
    * @brief Write some primitive types or struct to buffer
    *
    * @tparam T the datatype
-   * @param where iterator to the start of destination
+   * @param where start of destination, e.g. `GkcBuffer::begin()`
    * @param to_write value to write
-   * @return GkcBuffer::iterator an iterator to the end of the copied content
+   * @return uint8_t* a pointer to the end of the copied content
    */
   template<typename T>
-  static GkcBuffer::iterator write_to_buffer(GkcBuffer::iterator where, const T & to_write)
+  static uint8_t * write_to_buffer(uint8_t * where, const T & to_write)
   {
-    const uint8_t * start =
-      static_cast<const uint8_t *>(static_cast<const void *>(&to_write));
-    const auto end = start + sizeof(T);
-    std::copy(start, end, where);
+    std::memcpy(where, &to_write, sizeof(T));
     return where + sizeof(T);
   }
 
   /**
-   * @brief pointer version of `write_to_buffer()`
+   * @brief Read content from part of a buffer utilizing `sizeof(T)`
    *
-   * @tparam T the datatype
-   * @param where iterator to the start of destination
-   * @param to_write value to write
-   * @return uint8_t* a pointer to the end of the copied content
+   * @tparam T datatype to be read in
+   * @param where where to start reading the content
+   * @param to_read where to store the read content
+   * @return const uint8_t* a pointer to the end of the read bytes in the buffer
    */
   template<typename T>
-  static uint8_t * write_to_buffer(const uint8_t * & where, const T & to_write)
+  static const uint8_t * read_from_buffer(const uint8_t * where, T & to_read)
   {
-    const uint8_t * start =
-      static_cast<const uint8_t *>(static_cast<const void *>(&to_write));
-    const auto end = start + sizeof(T);
-    std::copy(start, end, where);
-    return end;
+    std::memcpy(&to_read, where, sizeof(T));
+    return where + sizeof(T);
   }
 
   /**
-   * @brief Read content from part of a buffer utilizing `sizeof(T)`
+   * @brief Write a real number as a fixed-point integer counting units of `resolution`.
+   * Rounds to the nearest integer and saturates to the range of `T`. NaN is written as 0.
    *
-   * @tparam T datatype to be read in
-   * @param where where to start reading the content
-   * @param to_read where to store the read content
-   * @return GkcBuffer::const_iterator an iterator to the end of the read bytes in the buffer
+   * @tparam T integer type on the wire
+   * @param where start of destination
+   * @param value value to write
+   * @param resolution value of one unit, i.e. the precision of the encoding
+   * @return uint8_t* a pointer to the end of the copied content
    */
-  template<typename T>
-  static GkcBuffer::const_iterator read_from_buffer(GkcBuffer::const_iterator where, T & to_read)
+  template<typename T, typename R>
+  static uint8_t * write_fixed_point(uint8_t * where, const R value, const R resolution)
   {
-    // TODO(haoru): reinterpret_cast?
-    to_read = *static_cast<const T *>(static_cast<const void *>(&(*where)));
-    return where + sizeof(T);
+    static_assert(std::is_integral<T>::value, "Fixed-point values are integers on the wire.");
+    const R scaled = value / resolution;
+    T fixed = 0;
+    if (scaled >= static_cast<R>(std::numeric_limits<T>::max())) {
+      fixed = std::numeric_limits<T>::max();
+    } else if (scaled <= static_cast<R>(std::numeric_limits<T>::lowest())) {
+      fixed = std::numeric_limits<T>::lowest();
+    } else if (scaled == scaled) {
+      fixed = static_cast<T>(scaled < 0 ? scaled - R(0.5) : scaled + R(0.5));
+    }
+    return write_to_buffer(where, fixed);
   }
 
   /**
-   * @brief pointer version of `read_from_buffer`
+   * @brief Read a fixed-point integer written by `write_fixed_point`
    *
-   * @tparam T datatype to be read in
+   * @tparam T integer type on the wire
    * @param where where to start reading the content
-   * @param to_read where to store the read content
-   * @return const uint8_t* a pointer to the end of the read bytes in the buffer
+   * @param resolution value of one unit
+   * @return R the real number
    */
-  template<typename T>
-  static const uint8_t * read_from_buffer(const uint8_t * & where, T & to_read)
+  template<typename T, typename R>
+  static R read_fixed_point(const uint8_t * where, const R resolution)
   {
-    to_read = *static_cast<const T *>(static_cast<const void *>(where));
-    return where + sizeof(T);
+    T fixed = 0;
+    read_from_buffer(where, fixed);
+    return static_cast<R>(fixed) * resolution;
   }
 };
 }  // namespace gkc
@@ -0,0 +1,80 @@
+/**
+ * @file gkc_packet_views.hpp
+ * @brief Read-only views that decode packet fields on access
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2026 [Triton AI]
+ *
+ */
+
+#ifndef TAI_GOKART_PACKET__GKC_PACKET_VIEWS_HPP_
+#define TAI_GOKART_PACKET__GKC_PACKET_VIEWS_HPP_
+
+#include <cstddef>
+#include <cstring>
+
+#include "tai_gokart_packet/gkc_packets.hpp"
+
+namespace tritonai
+{
+namespace gkc
+{
+/**
+ * @brief A validated payload interpreted in place. Nothing is copied until a field is read.
+ * The view is only valid as long as the payload it refers to, i.e. within the view callback.
+ *
+ * @tparam PacketT packet type the payload encodes
+ */
+template<typename PacketT>
+class GkcPacketView
+{
+public:
+  typedef PacketT Packet;
+
+  explicit GkcPacketView(const GkcBufferView & payload)
+  : payload_(payload) {}
+
+  /**
+   * @brief true if the payload has the right first byte and is long enough for every field
+   */
+  bool valid() const
+  {
+    return payload_.size() >= Packet::PAYLOAD_SIZE && payload_[0] == Packet::FIRST_BYTE;
+  }
+
+  const GkcBufferView & payload() const {return payload_;}
+
+  /**
+   * @brief Decode the whole payload into a packet
+   */
+  void decode(Packet & packet) const {packet.decode(payload_);}
+
+protected:
+  /**
+   * @brief Alignment-safe load of a field `offset` bytes into the payload
+   */
+  template<typename T>
+  T load(const size_t & offset) const
+  {
+    T val;
+    std::memcpy(&val, payload_.data() + offset, sizeof(T));
+    return val;
+  }
+
+  GkcBufferView payload_;
+};
+
+/**
+ * @brief The view type of a packet, or void if it has none
+ */
+template<typename PacketT>
+struct GkcPacketViewOf
+{
+  typedef void type;
+};
+}  // namespace gkc
+}  // namespace tritonai
+
+// Views of the packets with a `view` in schema/gkc_packets.yaml
+#include "tai_gokart_packet/generated/gkc_packet_view_defs.hpp"
+#endif  // TAI_GOKART_PACKET__GKC_PACKET_VIEWS_HPP_
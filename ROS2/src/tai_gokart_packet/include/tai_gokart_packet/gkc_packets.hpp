@@ -12,13 +12,18 @@
 #ifndef TAI_GOKART_PACKET__GKC_PACKETS_HPP_
 #define TAI_GOKART_PACKET__GKC_PACKETS_HPP_
 
+#include <algorithm>
+#include <array>
+#ifndef GKC_PACKET_MCU_PROFILE
 #include <optional>
 #include <iostream>
 #include <memory>
 #include <vector>
 #include <string>
-#include <algorithm>
+#endif
 
+#include "tai_gokart_packet/gkc_cobs.hpp"
+#include "tai_gokart_packet/gkc_packet_config.hpp"
 #include "tai_gokart_packet/gkc_packet_subscriber.hpp"
 #include "tai_gokart_packet/gkc_packet_utils.hpp"
 
@@ -26,14 +31,57 @@ namespace tritonai
 {
 namespace gkc
 {
-
-using GkcBuffer = std::vector<uint8_t>;
-class RawGkcPacket
+/**
+ * @brief Frame layout constants. The heap-based packet itself is not part of the MCU profile.
+ */
+struct GkcFrameFormat
 {
-public:
   static constexpr uint8_t START_BYTE = 0x02;
   static constexpr uint8_t END_BYTE = 0x03;
+  static constexpr size_t NUM_BYTES_BEFORE_PAYLOAD = 2;  // start byte and payload size
+  static constexpr size_t NUM_NON_PAYLOAD_BYTES = 5;  // plus checksum and end byte
+  static constexpr size_t MIN_PAYLOAD_SIZE = 1;
+  static constexpr size_t MAX_PAYLOAD_SIZE = 255;
+  static constexpr size_t MIN_FRAME_SIZE = MIN_PAYLOAD_SIZE + NUM_NON_PAYLOAD_BYTES;
+  static constexpr size_t MAX_FRAME_SIZE = MAX_PAYLOAD_SIZE + NUM_NON_PAYLOAD_BYTES;
+  // COBS framing: encoded payload and checksum, then the delimiter
+  static constexpr size_t MAX_COBS_FRAME_SIZE =
+    GkcCobs::max_encoded_size(MAX_PAYLOAD_SIZE + sizeof(uint16_t)) + 1;
+  static_assert(MAX_COBS_FRAME_SIZE <= MAX_FRAME_SIZE, "A COBS frame must fit any frame buffer.");
+  static_assert(GkcBuffer::capacity() == MAX_FRAME_SIZE, "A GkcBuffer must hold one frame.");
+
+  // Extended frames, for payloads longer than `MAX_PAYLOAD_SIZE` once both sides agree to
+  // `GkcCapabilities::EXTENDED_FRAMES`: 0x03 | uint16 payload size | payload | checksum | 0x03
+  static constexpr uint8_t EXTENDED_START_BYTE = 0x03;
+  static constexpr size_t NUM_BYTES_BEFORE_EXTENDED_PAYLOAD = 3;
+  static constexpr size_t NUM_NON_EXTENDED_PAYLOAD_BYTES = 6;
+  static constexpr size_t MAX_EXTENDED_PAYLOAD_SIZE = GKC_PACKET_MAX_EXTENDED_PAYLOAD_SIZE;
+  static_assert(
+    MAX_EXTENDED_PAYLOAD_SIZE >= MAX_PAYLOAD_SIZE && MAX_EXTENDED_PAYLOAD_SIZE <= UINT16_MAX,
+    "The extended payload size is a uint16 beyond MAX_PAYLOAD_SIZE.");
+  // Either framing. COBS adds a byte every 254 bytes, so it is the longer one for long payloads.
+  static constexpr size_t MAX_EXTENDED_FRAME_SIZE = std::max(
+    MAX_EXTENDED_PAYLOAD_SIZE + NUM_NON_EXTENDED_PAYLOAD_BYTES,
+    GkcCobs::max_encoded_size(MAX_EXTENDED_PAYLOAD_SIZE + sizeof(uint16_t)) + 1);
+};
+
+/**
+ * @brief Optional features, exchanged as a bit field in the handshake.
+ * Handshake #1 carries the PC's capabilities, handshake #2 those the MCU agrees to use.
+ */
+struct GkcCapabilities
+{
+  static constexpr uint8_t COBS_FRAMING = 0x01;
+  static constexpr uint8_t COMPACT_PACKETS = 0x02;  // compact Sensors and Control
+  static constexpr uint8_t SENSOR_DELTAS = 0x04;  // SensorDeltaGkcPacket instead of Sensors
+  static constexpr uint8_t SENSOR_BATCHES = 0x08;  // SensorBatchGkcPacket
+  static constexpr uint8_t EXTENDED_FRAMES = 0x10;  // payloads beyond MAX_PAYLOAD_SIZE
+};
 
+#ifndef GKC_PACKET_MCU_PROFILE
+class RawGkcPacket : public GkcFrameFormat
+{
+public:
   RawGkcPacket();
 
   /**
@@ -43,8 +91,9 @@ public:
    */
 
   explicit RawGkcPacket(const GkcBuffer & payload);
-  RawGkcPacket(const RawGkcPacket & packet);
-  RawGkcPacket & operator=(const RawGkcPacket & packet);
+  // The payload is stored inline: copying a packet is a plain memory copy
+  RawGkcPacket(const RawGkcPacket & packet) = default;
+  RawGkcPacket & operator=(const RawGkcPacket & packet) = default;
 
   std::shared_ptr<GkcBuffer> encode();
 
@@ -55,204 +104,66 @@ public:
   typedef std::shared_ptr<RawGkcPacket> SharedPtr;
   typedef std::unique_ptr<RawGkcPacket> UniquePtr;
 };
+#endif
 
 class GkcPacket
 {
 public:
+#ifndef GKC_PACKET_MCU_PROFILE
   typedef std::shared_ptr<GkcPacket> SharedPtr;
   typedef std::unique_ptr<GkcPacket> UniquePtr;
+#endif
   uint64_t timestamp = 0;
   virtual ~GkcPacket();
+#ifndef GKC_PACKET_MCU_PROFILE
   virtual RawGkcPacket::SharedPtr encode() const;
-  virtual void decode(const RawGkcPacket & raw);
-  virtual void publish(GkcPacketSubscriber & sub);
-};
-
-class Handshake1GkcPacket : public GkcPacket
-{
-public:
-  static constexpr uint8_t FIRST_BYTE = 0x4;
-  uint32_t seq_number = 0;
-  RawGkcPacket::SharedPtr encode() const;
-  void decode(const RawGkcPacket & raw);
-  void publish(GkcPacketSubscriber & sub) {return sub.packet_callback(*this);}
-};
-
-class Handshake2GkcPacket : public GkcPacket
-{
-public:
-  static constexpr uint8_t FIRST_BYTE = 0x5;
-  uint32_t seq_number = 0;
-  RawGkcPacket::SharedPtr encode() const;
-  void decode(const RawGkcPacket & raw);
-  void publish(GkcPacketSubscriber & sub) {sub.packet_callback(*this);}
-};
-
-class GetFirmwareVersionGkcPacket : public GkcPacket
-{
-public:
-  static constexpr uint8_t FIRST_BYTE = 0x6;
-  RawGkcPacket::SharedPtr encode() const;
-  void decode(const RawGkcPacket & raw);
-  void publish(GkcPacketSubscriber & sub) {sub.packet_callback(*this);}
-};
-
-class FirmwareVersionGkcPacket : public GkcPacket
-{
-public:
-  static constexpr uint8_t FIRST_BYTE = 0x7;
-  uint8_t major = 0;
-  uint8_t minor = 0;
-  uint8_t patch = 0;
-  RawGkcPacket::SharedPtr encode() const;
-  void decode(const RawGkcPacket & raw);
-  void publish(GkcPacketSubscriber & sub) {sub.packet_callback(*this);}
-};
-
-class ResetMcuGkcPacket : public GkcPacket
-{
-public:
-  static constexpr uint8_t FIRST_BYTE = 0xFF;
-  uint32_t magic_number = 0;
-  RawGkcPacket::SharedPtr encode() const;
-  void decode(const RawGkcPacket & raw);
-  void publish(GkcPacketSubscriber & sub) {sub.packet_callback(*this);}
-};
-
-class HeartbeatGkcPacket : public GkcPacket
-{
-public:
-  static constexpr uint8_t FIRST_BYTE = 0xAA;
-  uint8_t rolling_counter = 0;
-  uint8_t state = 0;
-  RawGkcPacket::SharedPtr encode() const;
-  void decode(const RawGkcPacket & raw);
-  void publish(GkcPacketSubscriber & sub) {sub.packet_callback(*this);}
-};
-
-class ConfigGkcPacket : public GkcPacket
-{
-public:
-  static constexpr uint8_t FIRST_BYTE = 0xA0;
-  struct __attribute__((packed)) Configurables
-  {
-    // steering config (refers to average front wheel angle in radian)
-    float max_steering_left;
-    float max_steering_right;
-    float neutral_steering;  // should be between max and min
+#endif
 
-    // throttle config (unit is implementation-dependant, typically unit-less out of 1.0)
-    float max_throttle;
-    float min_throttle;
-    float zero_throttle;  // should be smaller than min
-
-    // brake config (in psi)
-    float max_brake;
-    float min_brake;
-    float zero_brake;  // should be smaller than min
-
-    // watchdog timeouts (in millisecond)
-    uint32_t control_timeout_ms;  // timeout for control packets
-    uint32_t comm_timeout_ms;  // timeout for heartbeat packets
-    uint32_t sensor_timeout_ms;  // timeout between two sensor pollings
-  } values;
-
-  RawGkcPacket::SharedPtr encode() const;
-  void decode(const RawGkcPacket & raw);
-  void publish(GkcPacketSubscriber & sub) {sub.packet_callback(*this);}
-};
-
-class StateTransitionGkcPacket : public GkcPacket
-{
-public:
-  static constexpr uint8_t FIRST_BYTE = 0xA1;
-  uint8_t requested_state = 0;
-  RawGkcPacket::SharedPtr encode() const;
-  void decode(const RawGkcPacket & raw);
-  void publish(GkcPacketSubscriber & sub) {sub.packet_callback(*this);}
-};
-
-class ControlGkcPacket : public GkcPacket
-{
-public:
-  static constexpr uint8_t FIRST_BYTE = 0xAB;
-  float throttle;  // paddle percentage out of 1.0
-  float steering;  // average front wheel angle in radian
-  float brake;  // target brake pressure in psi
-  RawGkcPacket::SharedPtr encode() const;
-  void decode(const RawGkcPacket & raw);
-  void publish(GkcPacketSubscriber & sub) {sub.packet_callback(*this);}
-};
-
-class SensorGkcPacket : public GkcPacket
-{
-public:
-  static constexpr uint8_t FIRST_BYTE = 0xAC;
-  struct __attribute__((packed)) SensorValues
-  {
-    float wheel_speed_fl;  // wheel speeds in rpm
-    float wheel_speed_fr;
-    float wheel_speed_rl;
-    float wheel_speed_rr;
-
-    float voltage;  // battery voltage in volt
-    float amperage;  // battery current draw in amp
-
-    float brake_pressure;  // brake pressure in psi
-    float throttle_pos;  // throttle paddle position out of 1.0
-    float steering_angle_rad;  // (left +, right -) average wheel angle of the front wheels in rad
-    float servo_angle_rad;  // (left +, right -) servo offset from center in rad
-
-    bool fault_brake;  // fault flag in actuation subsystem
-    bool fault_throttle;
-    bool fault_steering;
-
-    bool fault_fatal;  // fault flag with severity level
-    bool fault_error;
-    bool fault_warning;
-    bool fault_info;
-  } values;
-  RawGkcPacket::SharedPtr encode() const;
-  void decode(const RawGkcPacket & raw);
-  void publish(GkcPacketSubscriber & sub) {sub.packet_callback(*this);}
-};
+  /**
+   * @brief Encode the complete frame without heap allocation.
+   * Legacy framing: start byte, size, payload, checksum, end byte. Payloads longer than
+   * `GkcFrameFormat::MAX_PAYLOAD_SIZE` are sent in an extended frame.
+   * COBS framing: COBS-encoded payload and checksum, then the delimiter.
+   *
+   * @param frame destination, e.g. a stack buffer of `GkcFrameFormat::MAX_FRAME_SIZE` bytes
+   * (`MAX_EXTENDED_FRAME_SIZE` for packets that may need an extended frame)
+   * @param framing how the frame is delimited
+   * @return size_t number of bytes written; 0 if `frame` is too small
+   */
+  size_t encode_into(
+    const GkcMutableBufferView & frame,
+    const GkcFraming & framing = GkcFraming::Legacy) const;
 
-class Shutdown1GkcPacket : public GkcPacket
-{
-public:
-  static constexpr uint8_t FIRST_BYTE = 0xA2;
-  uint32_t seq_number;
-  RawGkcPacket::SharedPtr encode() const;
-  void decode(const RawGkcPacket & raw);
-  void publish(GkcPacketSubscriber & sub) {sub.packet_callback(*this);}
-};
+  /**
+   * @brief number of bytes in the payload, first byte included
+   */
+  virtual size_t payload_size() const;
 
-class Shutdown2GkcPacket : public GkcPacket
-{
-public:
-  static constexpr uint8_t FIRST_BYTE = 0xA3;
-  uint32_t seq_number;
-  RawGkcPacket::SharedPtr encode() const;
-  void decode(const RawGkcPacket & raw);
-  void publish(GkcPacketSubscriber & sub) {sub.packet_callback(*this);}
-};
+  /**
+   * @brief Write the payload, first byte included
+   *
+   * @param payload destination of at least `payload_size()` bytes
+   */
+  virtual void encode_payload(uint8_t * payload) const;
 
-class LogPacket : public GkcPacket
-{
-public:
-  static constexpr uint8_t FIRST_BYTE = 0xAD;
-  enum Severity
-  {
-    INFO = 0,
-    WARNING = 1,
-    ERROR = 2,
-    FATAL = 3
-  } level;
-  std::string what;
-  RawGkcPacket::SharedPtr encode() const;
-  void decode(const RawGkcPacket & raw);
-  void publish(GkcPacketSubscriber & sub) {sub.packet_callback(*this);}
+  /**
+   * @brief Decode from a validated payload, first byte included
+   *
+   * @param payload view of the payload, e.g. inside the receive buffer
+   */
+  virtual void decode(const GkcBufferView & payload);
+#ifndef GKC_PACKET_MCU_PROFILE
+  void decode(const RawGkcPacket & raw) {decode(GkcBufferView(raw.payload));}
+#endif
+  virtual void publish(GkcPacketSubscriber & sub);
 };
 }  // namespace gkc
 }  // namespace tritonai
+
+// Packet classes and `GkcPacketTypes`, generated from schema/gkc_packets.yaml
+#include "tai_gokart_packet/generated/gkc_packet_defs.hpp"
+
+#ifdef GKC_PACKET_HEADER_ONLY
+#include "tai_gokart_packet/impl/gkc_packets.ipp"
+#endif
 #endif  // TAI_GOKART_PACKET__GKC_PACKETS_HPP_
@@ -0,0 +1,131 @@
+/**
+ * @file gkc_ring_buffer.hpp
+ * @brief Fixed-capacity byte ring buffer for incoming streams
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2026 [Triton AI]
+ *
+ */
+
+#ifndef TAI_GOKART_PACKET__GKC_RING_BUFFER_HPP_
+#define TAI_GOKART_PACKET__GKC_RING_BUFFER_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+namespace tritonai
+{
+namespace gkc
+{
+/**
+ * @brief A single-producer single-consumer byte queue with no heap allocation.
+ * Bytes are addressed relative to the oldest unread byte.
+ *
+ * @tparam N capacity in bytes, must be a power of two
+ */
+template<size_t N>
+class GkcRingBuffer
+{
+  static_assert(N && !(N & (N - 1)), "GkcRingBuffer capacity must be a power of two.");
+
+public:
+  static constexpr size_t CAPACITY = N;
+
+  /**
+   * @brief number of unread bytes
+   */
+  size_t size() const {return head_ - tail_;}
+
+  /**
+   * @brief number of bytes that can be written before the buffer is full
+   */
+  size_t space() const {return N - size();}
+
+  /**
+   * @brief Append bytes to the buffer
+   *
+   * @param data bytes to append
+   * @param len number of bytes to append
+   * @return size_t number of bytes actually appended (limited by `space()`)
+   */
+  size_t write(const uint8_t * data, const size_t & len)
+  {
+    const size_t to_write = std::min(len, space());
+    const size_t start = head_ & MASK;
+    const size_t first = std::min(to_write, N - start);
+    std::memcpy(&buf_[start], data, first);
+    std::memcpy(&buf_[0], data + first, to_write - first);
+    head_ += to_write;
+    return to_write;
+  }
+
+  /**
+   * @brief Unread byte at `offset`
+   */
+  uint8_t operator[](const size_t & offset) const {return buf_[(tail_ + offset) & MASK];}
+
+  /**
+   * @brief Find the first unread byte equal to `value`, with memchr on each contiguous segment
+   *
+   * @param value byte to look for
+   * @param offset offset to start looking from
+   * @param end offset to stop looking at
+   * @return size_t offset of the byte; `size()` if not found
+   */
+  size_t find(
+    const uint8_t & value, const size_t & offset = 0,
+    const size_t & end = SIZE_MAX) const
+  {
+    const size_t stop = std::min(end, size());
+    size_t pos = offset;
+    while (pos < stop) {
+      const size_t start = (tail_ + pos) & MASK;
+      const size_t len = std::min(stop - pos, N - start);
+      const void * found = std::memchr(&buf_[start], value, len);
+      if (found) {
+        return pos + static_cast<size_t>(static_cast<const uint8_t *>(found) - &buf_[start]);
+      }
+      pos += len;
+    }
+    return size();
+  }
+
+  /**
+   * @brief Get `len` unread bytes starting at `offset` as a contiguous range.
+   * If the range wraps around the end of the storage, it is copied into `scratch`.
+   *
+   * @param offset offset of the first byte
+   * @param len number of bytes
+   * @param scratch at least `len` bytes used when the range is not contiguous
+   * @return const uint8_t* pointer to the first byte
+   */
+  const uint8_t * view(const size_t & offset, const size_t & len, uint8_t * scratch) const
+  {
+    const size_t start = (tail_ + offset) & MASK;
+    if (start + len <= N) {
+      return &buf_[start];
+    }
+    const size_t first = N - start;
+    std::memcpy(scratch, &buf_[start], first);
+    std::memcpy(scratch + first, &buf_[0], len - first);
+    return scratch;
+  }
+
+  /**
+   * @brief Mark `len` bytes as read
+   */
+  void consume(const size_t & len) {tail_ += std::min(len, size());}
+
+  void clear() {tail_ = head_;}
+
+private:
+  static constexpr size_t MASK = N - 1;
+  std::array<uint8_t, N> buf_ {};
+  size_t head_ = 0;
+  size_t tail_ = 0;
+};
+}  // namespace gkc
+}  // namespace tritonai
+#endif  // TAI_GOKART_PACKET__GKC_RING_BUFFER_HPP_
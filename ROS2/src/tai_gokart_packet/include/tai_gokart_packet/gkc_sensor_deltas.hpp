@@ -0,0 +1,120 @@
+/**
+ * @file gkc_sensor_deltas.hpp
+ * @brief Keyframe and delta streaming of sensor values
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2026 [Triton AI]
+ *
+ */
+
+#ifndef TAI_GOKART_PACKET__GKC_SENSOR_DELTAS_HPP_
+#define TAI_GOKART_PACKET__GKC_SENSOR_DELTAS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "tai_gokart_packet/gkc_packets.hpp"
+
+namespace tritonai
+{
+namespace gkc
+{
+/**
+ * @brief Sender side (MCU) of delta sensor streaming.
+ *
+ * Every `keyframe_interval` packets, or after `request_keyframe()`, the packet is a keyframe
+ * with every field. The packets in between only carry the fields that differ from the last
+ * keyframe, so that a lost delta does not affect the next ones.
+ */
+class GkcSensorDeltaEncoder
+{
+public:
+  typedef SensorGkcPacket::SensorValues Values;
+
+  explicit GkcSensorDeltaEncoder(const size_t & keyframe_interval = 50)
+  : keyframe_interval_(keyframe_interval ? keyframe_interval : 1) {}
+
+  /**
+   * @brief Encode the latest sensor values
+   *
+   * @param values sensor values to send
+   * @return const SensorDeltaGkcPacket& packet to send, valid until the next call
+   */
+  const SensorDeltaGkcPacket & next(const Values & values)
+  {
+    packet_.values = values;
+    if (since_keyframe_ == 0) {
+      ++packet_.keyframe_id;
+      packet_.changed = SensorDeltaGkcPacket::ALL_FIELDS | SensorDeltaGkcPacket::KEYFRAME;
+      keyframe_ = values;
+    } else {
+      packet_.set_changes(keyframe_);
+    }
+    since_keyframe_ = (since_keyframe_ + 1) % keyframe_interval_;
+    return packet_;
+  }
+
+  /**
+   * @brief Make the next packet a keyframe, e.g. after a `SensorResyncGkcPacket`
+   */
+  void request_keyframe() {since_keyframe_ = 0;}
+
+private:
+  size_t keyframe_interval_;
+  size_t since_keyframe_ = 0;
+  Values keyframe_ {};
+  SensorDeltaGkcPacket packet_ {};
+};
+
+/**
+ * @brief Receiver side (PC) of delta sensor streaming: rebuilds the full sensor values
+ */
+class GkcSensorDeltaDecoder
+{
+public:
+  typedef SensorGkcPacket::SensorValues Values;
+
+  enum class Result
+  {
+    Updated,  // `values()` holds the values of the packet
+    Resync,  // the keyframe of the packet is missing; send a `SensorResyncGkcPacket`
+    Pending  // still missing the keyframe, a resync was already requested
+  };
+
+  Result apply(const SensorDeltaGkcPacket & packet)
+  {
+    if (packet.changed & SensorDeltaGkcPacket::KEYFRAME) {
+      packet.apply_to(keyframe_);
+      keyframe_id_ = packet.keyframe_id;
+      has_keyframe_ = true;
+      resync_requested_ = false;
+    } else if (!has_keyframe_ || packet.keyframe_id != keyframe_id_) {
+      // Request once per keyframe, not for every delta that refers to it
+      const bool request = !resync_requested_ || packet.keyframe_id != resync_keyframe_id_;
+      resync_requested_ = true;
+      resync_keyframe_id_ = packet.keyframe_id;
+      ++num_dropped_;
+      return request ? Result::Resync : Result::Pending;
+    }
+    values_ = keyframe_;
+    packet.apply_to(values_);
+    return Result::Updated;
+  }
+
+  const Values & values() const {return values_;}
+  uint8_t keyframe_id() const {return keyframe_id_;}
+  // Number of deltas dropped because their keyframe was missing
+  size_t num_dropped() const {return num_dropped_;}
+
+private:
+  Values keyframe_ {};
+  Values values_ {};
+  uint8_t keyframe_id_ = 0;
+  bool has_keyframe_ = false;
+  bool resync_requested_ = false;
+  uint8_t resync_keyframe_id_ = 0;
+  size_t num_dropped_ = 0;
+};
+}  // namespace gkc
+}  // namespace tritonai
+#endif  // TAI_GOKART_PACKET__GKC_SENSOR_DELTAS_HPP_
@@ -0,0 +1,172 @@
+/**
+ * @file gkc_framer.ipp
+ * @brief
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2026 [Triton AI]
+ *
+ */
+
+#ifndef TAI_GOKART_PACKET__IMPL__GKC_FRAMER_IPP_
+#define TAI_GOKART_PACKET__IMPL__GKC_FRAMER_IPP_
+
+#include "tai_gokart_packet/gkc_framer.hpp"
+#include <algorithm>
+#include <cstring>
+namespace tritonai
+{
+namespace gkc
+{
+GKC_PACKET_INLINE GkcFramer::GkcFramer(GkcDebugCallback debug)
+: debug_(debug)
+{
+}
+
+GKC_PACKET_INLINE size_t GkcFramer::push(const uint8_t * data, const size_t & size)
+{
+  return ring_.write(data, size);
+}
+
+GKC_PACKET_INLINE bool GkcFramer::next(GkcBufferView & payload)
+{
+  return get_framing() == GkcFraming::Cobs ? next_cobs(payload) : next_legacy(payload);
+}
+
+GKC_PACKET_INLINE bool GkcFramer::next_legacy(GkcBufferView & payload)
+{
+  while (true) {
+    // Look for the start byte, or an extended start byte before it
+    size_t start_idx = ring_.find(GkcFrameFormat::START_BYTE);
+    if (get_extended_frames()) {
+      start_idx = std::min(
+        start_idx, ring_.find(GkcFrameFormat::EXTENDED_START_BYTE, 0, start_idx));
+    }
+    stats_.bytes_discarded += start_idx;
+    ring_.consume(start_idx);
+
+    // Are there enough bytes to form a packet?
+    if (ring_.size() < GkcFrameFormat::MIN_FRAME_SIZE) {
+      return false;
+    }
+    const bool extended = ring_[0] == GkcFrameFormat::EXTENDED_START_BYTE;
+    size_t payload_size = ring_[1];
+    size_t header_size = GkcFrameFormat::NUM_BYTES_BEFORE_PAYLOAD;
+    if (extended) {
+      payload_size |= static_cast<size_t>(ring_[2]) << 8;
+      header_size = GkcFrameFormat::NUM_BYTES_BEFORE_EXTENDED_PAYLOAD;
+      // Shorter payloads use standard frames. Checked before waiting for the rest of the
+      // frame, so that a bad size cannot hold up the stream.
+      if (payload_size <= GkcFrameFormat::MAX_PAYLOAD_SIZE ||
+        payload_size > GkcFrameFormat::MAX_EXTENDED_PAYLOAD_SIZE)
+      {
+        debug_("Packet malformed. Potentially out-of-sync.");
+        ++stats_.malformed;
+        resync();
+        continue;
+      }
+    }
+    const size_t frame_size = header_size + payload_size + sizeof(uint16_t) + 1;
+    if (ring_.size() < frame_size) {
+      // Need more bytes to complete a packet. Wait for the next push.
+      return false;
+    }
+
+    // Check packet completeness
+    if (ring_[frame_size - 1] != GkcFrameFormat::END_BYTE ||
+      payload_size < GkcFrameFormat::MIN_PAYLOAD_SIZE)
+    {
+      debug_("Packet malformed. Potentially out-of-sync.");
+      ++stats_.malformed;
+      resync();
+      continue;
+    }
+
+    // Find payload and checksum
+    const uint8_t * payload_start = ring_.view(header_size, payload_size, scratch_.data());
+    const size_t checksum_idx = header_size + payload_size;
+    const uint8_t checksum_bytes[sizeof(uint16_t)] = {ring_[checksum_idx], ring_[checksum_idx + 1]};
+    uint16_t checksum = 0;
+    std::memcpy(&checksum, checksum_bytes, sizeof(checksum));
+    if (GkcPacketUtils::calc_crc16(payload_start, payload_size) != checksum) {
+      // A valid frame may start inside this one. Only skip the start byte.
+      debug_("Possible packet corruption. Dropping packet.");
+      ++stats_.checksum_errors;
+      resync();
+      continue;
+    }
+
+    // The frame leaves the ring. Its bytes stay in place until the next push.
+    ring_.consume(frame_size);
+    payload = GkcBufferView(payload_start, payload_size);
+    return true;
+  }
+}
+
+GKC_PACKET_INLINE bool GkcFramer::next_cobs(GkcBufferView & payload)
+{
+  static constexpr size_t MIN_DECODED_SIZE = GkcFrameFormat::MIN_PAYLOAD_SIZE + sizeof(uint16_t);
+  const size_t max_decoded_size = (get_extended_frames() ?
+    GkcFrameFormat::MAX_EXTENDED_PAYLOAD_SIZE : GkcFrameFormat::MAX_PAYLOAD_SIZE) +
+    sizeof(uint16_t);
+  const size_t max_encoded_size = GkcCobs::max_encoded_size(max_decoded_size);
+
+  while (true) {
+    const size_t encoded_size = ring_.find(GkcCobs::DELIMITER);
+    if (encoded_size == ring_.size()) {
+      if (encoded_size > max_encoded_size) {
+        // Too long to be a frame. Drop it and recover at the next delimiter.
+        debug_("Packet malformed. Potentially out-of-sync.");
+        ++stats_.malformed;
+        ++stats_.resyncs;
+        discard(encoded_size);
+      }
+      return false;
+    }
+    if (encoded_size == 0) {
+      // Idle delimiters between frames
+      ring_.consume(1);
+      continue;
+    }
+
+    const size_t decoded_size = encoded_size <= max_encoded_size ?
+      GkcCobs::decode(ring_, encoded_size, scratch_.data()) : 0;
+    if (decoded_size < MIN_DECODED_SIZE || decoded_size > max_decoded_size) {
+      debug_("Packet malformed. Potentially out-of-sync.");
+      ++stats_.malformed;
+      ++stats_.resyncs;
+      discard(encoded_size + 1);
+      continue;
+    }
+
+    const size_t payload_size = decoded_size - sizeof(uint16_t);
+    uint16_t checksum = 0;
+    GkcPacketUtils::read_from_buffer(scratch_.data() + payload_size, checksum);
+    if (GkcPacketUtils::calc_crc16(scratch_.data(), payload_size) != checksum) {
+      debug_("Possible packet corruption. Dropping packet.");
+      ++stats_.checksum_errors;
+      ++stats_.resyncs;
+      discard(encoded_size + 1);
+      continue;
+    }
+
+    ring_.consume(encoded_size + 1);
+    payload = GkcBufferView(scratch_.data(), payload_size);
+    return true;
+  }
+}
+
+GKC_PACKET_INLINE void GkcFramer::discard(const size_t & size)
+{
+  ring_.consume(size);
+  stats_.bytes_discarded += size;
+}
+
+GKC_PACKET_INLINE void GkcFramer::resync()
+{
+  ring_.consume(1);
+  ++stats_.resyncs;
+  ++stats_.bytes_discarded;
+}
+}  // namespace gkc
+}  // namespace tritonai
+#endif  // TAI_GOKART_PACKET__IMPL__GKC_FRAMER_IPP_
@@ -0,0 +1,119 @@
+/**
+ * @file gkc_logs.ipp
+ * @brief Expansion of logs sent by ID
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2026 [Triton AI]
+ *
+ */
+
+#ifndef TAI_GOKART_PACKET__IMPL__GKC_LOGS_IPP_
+#define TAI_GOKART_PACKET__IMPL__GKC_LOGS_IPP_
+#include "tai_gokart_packet/gkc_logs.hpp"
+#ifndef GKC_PACKET_MCU_PROFILE
+#include <cstdio>
+#include <cstring>
+#include <string>
+#endif
+namespace tritonai
+{
+namespace gkc
+{
+#ifndef GKC_PACKET_MCU_PROFILE
+GKC_PACKET_INLINE LogPacket GkcLogTable::expand(const LogIdGkcPacket & packet)
+{
+  static_assert(
+    static_cast<int>(LogIdGkcPacket::FATAL) == static_cast<int>(LogPacket::FATAL),
+    "LogIdGkcPacket and LogPacket must have the same levels.");
+  auto log = LogPacket();
+  log.level = static_cast<LogPacket::Severity>(packet.level);
+  const auto format = find(packet.id);
+  if (!format) {
+    log.what = "Unknown log ID " + std::to_string(packet.id) + " with " +
+      std::to_string(packet.args.size()) + " bytes of arguments.";
+    return log;
+  }
+
+  // The schema makes sure every conversion matches its argument
+  size_t arg = 0;
+  size_t offset = 0;
+  for (const char * c = format->format; *c; ++c) {
+    if (*c != '%') {
+      log.what += *c;
+      continue;
+    }
+    if (c[1] == '%') {
+      log.what += '%';
+      ++c;
+      continue;
+    }
+    const size_t length = std::strspn(c + 1, "-+ #0123456789.") + 2;
+    const auto conversion = std::string(c, length);
+    c += length - 1;
+    if (arg >= format->num_args ||
+      !format_arg(format->args[arg++], conversion, packet.args, offset, log.what))
+    {
+      log.what += "<missing>";
+    }
+  }
+  return log;
+}
+
+// Print one argument with `conversion` (e.g. "%.1f"), or return false if it is missing
+GKC_PACKET_INLINE bool GkcLogTable::format_arg(
+  const GkcLogArg & type, const std::string & conversion,
+  const LogIdGkcPacket::Bytes & args, size_t & offset, std::string & text)
+{
+  char buffer[64];
+  if (type == GkcLogArg::Float) {
+    float value;
+    if (!read_arg(args, offset, value)) {
+      return false;
+    }
+    std::snprintf(buffer, sizeof(buffer), conversion.c_str(), static_cast<double>(value));
+  } else if (type == GkcLogArg::Bool) {
+    bool value;
+    if (!read_arg(args, offset, value)) {
+      return false;
+    }
+    std::snprintf(buffer, sizeof(buffer), conversion.c_str(), value ? "true" : "false");
+  } else {
+    // Every integer is printed as a long long, whatever its type on the wire
+    long long value = 0;  // NOLINT(runtime/int)
+    bool read = false;
+    switch (type) {
+      case GkcLogArg::UInt8:
+        read = read_integer<uint8_t>(args, offset, value);
+        break;
+      case GkcLogArg::UInt16:
+        read = read_integer<uint16_t>(args, offset, value);
+        break;
+      case GkcLogArg::UInt32:
+        read = read_integer<uint32_t>(args, offset, value);
+        break;
+      case GkcLogArg::Int8:
+        read = read_integer<int8_t>(args, offset, value);
+        break;
+      case GkcLogArg::Int16:
+        read = read_integer<int16_t>(args, offset, value);
+        break;
+      case GkcLogArg::Int32:
+        read = read_integer<int32_t>(args, offset, value);
+        break;
+      default:
+        break;
+    }
+    if (!read) {
+      return false;
+    }
+    auto with_length = conversion;
+    with_length.insert(with_length.size() - 1, "ll");
+    std::snprintf(buffer, sizeof(buffer), with_length.c_str(), value);
+  }
+  text += buffer;
+  return true;
+}
+#endif
+}  // namespace gkc
+}  // namespace tritonai
+#endif  // TAI_GOKART_PACKET__IMPL__GKC_LOGS_IPP_
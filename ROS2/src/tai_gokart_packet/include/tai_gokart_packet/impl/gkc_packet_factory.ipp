@@ -0,0 +1,171 @@
+/**
+ * @file gkc_packet_factory.ipp
+ * @author Haoru Xue (hxue@ucsd.edu)
+ * @brief
+ * @version 0.1
+ * @date 2021-11-03
+ *
+ * @copyright Copyright (c) 2021 [Triton AI]
+ *
+ */
+
+#ifndef TAI_GOKART_PACKET__IMPL__GKC_PACKET_FACTORY_IPP_
+#define TAI_GOKART_PACKET__IMPL__GKC_PACKET_FACTORY_IPP_
+
+#include "tai_gokart_packet/gkc_packet_factory.hpp"
+#include <array>
+#include <algorithm>
+#include <type_traits>
+#ifndef GKC_PACKET_MCU_PROFILE
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#endif
+namespace tritonai
+{
+namespace gkc
+{
+namespace detail
+{
+typedef void (* Dispatcher)(
+  const GkcBufferView & payload, GkcPacketFactory::PacketPools & pools,
+  GkcPacketSubscriber & sub);
+
+/**
+ * @brief Shortest payload a packet decodes from: `PAYLOAD_SIZE`, or `MIN_PAYLOAD_SIZE` for
+ * packets with a variable-size tail
+ */
+template<typename T, typename = void>
+struct MinPayloadSize : std::integral_constant<size_t, T::PAYLOAD_SIZE> {};
+template<typename T>
+struct MinPayloadSize<T, std::void_t<decltype(T::MIN_PAYLOAD_SIZE)>>
+  : std::integral_constant<size_t, T::MIN_PAYLOAD_SIZE> {};
+
+struct DispatchEntry
+{
+  Dispatcher dispatch = nullptr;
+  size_t min_payload_size = 0;
+};
+typedef std::array<DispatchEntry, 256> DispatchTable;
+
+/**
+ * @brief Offer the frame as a view if the packet has one, then decode into a pooled packet
+ * and hand it to the matching callback. Falls back to a packet on the stack if the pool
+ * is exhausted. `Receive()` has checked that the payload is long enough for `T`.
+ */
+template<typename T>
+void dispatch(
+  const GkcBufferView & payload, GkcPacketFactory::PacketPools & pools,
+  GkcPacketSubscriber & sub)
+{
+  typedef typename GkcPacketViewOf<T>::type View;
+  if constexpr (!std::is_void_v<View>) {
+    if (sub.packet_view_callback(View(payload))) {
+      return;
+    }
+  }
+  auto packet = pools.acquire<T>();
+  if (!packet) {
+    T fallback {};
+    fallback.decode(payload);
+    sub.packet_callback(fallback);
+    return;
+  }
+  packet->decode(payload);
+  sub.packet_callback(*packet);
+}
+
+template<typename ... Ts>
+constexpr DispatchTable make_dispatch_table(GkcPacketTypeList<Ts...>)
+{
+  DispatchTable table {};
+  ((table[Ts::FIRST_BYTE] = DispatchEntry {&dispatch<Ts>, MinPayloadSize<Ts>::value}), ...);
+  return table;
+}
+
+template<typename ... Ts>
+constexpr bool first_bytes_unique(GkcPacketTypeList<Ts...>)
+{
+  const uint8_t first_bytes[] = {Ts::FIRST_BYTE ...};
+  for (size_t i = 0; i < sizeof...(Ts); ++i) {
+    for (size_t j = i + 1; j < sizeof...(Ts); ++j) {
+      if (first_bytes[i] == first_bytes[j]) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+static_assert(first_bytes_unique(GkcPacketTypes()), "Two packets share the same first byte.");
+inline constexpr DispatchTable DISPATCH_TABLE = make_dispatch_table(GkcPacketTypes());
+}  // namespace detail
+
+GKC_PACKET_INLINE GkcPacketFactory::GkcPacketFactory(
+  GkcPacketSubscriber * sub,
+  GkcDebugCallback debug)
+: _framer(debug)
+{
+  this->_debug = debug;
+  this->_sub = sub;
+}
+
+GKC_PACKET_INLINE void GkcPacketFactory::Receive(const GkcBufferView & buffer)
+{
+  const uint8_t * data = buffer.data();
+  size_t remaining = buffer.size();
+  do {
+    const auto num_pushed = _framer.push(data, remaining);
+    data += num_pushed;
+    remaining -= num_pushed;
+
+    // Publish every complete packet in the buffer
+    GkcBufferView payload;
+    while (_framer.next(payload)) {
+      const auto & entry = detail::DISPATCH_TABLE[payload[0]];
+      if (!entry.dispatch) {
+        ++_stats.unknown_first_byte;
+        _debug("Unknown packet first byte. Dropping packet.");
+        continue;
+      }
+      if (payload.size() < entry.min_payload_size) {
+        // The CRC matched, but decoding would read past the payload
+        ++_stats.undersized_payload;
+        _debug("Payload too short for its packet type. Dropping packet.");
+        continue;
+      }
+      entry.dispatch(payload, _pools, *(this->_sub));
+      ++_stats.packets_received;
+    }
+  } while (remaining);
+}
+
+#ifndef GKC_PACKET_MCU_PROFILE
+GKC_PACKET_INLINE std::shared_ptr<std::vector<uint8_t>> GkcPacketFactory::Send(
+  const GkcPacket::SharedPtr & packet)
+{
+  return Send(*packet);
+}
+GKC_PACKET_INLINE std::shared_ptr<std::vector<uint8_t>> GkcPacketFactory::Send(
+  const GkcPacket & packet)
+{
+  auto buffer = std::make_shared<std::vector<uint8_t>>(GkcFrameFormat::MAX_EXTENDED_FRAME_SIZE);
+  const auto frame_size = Send(packet, GkcMutableBufferView(buffer->data(), buffer->size()));
+  if (!frame_size) {
+    throw std::length_error("Packet is too long for an extended frame.");
+  }
+  buffer->resize(frame_size);
+  return buffer;
+}
+#endif
+
+GKC_PACKET_INLINE size_t GkcPacketFactory::Send(
+  const GkcPacket & packet,
+  const GkcMutableBufferView & buffer)
+{
+  return packet.encode_into(buffer, _framer.get_framing());
+}
+}  // namespace gkc
+}  // namespace tritonai
+#endif  // TAI_GOKART_PACKET__IMPL__GKC_PACKET_FACTORY_IPP_
@@ -0,0 +1,145 @@
+/**
+ * @file gkc_packets.ipp
+ * @author Haoru Xue (hxue@ucsd.edu)
+ * @brief Packet structures
+ * @version 0.1
+ * @date 2021-10-30
+ *
+ * @copyright Copyright (c) 2021 [Triton AI]
+ *
+ */
+
+#ifndef TAI_GOKART_PACKET__IMPL__GKC_PACKETS_IPP_
+#define TAI_GOKART_PACKET__IMPL__GKC_PACKETS_IPP_
+#include "tai_gokart_packet/gkc_packets.hpp"
+#include <algorithm>
+#include <array>
+#ifndef GKC_PACKET_MCU_PROFILE
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#endif
+namespace tritonai
+{
+namespace gkc
+{
+#ifndef GKC_PACKET_MCU_PROFILE
+GKC_PACKET_INLINE RawGkcPacket::RawGkcPacket()
+: payload_size(0), checksum(0), payload(GkcBuffer()) {}
+
+GKC_PACKET_INLINE RawGkcPacket::RawGkcPacket(const GkcBuffer & payload)
+: payload_size(static_cast<uint8_t>(payload.size())),
+  checksum(GkcPacketUtils::calc_crc16(payload)),
+  payload(payload) {}
+
+GKC_PACKET_INLINE std::shared_ptr<GkcBuffer> RawGkcPacket::encode()
+{
+  auto buffer = std::make_unique<GkcBuffer>(payload_size + NUM_NON_PAYLOAD_BYTES, 0);
+  auto pos_payload_size =
+    GkcPacketUtils::write_to_buffer(buffer->begin(), static_cast<uint8_t>(START_BYTE));
+  auto pos_payload = GkcPacketUtils::write_to_buffer(pos_payload_size, payload_size);
+  auto pos_checksum = std::copy(payload.begin(), payload.end(), pos_payload);
+  auto pos_end_byte = GkcPacketUtils::write_to_buffer(pos_checksum, checksum);
+  auto pos_end = GkcPacketUtils::write_to_buffer(pos_end_byte, static_cast<uint8_t>(END_BYTE));
+  if (pos_end != buffer->end()) {
+    // Sanity check: encoding should use the entire buffer
+    throw std::runtime_error(
+            "Error when encoding raw gkc packet. Potential payload size mismatch.");
+  }
+  return buffer;
+}
+
+GKC_PACKET_INLINE RawGkcPacket::SharedPtr GkcPacket::encode() const
+{
+  if (payload_size() > GkcFrameFormat::MAX_PAYLOAD_SIZE) {
+    throw std::length_error("Extended payloads can only be encoded with encode_into().");
+  }
+  GkcBuffer payload = GkcBuffer(payload_size(), 0);
+  encode_payload(payload.data());
+  return std::make_shared<RawGkcPacket>(payload);
+}
+
+GKC_PACKET_INLINE void GkcPacketUtils::debug_cout(std::string str)
+{
+  std::cout << str << std::endl;
+}
+#endif
+
+GKC_PACKET_INLINE GkcPacket::~GkcPacket()
+{
+}
+
+GKC_PACKET_INLINE size_t GkcPacket::encode_into(
+  const GkcMutableBufferView & frame,
+  const GkcFraming & framing) const
+{
+  const size_t payload_size = this->payload_size();
+  if (payload_size < GkcFrameFormat::MIN_PAYLOAD_SIZE ||
+    payload_size > GkcFrameFormat::MAX_EXTENDED_PAYLOAD_SIZE)
+  {
+    return 0;
+  }
+
+  if (framing == GkcFraming::Cobs) {
+    const size_t raw_size = payload_size + sizeof(uint16_t);
+    const size_t max_encoded_size = GkcCobs::max_encoded_size(raw_size);
+    if (frame.size() < max_encoded_size + 1) {
+      return 0;
+    }
+    // Payload and checksum go to the end of the encoded range and are encoded in place
+    uint8_t * raw = frame.data() + max_encoded_size - raw_size;
+    encode_payload(raw);
+    GkcPacketUtils::write_to_buffer(raw + payload_size, GkcCrc16::compute(raw, payload_size));
+    const size_t encoded_size = GkcCobs::encode(raw, raw_size, frame.data());
+    frame[encoded_size] = GkcCobs::DELIMITER;
+    return encoded_size + 1;
+  }
+
+  const bool extended = payload_size > GkcFrameFormat::MAX_PAYLOAD_SIZE;
+  const size_t frame_size = payload_size + (extended ?
+    GkcFrameFormat::NUM_NON_EXTENDED_PAYLOAD_BYTES : GkcFrameFormat::NUM_NON_PAYLOAD_BYTES);
+  if (frame.size() < frame_size) {
+    return 0;
+  }
+  uint8_t * payload = frame.data();
+  if (extended) {
+    frame[0] = GkcFrameFormat::EXTENDED_START_BYTE;
+    payload = GkcPacketUtils::write_to_buffer(payload + 1, static_cast<uint16_t>(payload_size));
+  } else {
+    frame[0] = GkcFrameFormat::START_BYTE;
+    frame[1] = static_cast<uint8_t>(payload_size);
+    payload += GkcFrameFormat::NUM_BYTES_BEFORE_PAYLOAD;
+  }
+  encode_payload(payload);
+  auto pos_end_byte = GkcPacketUtils::write_to_buffer(
+    payload + payload_size, GkcCrc16::compute(payload, payload_size));
+  *pos_end_byte = GkcFrameFormat::END_BYTE;
+  return frame_size;
+}
+
+GKC_PACKET_INLINE size_t GkcPacket::payload_size() const
+{
+  return 0;
+}
+
+GKC_PACKET_INLINE void GkcPacket::encode_payload(uint8_t * payload) const
+{
+  (void)payload;
+}
+
+GKC_PACKET_INLINE void GkcPacket::decode(const GkcBufferView & payload)
+{
+  (void)payload;
+}
+
+GKC_PACKET_INLINE void GkcPacket::publish(GkcPacketSubscriber & sub)
+{
+  (void)sub;
+}
+}  // namespace gkc
+}  // namespace tritonai
+
+// Codecs of the packet classes, generated from schema/gkc_packets.yaml
+#include "tai_gokart_packet/generated/gkc_packet_defs.ipp"
+#endif  // TAI_GOKART_PACKET__IMPL__GKC_PACKETS_IPP_
@@ -0,0 +1,13 @@
+/**
+ * @file gkc_framer.cpp
+ * @brief Compiled implementation; with GKC_PACKET_HEADER_ONLY the header includes it instead
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2026 [Triton AI]
+ *
+ */
+
+#include "tai_gokart_packet/gkc_framer.hpp"
+#ifndef GKC_PACKET_HEADER_ONLY
+#include "tai_gokart_packet/impl/gkc_framer.ipp"
+#endif
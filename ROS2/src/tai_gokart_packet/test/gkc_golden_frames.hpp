@@ -0,0 +1,210 @@
+/**
+ * @file gkc_golden_frames.hpp
+ * @brief Reference frames shared by the tests of every build profile
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2026 [Triton AI]
+ *
+ */
+
+#ifndef GKC_GOLDEN_FRAMES_HPP_
+#define GKC_GOLDEN_FRAMES_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "tai_gokart_packet/gkc_logs.hpp"
+#include "tai_gokart_packet/gkc_packets.hpp"
+
+namespace gkc_golden
+{
+/**
+ * @brief Call `visit` with one packet of every type, in the order of `FRAMES`.
+ * Only uses members common to all build profiles.
+ */
+template<typename Visitor>
+void visit_packets(Visitor && visit)
+{
+  using namespace tritonai::gkc;  // NOLINT(build/namespaces)
+  auto handshake1 = Handshake1GkcPacket();
+  handshake1.seq_number = 0x12345678;
+  visit(handshake1);
+  auto handshake2 = Handshake2GkcPacket();
+  handshake2.seq_number = 0x12345679;
+  visit(handshake2);
+  auto get_firmware = GetFirmwareVersionGkcPacket();
+  visit(get_firmware);
+  auto firmware = FirmwareVersionGkcPacket();
+  firmware.major = 1;
+  firmware.minor = 2;
+  firmware.patch = 3;
+  visit(firmware);
+  auto reset = ResetMcuGkcPacket();
+  reset.magic_number = 0xDEADBEEF;
+  visit(reset);
+  auto heartbeat = HeartbeatGkcPacket();
+  heartbeat.rolling_counter = 7;
+  heartbeat.state = 3;
+  visit(heartbeat);
+  auto config = ConfigGkcPacket();
+  config.values = {};
+  config.values.max_steering_left = 0.5f;
+  config.values.max_steering_right = -0.5f;
+  config.values.max_throttle = 1.0f;
+  config.values.max_brake = 120.0f;
+  config.values.control_timeout_ms = 100;
+  config.values.comm_timeout_ms = 200;
+  config.values.sensor_timeout_ms = 50;
+  visit(config);
+  auto state = StateTransitionGkcPacket();
+  state.requested_state = 2;
+  visit(state);
+  auto control = ControlGkcPacket();
+  control.throttle = 0.25f;
+  control.steering = -0.1f;
+  control.brake = 80.0f;
+  visit(control);
+  auto sensor = SensorGkcPacket();
+  sensor.values = {};
+  sensor.values.wheel_speed_fl = 100.5f;
+  sensor.values.wheel_speed_rr = 99.25f;
+  sensor.values.voltage = 48.2f;
+  sensor.values.steering_angle_rad = 0.1f;
+  sensor.values.fault_steering = true;
+  sensor.values.fault_info = true;
+  visit(sensor);
+  auto shutdown1 = Shutdown1GkcPacket();
+  shutdown1.seq_number = 42;
+  visit(shutdown1);
+  auto shutdown2 = Shutdown2GkcPacket();
+  shutdown2.seq_number = 43;
+  visit(shutdown2);
+  auto log = LogPacket();
+  log.level = LogPacket::Severity::WARNING;
+  log.what = "Hello World";
+  visit(log);
+  visit(CompactSensorGkcPacket(sensor));
+  visit(CompactControlGkcPacket(control));
+  auto delta = SensorDeltaGkcPacket();
+  delta.keyframe_id = 5;
+  delta.values = sensor.values;
+  delta.values.wheel_speed_fl = 101.0f;
+  delta.set_changes(sensor.values);
+  visit(delta);
+  auto resync = SensorResyncGkcPacket();
+  resync.keyframe_id = 4;
+  visit(resync);
+  auto batch = SensorBatchGkcPacket();
+  batch.timestamp_us = 1000000;
+  batch.num_samples = 2;
+  batch.samples[0] = {0, sensor.values};
+  batch.samples[1] = {1000, delta.values};
+  visit(batch);
+  auto request = BulkRequestGkcPacket();
+  request.resource = 0x0102;
+  visit(request);
+  auto start = BulkStartGkcPacket();
+  start.transfer_id = 3;
+  start.resource = 0x0102;
+  start.total_size = 10;
+  start.chunk_size = 8;
+  start.window = 16;
+  start.crc = 0x456E3E5E;
+  visit(start);
+  auto chunk = BulkChunkGkcPacket();
+  chunk.transfer_id = 3;
+  chunk.seq = 1;
+  chunk.data.push_back(0x00);
+  chunk.data.push_back(0x03);
+  visit(chunk);
+  auto ack = BulkAckGkcPacket();
+  ack.transfer_id = 3;
+  ack.next_seq = 2;
+  ack.status = BulkAckGkcPacket::COMPLETE;
+  visit(ack);
+  visit(GkcLogs::brake_fault(2100.0f));
+  auto log_filter = LogFilterGkcPacket();
+  log_filter.min_level = LogFilterGkcPacket::WARNING;
+  log_filter.max_logs_per_second = 20;
+  visit(log_filter);
+}
+
+struct Frame
+{
+  const char * name;
+  size_t size;
+  uint8_t bytes[tritonai::gkc::GkcFrameFormat::MAX_FRAME_SIZE];
+};
+
+// Encoded by the PC profile. Every profile must reproduce them byte for byte.
+inline constexpr Frame FRAMES[] = {
+  {"Handshake1", 10, {
+      0x02, 0x05, 0x04, 0x78, 0x56, 0x34, 0x12, 0xFC, 0x59, 0x03}},
+  {"Handshake2", 10, {
+      0x02, 0x05, 0x05, 0x79, 0x56, 0x34, 0x12, 0x19, 0x85, 0x03}},
+  {"GetFirmwareVersion", 6, {
+      0x02, 0x01, 0x06, 0xC6, 0x60, 0x03}},
+  {"FirmwareVersion", 9, {
+      0x02, 0x04, 0x07, 0x01, 0x02, 0x03, 0x1C, 0x30, 0x03}},
+  {"ResetMcu", 10, {
+      0x02, 0x05, 0xFF, 0xEF, 0xBE, 0xAD, 0xDE, 0xC4, 0xAE, 0x03}},
+  {"Heartbeat", 8, {
+      0x02, 0x03, 0xAA, 0x07, 0x03, 0xA9, 0xD3, 0x03}},
+  {"Config", 54, {
+      0x02, 0x31, 0xA0, 0x00, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x00, 0xBF, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x3F, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0xF0, 0x42, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x64, 0x00, 0x00, 0x00, 0xC8, 0x00, 0x00, 0x00, 0x32,
+      0x00, 0x00, 0x00, 0x5C, 0x1A, 0x03}},
+  {"StateTransition", 7, {
+      0x02, 0x02, 0xA1, 0x02, 0x0D, 0x0E, 0x03}},
+  {"Control", 18, {
+      0x02, 0x0D, 0xAB, 0x00, 0x00, 0x80, 0x3E, 0xCD, 0xCC, 0xCC, 0xBD, 0x00,
+      0x00, 0xA0, 0x42, 0x52, 0x89, 0x03}},
+  {"Sensor", 53, {
+      0x02, 0x30, 0xAC, 0x00, 0x00, 0xC9, 0x42, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x80, 0xC6, 0x42, 0xCD, 0xCC, 0x40, 0x42, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xCD,
+      0xCC, 0xCC, 0x3D, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00,
+      0x00, 0x01, 0x1C, 0xCC, 0x03}},
+  {"Shutdown1", 10, {
+      0x02, 0x05, 0xA2, 0x2A, 0x00, 0x00, 0x00, 0x02, 0x31, 0x03}},
+  {"Shutdown2", 10, {
+      0x02, 0x05, 0xA3, 0x2B, 0x00, 0x00, 0x00, 0xE7, 0xED, 0x03}},
+  {"Log", 18, {
+      0x02, 0x0D, 0xAD, 0x01, 0x48, 0x65, 0x6C, 0x6C, 0x6F, 0x20, 0x57, 0x6F,
+      0x72, 0x6C, 0x64, 0x03, 0x49, 0x03}},
+  {"CompactSensor", 27, {
+      0x02, 0x16, 0xAE, 0xED, 0x03, 0x00, 0x00, 0x00, 0x00, 0xE1, 0x03, 0xD4,
+      0x12, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE8, 0x03, 0x00, 0x00, 0x44,
+      0x9B, 0x56, 0x03}},
+  {"CompactControl", 12, {
+      0x02, 0x07, 0xAF, 0xC4, 0x09, 0x18, 0xFC, 0x20, 0x03, 0xD9, 0x61, 0x03}},
+  {"SensorDelta", 11, {
+      0x02, 0x06, 0xB0, 0x05, 0x01, 0x00, 0xF2, 0x03, 0x8F, 0xEB, 0x03}},
+  {"SensorResync", 7, {
+      0x02, 0x02, 0xB1, 0x04, 0xB8, 0x6D, 0x03}},
+  {"SensorBatch", 57, {
+      0x02, 0x34, 0xB2, 0x40, 0x42, 0x0F, 0x00, 0x02, 0x00, 0x00, 0xED, 0x03,
+      0x00, 0x00, 0x00, 0x00, 0xE1, 0x03, 0xD4, 0x12, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0xE8, 0x03, 0x00, 0x00, 0x44, 0xE8, 0x03, 0xF2, 0x03, 0x00,
+      0x00, 0x00, 0x00, 0xE1, 0x03, 0xD4, 0x12, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0xE8, 0x03, 0x00, 0x00, 0x44, 0xC1, 0xEB, 0x03}},
+  {"BulkRequest", 8, {
+      0x02, 0x03, 0xB3, 0x02, 0x01, 0xEC, 0xD1, 0x03}},
+  {"BulkStart", 20, {
+      0x02, 0x0F, 0xB4, 0x03, 0x02, 0x01, 0x0A, 0x00, 0x00, 0x00, 0x08, 0x00,
+      0x10, 0x5E, 0x3E, 0x6E, 0x45, 0x65, 0xB4, 0x03}},
+  {"BulkChunk", 11, {
+      0x02, 0x06, 0xB5, 0x03, 0x01, 0x00, 0x00, 0x03, 0xA8, 0x10, 0x03}},
+  {"BulkAck", 10, {
+      0x02, 0x05, 0xB6, 0x03, 0x02, 0x00, 0x02, 0x45, 0x36, 0x03}},
+  {"LogId", 13, {
+      0x02, 0x08, 0xB7, 0x02, 0x05, 0x00, 0x00, 0x40, 0x03, 0x45, 0x38, 0x0F,
+      0x03}},
+  {"LogFilter", 9, {
+      0x02, 0x04, 0xA4, 0x01, 0x14, 0x00, 0x00, 0xD8, 0x03}},
+};
+inline constexpr size_t NUM_FRAMES = sizeof(FRAMES) / sizeof(FRAMES[0]);
+}  // namespace gkc_golden
+#endif  // GKC_GOLDEN_FRAMES_HPP_
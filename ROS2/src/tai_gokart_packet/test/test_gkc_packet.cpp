@@ -9,10 +9,30 @@
  *
  */
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
 #include "gtest/gtest.h"
 
+#include "tai_gokart_packet/gkc_crc.hpp"
+#include "tai_gokart_packet/gkc_logs.hpp"
+#include "gkc_golden_frames.hpp"
+
 #include "tai_gokart_packet/gkc_packets.hpp"
 #include "tai_gokart_packet/gkc_packet_factory.hpp"
+#include "tai_gokart_packet/gkc_bulk_transfer.hpp"
+#include "tai_gokart_packet/gkc_sensor_deltas.hpp"
+#include "tai_gokart_packet/generated/gkc_msg_conversions.hpp"
 class Sub : public tritonai::gkc::GkcPacketSubscriber
 {
 public:
@@ -28,9 +48,21 @@ public:
   void packet_callback(const tritonai::gkc::SensorGkcPacket & packet) {(void)packet;}
   void packet_callback(const tritonai::gkc::Shutdown1GkcPacket & packet) {(void)packet;}
   void packet_callback(const tritonai::gkc::Shutdown2GkcPacket & packet) {(void)packet;}
+  void packet_callback(const tritonai::gkc::CompactSensorGkcPacket & packet) {(void)packet;}
+  void packet_callback(const tritonai::gkc::CompactControlGkcPacket & packet) {(void)packet;}
+  void packet_callback(const tritonai::gkc::SensorDeltaGkcPacket & packet) {(void)packet;}
+  void packet_callback(const tritonai::gkc::SensorResyncGkcPacket & packet) {(void)packet;}
+  void packet_callback(const tritonai::gkc::SensorBatchGkcPacket & packet) {(void)packet;}
+  void packet_callback(const tritonai::gkc::LogIdGkcPacket & packet) {(void)packet;}
+  void packet_callback(const tritonai::gkc::LogFilterGkcPacket & packet) {(void)packet;}
+  void packet_callback(const tritonai::gkc::BulkRequestGkcPacket & packet) {(void)packet;}
+  void packet_callback(const tritonai::gkc::BulkStartGkcPacket & packet) {(void)packet;}
+  void packet_callback(const tritonai::gkc::BulkChunkGkcPacket & packet) {(void)packet;}
+  void packet_callback(const tritonai::gkc::BulkAckGkcPacket & packet) {(void)packet;}
   void packet_callback(const tritonai::gkc::LogPacket & packet)
   {
     (void)packet;
+    ++GkcPacketFactoryReceiveCount;
     GkcPacketFactoryReceiveTest = true;
     GkcPacketFactoryReceiveTestPacket = tritonai::gkc::LogPacket();
     GkcPacketFactoryReceiveTestPacket.level = packet.level;
@@ -38,9 +70,112 @@ public:
   }
 
   bool GkcPacketFactoryReceiveTest = false;
+  int GkcPacketFactoryReceiveCount = 0;
   tritonai::gkc::LogPacket GkcPacketFactoryReceiveTestPacket;
 };
 
+// Count every heap allocation made by this test executable.
+// Not inlined, so that GCC does not pair malloc() and free() across the replacements.
+static std::atomic<size_t> g_num_allocations {0};
+__attribute__((noinline)) void * operator new(std::size_t size)
+{
+  ++g_num_allocations;
+  if (void * ptr = std::malloc(size ? size : 1)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+__attribute__((noinline)) void operator delete(void * ptr) noexcept {std::free(ptr);}
+__attribute__((noinline)) void operator delete(void * ptr, std::size_t) noexcept {std::free(ptr);}
+
+class CountingSub : public Sub
+{
+public:
+  void packet_callback(const tritonai::gkc::SensorGkcPacket & packet)
+  {
+    (void)packet;
+    ++count;
+  }
+  void packet_callback(const tritonai::gkc::LogPacket & packet)
+  {
+    log_size += packet.what.size();
+    ++count;
+  }
+  using Sub::packet_callback;
+
+  size_t count = 0;
+  size_t log_size = 0;
+};
+
+namespace
+{
+// Bit-by-bit CRC-16/XMODEM as the reference
+uint16_t reference_crc16(const uint8_t * data, size_t size)
+{
+  uint16_t crc = 0;
+  for (size_t i = 0; i < size; ++i) {
+    crc ^= static_cast<uint16_t>(data[i] << 8);
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ 0x1021) :
+        static_cast<uint16_t>(crc << 1);
+    }
+  }
+  return crc;
+}
+}  // namespace
+
+TEST(TestGkcCrc16, CheckValue) {
+  const uint8_t check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+  EXPECT_EQ(tritonai::gkc::GkcCrc16::compute(check, sizeof(check)), 0x31C3);
+  EXPECT_EQ(tritonai::gkc::GkcCrc16::compute(check, 0), 0);
+  SUCCEED();
+}
+
+TEST(TestGkcCrc16, MatchesReference) {
+  std::srand(42);
+  auto data = std::vector<uint8_t>(300, 0);
+  for (auto & byte : data) {
+    byte = static_cast<uint8_t>(std::rand());
+  }
+  for (size_t size = 0; size <= data.size(); ++size) {
+    const auto expected = reference_crc16(data.data(), size);
+    EXPECT_EQ(tritonai::gkc::GkcCrc16::compute(data.data(), size), expected);
+    EXPECT_EQ(tritonai::gkc::GkcCrc16::update_bytewise(0, data.data(), size), expected);
+    EXPECT_EQ(tritonai::gkc::GkcCrc16::update_sliced(0, data.data(), size), expected);
+    EXPECT_EQ(tritonai::gkc::GkcPacketUtils::calc_crc16(data.data(), size), expected);
+  }
+  SUCCEED();
+}
+
+TEST(TestGkcCrc16, Incremental) {
+  std::srand(7);
+  auto data = tritonai::gkc::GkcBuffer(255, 0);
+  for (auto & byte : data) {
+    byte = static_cast<uint8_t>(std::rand());
+  }
+  const auto expected = reference_crc16(data.data(), data.size());
+  for (size_t split = 0; split <= data.size(); ++split) {
+    auto crc = tritonai::gkc::GkcCrc16();
+    crc.init();
+    crc.update(data.data(), split);
+    crc.update(data.data() + split, data.size() - split);
+    EXPECT_EQ(crc.finalize(), expected);
+  }
+  SUCCEED();
+}
+
+TEST(TestGkcCrc32, CheckValue) {
+  const uint8_t check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+  EXPECT_EQ(tritonai::gkc::GkcCrc32::compute(check, sizeof(check)), 0xCBF43926);
+  EXPECT_EQ(tritonai::gkc::GkcCrc32::compute(check, 0), 0u);
+  auto crc = tritonai::gkc::GkcCrc32();
+  crc.init();
+  crc.update(check, 4);
+  crc.update(check + 4, sizeof(check) - 4);
+  EXPECT_EQ(crc.finalize(), 0xCBF43926);
+  SUCCEED();
+}
+
 TEST(TestGkcPacketUtils, CreatePacket) {
   auto packet = tritonai::gkc::GkcPacketUtils::CreatePacket<tritonai::gkc::Handshake1GkcPacket>();
   SUCCEED();
@@ -57,6 +192,63 @@ TEST(TestGkcPacketUtils, BufferReadWrite) {
   SUCCEED();
 }
 
+TEST(TestGkcPacketUtils, InlineBuffer) {
+  using tritonai::gkc::GkcBuffer;
+  static_assert(std::is_trivially_copyable<GkcBuffer>::value, "GkcBuffer must be memcpy-able.");
+  static_assert(sizeof(GkcBuffer) <= 5 * 64, "GkcBuffer must fit in a few cache lines.");
+
+  const auto num_allocations = g_num_allocations.load();
+  auto buffer = GkcBuffer {0x02, 0x01};
+  buffer.push_back(0x03);
+  const uint8_t payload[] = {0xAA, 0xBB};
+  buffer.insert(buffer.begin() + 2, payload, payload + sizeof(payload));
+  EXPECT_EQ(buffer, (GkcBuffer {0x02, 0x01, 0xAA, 0xBB, 0x03}));
+  buffer.resize(7, 0xEE);
+  EXPECT_EQ(buffer.back(), 0xEE);
+  auto copy = buffer;
+  copy[0] = 0x00;
+  EXPECT_EQ(buffer.front(), 0x02);
+  EXPECT_NE(copy, buffer);
+
+  EXPECT_EQ(g_num_allocations.load(), num_allocations);
+
+  // Raw packets copy their payload without touching the heap
+  const auto raw = tritonai::gkc::RawGkcPacket(buffer);
+  const auto raw_num_allocations = g_num_allocations.load();
+  auto raw_copy = raw;
+  EXPECT_EQ(raw_copy.payload, buffer);
+  EXPECT_EQ(raw_copy.checksum, raw.checksum);
+  EXPECT_EQ(g_num_allocations.load(), raw_num_allocations);
+  SUCCEED();
+}
+
+TEST(TestGkcPacketUtils, InlineBufferOverflow) {
+  using tritonai::gkc::GkcBuffer;
+  // Growing beyond the capacity fails instead of truncating, and keeps the buffer as it was
+  EXPECT_THROW(GkcBuffer(GkcBuffer::capacity() + 1), std::length_error);
+  auto full = GkcBuffer(GkcBuffer::capacity(), 0x55);
+  EXPECT_THROW(full.push_back(0x00), std::length_error);
+  const uint8_t payload[] = {0xAA, 0xBB};
+  EXPECT_THROW(full.insert(full.begin(), payload, payload + sizeof(payload)), std::length_error);
+  EXPECT_THROW(full.resize(GkcBuffer::capacity() + 1), std::length_error);
+  EXPECT_EQ(full, GkcBuffer(GkcBuffer::capacity(), 0x55));
+
+  auto almost_full = GkcBuffer(GkcBuffer::capacity() - 1, 0x55);
+  EXPECT_THROW(
+    almost_full.insert(almost_full.begin(), payload, payload + sizeof(payload)),
+    std::length_error);
+  EXPECT_EQ(almost_full.size(), GkcBuffer::capacity() - 1);
+  EXPECT_EQ(almost_full.front(), 0x55);
+}
+
+TEST(TestGkcPacketUtils, InlineBufferPopEmpty) {
+  auto buffer = tritonai::gkc::GkcBuffer {0x01};
+  buffer.pop_back();
+  EXPECT_TRUE(buffer.empty());
+  EXPECT_THROW(buffer.pop_back(), std::length_error);
+  EXPECT_TRUE(buffer.empty());
+}
+
 TEST(TestGkcPackets, Handshake1GkcPacket) {
   auto packet = tritonai::gkc::Handshake1GkcPacket();
   packet.seq_number = 0xABCD1234;
@@ -222,6 +414,146 @@ TEST(TestGkcPackets, LogPacket) {
   SUCCEED();
 }
 
+TEST(TestGkcPackets, EncodeInto) {
+  auto control = tritonai::gkc::ControlGkcPacket();
+  control.throttle = 0.555;
+  control.steering = 0.4321;
+  control.brake = 1234.0;
+  auto sensor = tritonai::gkc::SensorGkcPacket();
+  sensor.values.wheel_speed_rr = 42.0;
+  sensor.values.fault_error = true;
+  auto log = tritonai::gkc::LogPacket();
+  log.level = tritonai::gkc::LogPacket::Severity::ERROR;
+  log.what = "Hello World";
+  const tritonai::gkc::GkcPacket * packets[] = {&control, &sensor, &log};
+  for (const auto & packet : packets) {
+    auto expected = packet->encode()->encode();
+    uint8_t frame[tritonai::gkc::RawGkcPacket::MAX_FRAME_SIZE] = {};
+    auto view = tritonai::gkc::GkcMutableBufferView(frame, sizeof(frame));
+    ASSERT_EQ(packet->encode_into(view), expected->size());
+    EXPECT_TRUE(std::equal(expected->begin(), expected->end(), frame));
+    // Too small a buffer is left alone
+    EXPECT_EQ(packet->encode_into(view.subspan(0, expected->size() - 1)), 0u);
+  }
+  SUCCEED();
+}
+
+TEST(TestGkcPackets, LogPacketTruncated) {
+  auto packet = tritonai::gkc::LogPacket();
+  packet.level = tritonai::gkc::LogPacket::Severity::INFO;
+  packet.what = std::string(400, 'x');
+  auto raw_packet = packet.encode();
+  EXPECT_EQ(raw_packet->payload_size, tritonai::gkc::RawGkcPacket::MAX_PAYLOAD_SIZE);
+  auto reconstructed_packet = tritonai::gkc::LogPacket();
+  reconstructed_packet.decode(*raw_packet);
+  EXPECT_EQ(reconstructed_packet.what, packet.what.substr(0, 253));
+  SUCCEED();
+}
+
+TEST(TestGkcLogs, Expand) {
+  using tritonai::gkc::GkcLogs;
+  using tritonai::gkc::GkcLogTable;
+  using tritonai::gkc::LogPacket;
+  auto packet = GkcLogs::brake_fault(2100.0f);
+  auto reconstructed = tritonai::gkc::LogIdGkcPacket();
+  reconstructed.decode(*packet.encode());
+  EXPECT_EQ(reconstructed.id, static_cast<uint16_t>(tritonai::gkc::GkcLogId::BRAKE_FAULT));
+  EXPECT_EQ(reconstructed.args, packet.args);
+  auto log = GkcLogTable::expand(reconstructed);
+  EXPECT_EQ(log.level, LogPacket::ERROR);
+  EXPECT_EQ(log.what, "Brake fault at 2100.0 psi.");
+
+  // A fraction of the frame of the same text
+  EXPECT_EQ(packet.encode()->encode()->size(), 13u);
+  EXPECT_EQ(log.encode()->encode()->size(), 33u);
+
+  log = GkcLogTable::expand(GkcLogs::sensor_timeout(3, 250));
+  EXPECT_EQ(log.level, LogPacket::WARNING);
+  EXPECT_EQ(log.what, "Sensor 3 not polled for 250 ms.");
+  log = GkcLogTable::expand(GkcLogs::steering_fault(-0.25f, 0.5f));
+  EXPECT_EQ(log.what, "Steering fault at -0.250 rad, servo at 0.500 rad.");
+  log = GkcLogTable::expand(GkcLogs::emergency_stop(true));
+  EXPECT_EQ(log.level, LogPacket::FATAL);
+  EXPECT_EQ(log.what, "Emergency stop, remote true.");
+  log = GkcLogTable::expand(GkcLogs::malformed_frames(UINT32_MAX));
+  EXPECT_EQ(log.what, "Dropped 4294967295 malformed frames.");
+
+  // The level can differ from the default of the log
+  packet = GkcLogs::low_voltage(11.5f);
+  packet.level = tritonai::gkc::LogIdGkcPacket::ERROR;
+  log = GkcLogTable::expand(packet);
+  EXPECT_EQ(log.level, LogPacket::ERROR);
+  EXPECT_EQ(log.what, "Battery low at 11.50 V.");
+  SUCCEED();
+}
+
+TEST(TestGkcLogs, UnknownOrTruncated) {
+  using tritonai::gkc::GkcLogTable;
+  for (size_t i = 0; i < tritonai::gkc::GKC_NUM_LOG_FORMATS; ++i) {
+    const auto & format = tritonai::gkc::GKC_LOG_FORMATS[i];
+    EXPECT_EQ(GkcLogTable::find(static_cast<uint16_t>(format.id)), &format);
+  }
+  EXPECT_EQ(GkcLogTable::find(0), nullptr);
+  EXPECT_EQ(GkcLogTable::find(UINT16_MAX), nullptr);
+
+  // A log of a newer firmware
+  auto packet = tritonai::gkc::LogIdGkcPacket();
+  packet.level = tritonai::gkc::LogIdGkcPacket::WARNING;
+  packet.id = 4242;
+  packet.args = {1, 2, 3};
+  auto log = GkcLogTable::expand(packet);
+  EXPECT_EQ(log.level, tritonai::gkc::LogPacket::WARNING);
+  EXPECT_EQ(log.what, "Unknown log ID 4242 with 3 bytes of arguments.");
+
+  // Arguments cut short
+  packet = tritonai::gkc::GkcLogs::sensor_timeout(3, 250);
+  packet.args.resize(3);
+  EXPECT_EQ(GkcLogTable::expand(packet).what, "Sensor 3 not polled for <missing> ms.");
+  packet.args.clear();
+  EXPECT_EQ(GkcLogTable::expand(packet).what, "Sensor <missing> not polled for <missing> ms.");
+
+  // Arguments beyond the capacity of a received log are dropped
+  auto payload = tritonai::gkc::GkcBuffer(
+    tritonai::gkc::LogIdGkcPacket::MIN_PAYLOAD_SIZE + 40, 0x07);
+  payload[0] = tritonai::gkc::LogIdGkcPacket::FIRST_BYTE;
+  packet.decode(payload);
+  EXPECT_EQ(packet.args.size(), tritonai::gkc::LogIdGkcPacket::MAX_ARGS_SIZE);
+  SUCCEED();
+}
+
+TEST(TestGkcLogs, Filter) {
+  using tritonai::gkc::LogFilterGkcPacket;
+  using tritonai::gkc::LogIdGkcPacket;
+  auto filter = tritonai::gkc::GkcLogFilter();
+  // Everything by default
+  for (uint32_t i = 0; i < 100; ++i) {
+    EXPECT_TRUE(filter.allow(LogIdGkcPacket::INFO, 0));
+  }
+
+  auto packet = LogFilterGkcPacket();
+  packet.min_level = LogFilterGkcPacket::WARNING;
+  packet.max_logs_per_second = 3;
+  auto reconstructed = LogFilterGkcPacket();
+  reconstructed.decode(*packet.encode());
+  EXPECT_EQ(reconstructed.min_level, packet.min_level);
+  EXPECT_EQ(reconstructed.max_logs_per_second, packet.max_logs_per_second);
+  filter.configure(reconstructed);
+
+  EXPECT_FALSE(filter.allow(LogIdGkcPacket::INFO, 1000));
+  EXPECT_TRUE(filter.allow(tritonai::gkc::LogPacket::WARNING, 1000));
+  EXPECT_TRUE(filter.allow(LogIdGkcPacket::ERROR, 1500));
+  EXPECT_TRUE(filter.allow(LogIdGkcPacket::WARNING, 1999));
+  EXPECT_FALSE(filter.allow(LogIdGkcPacket::ERROR, 1999));
+  EXPECT_FALSE(filter.allow(LogIdGkcPacket::WARNING, 1999));
+  // Fatal logs are never held back by the limit
+  EXPECT_TRUE(filter.allow(LogIdGkcPacket::FATAL, 1999));
+  EXPECT_EQ(filter.take_num_suppressed(), 2u);
+  EXPECT_EQ(filter.take_num_suppressed(), 0u);
+  // Next second
+  EXPECT_TRUE(filter.allow(LogIdGkcPacket::ERROR, 2000));
+  SUCCEED();
+}
+
 TEST(TestGkcPacketFactory, Receive) {
   auto sub = Sub();
   auto factory = tritonai::gkc::GkcPacketFactory(&sub, tritonai::gkc::GkcPacketUtils::debug_cout);
@@ -269,3 +601,1154 @@ TEST(TestGkcPacketFactory, CorruptedReceive) {
   EXPECT_EQ(sub.GkcPacketFactoryReceiveTestPacket.what, packet.what);
   SUCCEED();
 }
+
+TEST(TestGkcPacketFactory, MultipleFramesReceive) {
+  auto sub = Sub();
+  auto factory = tritonai::gkc::GkcPacketFactory(&sub, tritonai::gkc::GkcPacketUtils::debug_cout);
+  auto packet = tritonai::gkc::LogPacket();
+  packet.level = tritonai::gkc::LogPacket::Severity::INFO;
+  packet.what = "Hello World";
+  auto bytes = packet.encode()->encode();
+  // Enough frames to wrap around the receive buffer several times
+  auto stream = std::vector<uint8_t>();
+  for (int i = 0; i < 1000; ++i) {
+    stream.insert(stream.end(), bytes->begin(), bytes->end());
+  }
+  factory.Receive(stream);
+  EXPECT_EQ(sub.GkcPacketFactoryReceiveCount, 1000);
+  EXPECT_EQ(sub.GkcPacketFactoryReceiveTestPacket.what, packet.what);
+  SUCCEED();
+}
+
+TEST(TestGkcPacketFactory, ChunkedReceive) {
+  auto sub = Sub();
+  auto factory = tritonai::gkc::GkcPacketFactory(&sub, tritonai::gkc::GkcPacketUtils::debug_cout);
+  auto packet = tritonai::gkc::LogPacket();
+  packet.level = tritonai::gkc::LogPacket::Severity::WARNING;
+  packet.what = "Frames split across reads";
+  auto bytes = packet.encode()->encode();
+  auto stream = std::vector<uint8_t>();
+  for (int i = 0; i < 500; ++i) {
+    stream.insert(stream.end(), bytes->begin(), bytes->end());
+  }
+  // Chunk size is coprime with the frame size so frames land at every ring offset
+  static constexpr size_t CHUNK_SIZE = 7;
+  for (size_t i = 0; i < stream.size(); i += CHUNK_SIZE) {
+    auto end = std::min(stream.size(), i + CHUNK_SIZE);
+    factory.Receive(std::vector<uint8_t>(stream.begin() + i, stream.begin() + end));
+  }
+  EXPECT_EQ(sub.GkcPacketFactoryReceiveCount, 500);
+  EXPECT_EQ(sub.GkcPacketFactoryReceiveTestPacket.level, packet.level);
+  EXPECT_EQ(sub.GkcPacketFactoryReceiveTestPacket.what, packet.what);
+  SUCCEED();
+}
+
+TEST(TestGkcPacketFactory, IndependentFactories) {
+  auto sub1 = Sub();
+  auto sub2 = Sub();
+  auto factory1 = tritonai::gkc::GkcPacketFactory(&sub1, tritonai::gkc::GkcPacketUtils::debug_cout);
+  auto factory2 = tritonai::gkc::GkcPacketFactory(&sub2, tritonai::gkc::GkcPacketUtils::debug_cout);
+  auto packet = tritonai::gkc::LogPacket();
+  packet.level = tritonai::gkc::LogPacket::Severity::FATAL;
+  packet.what = "Hello World";
+  auto bytes = packet.encode()->encode();
+  auto garbage = tritonai::gkc::GkcBuffer(9, 0xEE);
+  factory1.Receive(garbage);
+  factory1.Receive(tritonai::gkc::GkcBuffer((*bytes).begin(), (*bytes).begin() + 6));
+  factory2.Receive(*bytes);
+  factory1.Receive(tritonai::gkc::GkcBuffer((*bytes).begin() + 6, (*bytes).end()));
+  EXPECT_EQ(sub1.GkcPacketFactoryReceiveCount, 1);
+  EXPECT_EQ(sub2.GkcPacketFactoryReceiveCount, 1);
+  EXPECT_EQ(sub1.GkcPacketFactoryReceiveTestPacket.what, packet.what);
+  SUCCEED();
+}
+
+TEST(TestGkcPacketFactory, TrailingStartByteReceive) {
+  auto sub = Sub();
+  auto factory = tritonai::gkc::GkcPacketFactory(&sub, tritonai::gkc::GkcPacketUtils::debug_cout);
+  auto packet = tritonai::gkc::LogPacket();
+  packet.level = tritonai::gkc::LogPacket::Severity::FATAL;
+  packet.what = "Hello World";
+  auto bytes = packet.encode()->encode();
+  factory.Receive(tritonai::gkc::GkcBuffer((*bytes).begin(), (*bytes).begin() + 1));
+  factory.Receive(tritonai::gkc::GkcBuffer((*bytes).begin() + 1, (*bytes).end()));
+  EXPECT_EQ(sub.GkcPacketFactoryReceiveCount, 1);
+  SUCCEED();
+}
+
+TEST(TestGkcPacketFactory, SendIntoBuffer) {
+  auto sub = Sub();
+  auto factory = tritonai::gkc::GkcPacketFactory(&sub, tritonai::gkc::GkcPacketUtils::debug_cout);
+  auto packet = tritonai::gkc::LogPacket();
+  packet.level = tritonai::gkc::LogPacket::Severity::FATAL;
+  packet.what = "Hello World";
+  std::array<uint8_t, tritonai::gkc::RawGkcPacket::MAX_FRAME_SIZE> frame {};
+  const auto frame_size = factory.Send(packet, frame);
+  ASSERT_GT(frame_size, 0u);
+  factory.Receive(tritonai::gkc::GkcBuffer(frame.begin(), frame.begin() + frame_size));
+  EXPECT_EQ(sub.GkcPacketFactoryReceiveCount, 1);
+  EXPECT_EQ(sub.GkcPacketFactoryReceiveTestPacket.what, packet.what);
+  SUCCEED();
+}
+
+TEST(TestGkcPacketFactory, UnknownFirstByteReceive) {
+  auto sub = Sub();
+  auto factory = tritonai::gkc::GkcPacketFactory(&sub, tritonai::gkc::GkcPacketUtils::debug_cout);
+  auto packet = tritonai::gkc::LogPacket();
+  packet.level = tritonai::gkc::LogPacket::Severity::FATAL;
+  packet.what = "Hello World";
+  auto unknown = packet.encode();
+  unknown->payload[0] = 0x42;
+  *unknown = tritonai::gkc::RawGkcPacket(unknown->payload);
+  factory.Receive(*unknown->encode());
+  factory.Receive(*packet.encode()->encode());
+  EXPECT_EQ(sub.GkcPacketFactoryReceiveCount, 1);
+  EXPECT_EQ(factory.get_statistics().unknown_first_byte, 1u);
+  EXPECT_EQ(factory.get_statistics().packets_received, 1u);
+  SUCCEED();
+}
+
+TEST(TestGkcPacketFactory, UndersizedPayloadReceive) {
+  auto sub = CountingSub();
+  auto factory = tritonai::gkc::GkcPacketFactory(&sub, tritonai::gkc::GkcPacketUtils::debug_cout);
+  // CRC-valid frames that are shorter than their packet type
+  auto log = tritonai::gkc::RawGkcPacket(
+    tritonai::gkc::GkcBuffer{tritonai::gkc::LogPacket::FIRST_BYTE});
+  auto sensor = tritonai::gkc::SensorGkcPacket().encode();
+  sensor->payload.resize(tritonai::gkc::SensorGkcPacket::PAYLOAD_SIZE - 1);
+  sensor = std::make_shared<tritonai::gkc::RawGkcPacket>(sensor->payload);
+  factory.Receive(*log.encode());
+  factory.Receive(*sensor->encode());
+  EXPECT_EQ(sub.count, 0u);
+  EXPECT_EQ(factory.get_statistics().undersized_payload, 2u);
+  EXPECT_EQ(factory.get_statistics().packets_received, 0u);
+
+  factory.Receive(*tritonai::gkc::SensorGkcPacket().encode()->encode());
+  EXPECT_EQ(sub.count, 1u);
+  EXPECT_EQ(factory.get_statistics().packets_received, 1u);
+}
+
+TEST(TestGkcPacketFactory, SteadyStateReceiveNoAllocation) {
+  constexpr size_t NUM_FRAMES = 10000;
+  constexpr size_t CHUNK_SIZE = 256;
+  auto sub = CountingSub();
+  auto factory = tritonai::gkc::GkcPacketFactory(&sub, tritonai::gkc::GkcPacketUtils::debug_cout);
+
+  auto sensor = tritonai::gkc::SensorGkcPacket();
+  auto log = tritonai::gkc::LogPacket();
+  log.level = tritonai::gkc::LogPacket::Severity::WARNING;
+  log.what = std::string(200, 'x');  // well beyond the small string buffer
+  auto stream = std::vector<uint8_t>();
+  for (size_t i = 0; i < NUM_FRAMES; ++i) {
+    sensor.values.wheel_speed_fl = static_cast<float>(i);
+    const auto frame = i % 10 ? sensor.encode()->encode() : log.encode()->encode();
+    stream.insert(stream.end(), frame->begin(), frame->end());
+  }
+  auto chunks = std::vector<std::vector<uint8_t>>();
+  for (size_t i = 0; i < stream.size(); i += CHUNK_SIZE) {
+    const auto end = stream.begin() + std::min(i + CHUNK_SIZE, stream.size());
+    chunks.emplace_back(stream.begin() + i, end);
+  }
+
+  // The first pass lets the pooled packets reach their steady-state capacity
+  for (const auto & chunk : chunks) {
+    factory.Receive(chunk);
+  }
+  ASSERT_EQ(sub.count, NUM_FRAMES);
+
+  const size_t num_allocations_before = g_num_allocations;
+  for (const auto & chunk : chunks) {
+    factory.Receive(chunk);
+  }
+  const size_t num_allocations = g_num_allocations - num_allocations_before;
+  EXPECT_EQ(sub.count, 2 * NUM_FRAMES);
+  EXPECT_EQ(sub.log_size, 2 * NUM_FRAMES / 10 * log.what.size());
+  EXPECT_EQ(num_allocations, 0u);
+  EXPECT_EQ(factory.get_pools().available<tritonai::gkc::LogPacket>(),
+    tritonai::gkc::GkcPacketFactory::POOL_SIZE);
+  SUCCEED();
+}
+
+TEST(TestGkcPacketPool, RecycledHandles) {
+  auto pool = tritonai::gkc::GkcPacketPool<tritonai::gkc::LogPacket, 2>();
+  tritonai::gkc::LogPacket * first_address = nullptr;
+  {
+    auto first = pool.acquire();
+    auto second = pool.acquire();
+    ASSERT_TRUE(first && second);
+    EXPECT_FALSE(pool.acquire());
+    EXPECT_EQ(pool.available(), 0u);
+    first->what = std::string(100, 'x');
+    first_address = first.get();
+  }
+  EXPECT_EQ(pool.available(), 2u);
+  auto reused = pool.acquire();
+  ASSERT_TRUE(reused);
+  EXPECT_EQ(reused.get(), first_address);
+  EXPECT_GE(reused->what.capacity(), 100u);
+  SUCCEED();
+}
+
+class ViewSub : public Sub
+{
+public:
+  void packet_callback(const tritonai::gkc::SensorGkcPacket & packet)
+  {
+    (void)packet;
+    ++num_decoded;
+  }
+  bool packet_view_callback(const tritonai::gkc::SensorView & view)
+  {
+    wheel_speed_rr = view.wheel_speed_rr();
+    fault_warning = view.fault_warning();
+    return view.fault_info();  // decode fully only without the info flag
+  }
+  using Sub::packet_callback;
+  using Sub::packet_view_callback;
+
+  int num_decoded = 0;
+  float wheel_speed_rr = 0.0f;
+  bool fault_warning = false;
+};
+
+TEST(TestGkcPacketViews, FieldsMatchPacket) {
+  auto sensor = tritonai::gkc::SensorGkcPacket();
+  sensor.values = {};
+  sensor.values.wheel_speed_fl = 1.5f;
+  sensor.values.voltage = 48.2f;
+  sensor.values.servo_angle_rad = -0.3f;
+  sensor.values.fault_steering = true;
+  sensor.values.fault_info = true;
+  const auto sensor_payload = sensor.encode()->payload;
+  const auto sensor_view = tritonai::gkc::SensorView(sensor_payload);
+  ASSERT_TRUE(sensor_view.valid());
+  EXPECT_EQ(sensor_view.wheel_speed_fl(), 1.5f);
+  EXPECT_EQ(sensor_view.voltage(), 48.2f);
+  EXPECT_EQ(sensor_view.servo_angle_rad(), -0.3f);
+  EXPECT_TRUE(sensor_view.fault_steering());
+  EXPECT_FALSE(sensor_view.fault_fatal());
+  EXPECT_TRUE(sensor_view.fault_info());
+
+  auto control = tritonai::gkc::ControlGkcPacket();
+  control.throttle = 0.25f;
+  control.steering = -0.1f;
+  control.brake = 80.0f;
+  const auto control_payload = control.encode()->payload;
+  const auto control_view = tritonai::gkc::ControlView(control_payload);
+  ASSERT_TRUE(control_view.valid());
+  EXPECT_EQ(control_view.throttle(), 0.25f);
+  EXPECT_EQ(control_view.steering(), -0.1f);
+  EXPECT_EQ(control_view.brake(), 80.0f);
+  EXPECT_FALSE(tritonai::gkc::SensorView(control_payload).valid());
+
+  auto heartbeat = tritonai::gkc::HeartbeatGkcPacket();
+  heartbeat.rolling_counter = 7;
+  heartbeat.state = 3;
+  const auto heartbeat_payload = heartbeat.encode()->payload;
+  const auto heartbeat_view = tritonai::gkc::HeartbeatView(heartbeat_payload);
+  EXPECT_EQ(heartbeat_view.rolling_counter(), 7);
+  EXPECT_EQ(heartbeat_view.state(), 3);
+  SUCCEED();
+}
+
+TEST(TestGkcPacketViews, ViewCallbackSkipsDecode) {
+  auto sub = ViewSub();
+  auto factory = tritonai::gkc::GkcPacketFactory(&sub, tritonai::gkc::GkcPacketUtils::debug_cout);
+  auto sensor = tritonai::gkc::SensorGkcPacket();
+  sensor.values = {};
+  sensor.values.wheel_speed_rr = 12.0f;
+  sensor.values.fault_warning = true;
+  sensor.values.fault_info = true;
+  factory.Receive(*sensor.encode()->encode());
+  EXPECT_EQ(sub.wheel_speed_rr, 12.0f);
+  EXPECT_TRUE(sub.fault_warning);
+  EXPECT_EQ(sub.num_decoded, 0);
+
+  sensor.values.fault_info = false;
+  factory.Receive(*sensor.encode()->encode());
+  EXPECT_EQ(sub.num_decoded, 1);
+  SUCCEED();
+}
+
+TEST(TestGkcPacket, GoldenFrames) {
+  size_t i = 0;
+  gkc_golden::visit_packets(
+    [&i](const auto & packet) {
+      ASSERT_LT(i, gkc_golden::NUM_FRAMES);
+      const auto & golden = gkc_golden::FRAMES[i++];
+      const auto raw = packet.encode()->encode();
+      EXPECT_TRUE(std::equal(raw->begin(), raw->end(), golden.bytes, golden.bytes + golden.size))
+        << golden.name;
+    });
+  EXPECT_EQ(i, gkc_golden::NUM_FRAMES);
+  SUCCEED();
+}
+
+TEST(TestGkcPacketFactory, ResyncInsideCorruptedFrame) {
+  auto sub = Sub();
+  auto factory = tritonai::gkc::GkcPacketFactory(&sub, tritonai::gkc::GkcPacketUtils::debug_cout);
+  auto packet = tritonai::gkc::LogPacket();
+  packet.level = tritonai::gkc::LogPacket::Severity::INFO;
+  packet.what = "Hi";
+  const auto valid = packet.encode()->encode();
+
+  // A truncated frame whose claimed length ends exactly at the end byte of the next,
+  // valid frame. Its checksum fails, and the valid frame inside it must not be lost.
+  const uint8_t truncated[] = {tritonai::gkc::GkcFrameFormat::START_BYTE,
+    static_cast<uint8_t>(valid->size() - 1), 0xAD, 0x01};
+  auto stream = tritonai::gkc::GkcBuffer(truncated, truncated + sizeof(truncated));
+  stream.insert(stream.end(), valid->begin(), valid->end());
+  factory.Receive(stream);
+
+  EXPECT_EQ(sub.GkcPacketFactoryReceiveCount, 1);
+  EXPECT_EQ(sub.GkcPacketFactoryReceiveTestPacket.what, "Hi");
+  const auto & stats = factory.get_framer_statistics();
+  EXPECT_EQ(stats.checksum_errors, 1u);
+  EXPECT_GE(stats.resyncs, 1u);
+  EXPECT_EQ(stats.bytes_discarded, sizeof(truncated));
+  SUCCEED();
+}
+
+TEST(TestGkcPacketFactory, NoiseBetweenFramesReceive) {
+  auto sub = Sub();
+  auto factory = tritonai::gkc::GkcPacketFactory(&sub, tritonai::gkc::GkcPacketUtils::debug_cout);
+  auto packet = tritonai::gkc::LogPacket();
+  packet.level = tritonai::gkc::LogPacket::Severity::INFO;
+  packet.what = "Hi";
+  const auto valid = packet.encode()->encode();
+  const auto noise = std::vector<uint8_t>(1000, 0x55);
+
+  auto stream = std::vector<uint8_t>();
+  for (int i = 0; i < 10; ++i) {
+    stream.insert(stream.end(), noise.begin(), noise.end());
+    stream.insert(stream.end(), valid->begin(), valid->end());
+  }
+  // Small enough chunks that the noise wraps around the end of the ring buffer
+  for (size_t i = 0; i < stream.size(); i += 700) {
+    const auto end = stream.begin() + std::min(i + 700, stream.size());
+    factory.Receive(std::vector<uint8_t>(stream.begin() + i, end));
+  }
+  EXPECT_EQ(sub.GkcPacketFactoryReceiveCount, 10);
+  EXPECT_EQ(factory.get_framer_statistics().bytes_discarded, 10 * noise.size());
+  EXPECT_EQ(factory.get_framer_statistics().resyncs, 0u);
+  SUCCEED();
+}
+
+TEST(TestGkcCobs, ReferenceVectors) {
+  using tritonai::gkc::GkcCobs;
+  std::array<uint8_t, 300> encoded {};
+
+  const uint8_t zero[] = {0x00};
+  ASSERT_EQ(GkcCobs::encode(zero, sizeof(zero), encoded.data()), 2u);
+  EXPECT_EQ(encoded[0], 0x01);
+  EXPECT_EQ(encoded[1], 0x01);
+
+  const uint8_t mixed[] = {0x11, 0x22, 0x00, 0x33};
+  const uint8_t mixed_encoded[] = {0x03, 0x11, 0x22, 0x02, 0x33};
+  ASSERT_EQ(GkcCobs::encode(mixed, sizeof(mixed), encoded.data()), sizeof(mixed_encoded));
+  EXPECT_TRUE(std::equal(mixed_encoded, mixed_encoded + sizeof(mixed_encoded), encoded.begin()));
+
+  // 254 non-zero bytes fit a single block, without a trailing empty one
+  auto run = tritonai::gkc::GkcBuffer(254, 0);
+  for (size_t i = 0; i < run.size(); ++i) {
+    run[i] = static_cast<uint8_t>(i + 1);
+  }
+  ASSERT_EQ(GkcCobs::encode(run.data(), run.size(), encoded.data()), 255u);
+  EXPECT_EQ(encoded[0], 0xFF);
+  EXPECT_TRUE(std::equal(run.begin(), run.end(), encoded.begin() + 1));
+  SUCCEED();
+}
+
+TEST(TestGkcCobs, RoundTrip) {
+  using tritonai::gkc::GkcCobs;
+  std::srand(11);
+  std::array<uint8_t, 300> encoded {};
+  std::array<uint8_t, 300> decoded {};
+  for (size_t size = 1; size <= 257; ++size) {
+    auto data = tritonai::gkc::GkcBuffer(size, 0);
+    for (auto & byte : data) {
+      // Mostly delimiters and start bytes, and long non-zero runs in between
+      const int r = std::rand() % 8;
+      byte = r == 0 ? 0x00 : r == 1 ? 0x02 : static_cast<uint8_t>(std::rand() % 255 + 1);
+    }
+    const auto encoded_size = GkcCobs::encode(data.data(), size, encoded.data());
+    ASSERT_LE(encoded_size, GkcCobs::max_encoded_size(size));
+    EXPECT_EQ(std::count(encoded.begin(), encoded.begin() + encoded_size, 0x00), 0);
+    ASSERT_EQ(GkcCobs::decode(encoded.data(), encoded_size, decoded.data()), size);
+    EXPECT_TRUE(std::equal(data.begin(), data.end(), decoded.begin()));
+  }
+  SUCCEED();
+}
+
+TEST(TestGkcPackets, HandshakeCapabilities) {
+  auto packet = tritonai::gkc::Handshake1GkcPacket();
+  packet.seq_number = 0xABCD1234;
+  EXPECT_EQ(packet.payload_size(), tritonai::gkc::Handshake1GkcPacket::PAYLOAD_SIZE);
+  packet.capabilities = tritonai::gkc::GkcCapabilities::COBS_FRAMING;
+  auto raw_packet = packet.encode();
+  EXPECT_EQ(raw_packet->payload.size(), tritonai::gkc::Handshake1GkcPacket::PAYLOAD_SIZE + 1);
+  auto reconstructed_packet = tritonai::gkc::Handshake1GkcPacket();
+  reconstructed_packet.decode(*raw_packet);
+  EXPECT_EQ(reconstructed_packet.seq_number, packet.seq_number);
+  EXPECT_EQ(reconstructed_packet.capabilities, tritonai::gkc::GkcCapabilities::COBS_FRAMING);
+
+  // A peer without capabilities sends the original 5-byte handshake
+  packet.capabilities = 0;
+  reconstructed_packet.decode(*packet.encode());
+  EXPECT_EQ(reconstructed_packet.capabilities, 0);
+  SUCCEED();
+}
+
+namespace
+{
+// The MCU side of the handshake: agrees to the capabilities it shares with the PC
+class HandshakeSub : public Sub
+{
+public:
+  void packet_callback(const tritonai::gkc::Handshake1GkcPacket & packet)
+  {
+    auto reply = tritonai::gkc::Handshake2GkcPacket();
+    reply.seq_number = packet.seq_number + 1;
+    reply.capabilities = packet.capabilities & capabilities;
+    reply_size = factory->Send(reply, reply_frame);
+    if (reply.capabilities & tritonai::gkc::GkcCapabilities::COBS_FRAMING) {
+      // The reply still goes out in legacy framing, so switch after encoding it
+      factory->set_framing(tritonai::gkc::GkcFraming::Cobs);
+    }
+  }
+  void packet_callback(const tritonai::gkc::Handshake2GkcPacket & packet)
+  {
+    agreed = packet.capabilities;
+  }
+  using Sub::packet_callback;
+
+  tritonai::gkc::GkcPacketFactory * factory = nullptr;
+  uint8_t capabilities = 0;
+  int agreed = -1;
+  std::array<uint8_t, tritonai::gkc::GkcFrameFormat::MAX_FRAME_SIZE> reply_frame {};
+  size_t reply_size = 0;
+};
+}  // namespace
+
+TEST(TestGkcPacketFactory, CobsNegotiation) {
+  using tritonai::gkc::GkcFraming;
+  auto pc_sub = HandshakeSub();
+  auto pc = tritonai::gkc::GkcPacketFactory(&pc_sub, tritonai::gkc::GkcPacketUtils::debug_cout);
+  auto mcu_sub = HandshakeSub();
+  auto mcu = tritonai::gkc::GkcPacketFactory(&mcu_sub, tritonai::gkc::GkcPacketUtils::debug_cout);
+  mcu_sub.factory = &mcu;
+
+  for (const uint8_t mcu_capabilities : {0x00, 0x01}) {
+    pc.set_framing(GkcFraming::Legacy);
+    mcu.set_framing(GkcFraming::Legacy);
+    mcu_sub.capabilities = mcu_capabilities;
+    auto handshake = tritonai::gkc::Handshake1GkcPacket();
+    handshake.seq_number = 42;
+    handshake.capabilities = tritonai::gkc::GkcCapabilities::COBS_FRAMING;
+    mcu.Receive(*pc.Send(handshake));
+    pc.Receive(tritonai::gkc::GkcBufferView(mcu_sub.reply_frame.data(), mcu_sub.reply_size));
+    ASSERT_EQ(pc_sub.agreed, mcu_capabilities);
+    if (pc_sub.agreed & tritonai::gkc::GkcCapabilities::COBS_FRAMING) {
+      pc.set_framing(GkcFraming::Cobs);
+    }
+    EXPECT_EQ(pc.get_framing(), mcu.get_framing());
+    EXPECT_EQ(mcu.get_framing(), mcu_capabilities ? GkcFraming::Cobs : GkcFraming::Legacy);
+  }
+
+  // COBS frames of every size, received in small chunks
+  auto stream = std::vector<uint8_t>();
+  auto packet = tritonai::gkc::LogPacket();
+  packet.level = tritonai::gkc::LogPacket::Severity::INFO;
+  for (size_t i = 0; i < tritonai::gkc::LogPacket::MAX_WHAT_SIZE; ++i) {
+    packet.what.assign(i, static_cast<char>(i % 3));  // runs of 0x00 and 0x02
+    const auto frame = pc.Send(packet);
+    EXPECT_EQ(frame->back(), tritonai::gkc::GkcCobs::DELIMITER);
+    EXPECT_EQ(std::count(frame->begin(), frame->end() - 1, 0x00), 0);
+    stream.insert(stream.end(), frame->begin(), frame->end());
+  }
+  for (size_t i = 0; i < stream.size(); i += 13) {
+    const auto end = stream.begin() + std::min(i + 13, stream.size());
+    mcu.Receive(std::vector<uint8_t>(stream.begin() + i, end));
+  }
+  EXPECT_EQ(mcu_sub.GkcPacketFactoryReceiveCount,
+    static_cast<int>(tritonai::gkc::LogPacket::MAX_WHAT_SIZE));
+  EXPECT_EQ(mcu_sub.GkcPacketFactoryReceiveTestPacket.what, packet.what);
+  EXPECT_EQ(mcu.get_framer_statistics().resyncs, 0u);
+  SUCCEED();
+}
+
+TEST(TestGkcPacketFactory, CobsCorruptedReceive) {
+  auto sub = Sub();
+  auto factory = tritonai::gkc::GkcPacketFactory(&sub, tritonai::gkc::GkcPacketUtils::debug_cout);
+  factory.set_framing(tritonai::gkc::GkcFraming::Cobs);
+  auto packet = tritonai::gkc::LogPacket();
+  packet.level = tritonai::gkc::LogPacket::Severity::INFO;
+  packet.what = "Hi";
+  const auto valid = factory.Send(packet);
+  auto corrupted = *valid;
+  corrupted[2] ^= 0x5A;
+  const uint8_t noise[] = {0x37, 0x02, 0x91};
+
+  // Line noise before the first delimiter, then a corrupted frame. Both cost only their
+  // own bytes: the valid frames after each delimiter are received.
+  auto stream = std::vector<uint8_t>(noise, noise + sizeof(noise));
+  stream.push_back(tritonai::gkc::GkcCobs::DELIMITER);
+  stream.insert(stream.end(), valid->begin(), valid->end());
+  stream.insert(stream.end(), corrupted.begin(), corrupted.end());
+  stream.insert(stream.end(), valid->begin(), valid->end());
+  factory.Receive(stream);
+
+  EXPECT_EQ(sub.GkcPacketFactoryReceiveCount, 2);
+  EXPECT_EQ(sub.GkcPacketFactoryReceiveTestPacket.what, "Hi");
+  const auto & stats = factory.get_framer_statistics();
+  EXPECT_EQ(stats.malformed + stats.checksum_errors, 2u);
+  EXPECT_EQ(stats.bytes_discarded, sizeof(noise) + 1 + corrupted.size());
+  SUCCEED();
+}
+
+namespace
+{
+class ChunkSub : public Sub
+{
+public:
+  void packet_callback(const tritonai::gkc::BulkChunkGkcPacket & packet)
+  {
+    chunks.emplace_back(packet.data.begin(), packet.data.end());
+  }
+  using Sub::packet_callback;
+
+  std::vector<std::vector<uint8_t>> chunks;
+};
+}  // namespace
+
+TEST(TestGkcPacketFactory, ExtendedFrames) {
+  using tritonai::gkc::GkcFrameFormat;
+  using tritonai::gkc::GkcFraming;
+  auto chunk = tritonai::gkc::BulkChunkGkcPacket();
+  for (size_t i = 0; i < tritonai::gkc::BulkChunkGkcPacket::MAX_DATA_SIZE; ++i) {
+    chunk.data.push_back(static_cast<uint8_t>(i % 5));  // runs of 0x00, 0x02 and 0x03
+  }
+  const auto expected = std::vector<uint8_t>(chunk.data.begin(), chunk.data.end());
+  std::array<uint8_t, GkcFrameFormat::MAX_EXTENDED_FRAME_SIZE> frame;
+
+  for (const auto framing : {GkcFraming::Legacy, GkcFraming::Cobs}) {
+    auto sub = ChunkSub();
+    auto factory = tritonai::gkc::GkcPacketFactory(&sub, tritonai::gkc::GkcPacketUtils::debug_cout);
+    factory.set_framing(framing);
+    const size_t frame_size = factory.Send(chunk, frame);
+    if (framing == GkcFraming::Legacy) {
+      EXPECT_EQ(frame_size, GkcFrameFormat::MAX_EXTENDED_PAYLOAD_SIZE + 6);
+      EXPECT_EQ(frame[0], GkcFrameFormat::EXTENDED_START_BYTE);
+    }
+    ASSERT_GT(frame_size, GkcFrameFormat::MAX_EXTENDED_PAYLOAD_SIZE);
+    EXPECT_EQ(factory.Send(chunk, tritonai::gkc::GkcMutableBufferView(frame.data(), 260)), 0u);
+    EXPECT_EQ(
+      *factory.Send(chunk), std::vector<uint8_t>(frame.begin(), frame.begin() + frame_size));
+
+    // Not received unless extended frames are agreed on
+    factory.Receive(tritonai::gkc::GkcBufferView(frame.data(), frame_size));
+    EXPECT_TRUE(sub.chunks.empty());
+
+    auto extended_sub = ChunkSub();
+    auto extended = tritonai::gkc::GkcPacketFactory(
+      &extended_sub, tritonai::gkc::GkcPacketUtils::debug_cout);
+    extended.set_framing(framing);
+    extended.set_extended_frames(true);
+    for (size_t i = 0; i < frame_size; ++i) {
+      extended.Receive(tritonai::gkc::GkcBufferView(frame.data() + i, 1));
+    }
+    ASSERT_EQ(extended_sub.chunks.size(), 1u);
+    EXPECT_EQ(extended_sub.chunks[0], expected);
+  }
+  EXPECT_THROW(chunk.encode(), std::length_error);
+
+  // An extended start byte followed by a size out of range does not wait for more bytes
+  auto sub = Sub();
+  auto factory = tritonai::gkc::GkcPacketFactory(&sub, tritonai::gkc::GkcPacketUtils::debug_cout);
+  factory.set_extended_frames(true);
+  auto log = tritonai::gkc::LogPacket();
+  log.what = "Hi";
+  const auto valid = factory.Send(log);
+  auto stream = std::vector<uint8_t>{0x03, 0xFF, 0xFF, 0x03, 0x10, 0x00};
+  stream.insert(stream.end(), valid->begin(), valid->end());
+  factory.Receive(stream);
+  EXPECT_EQ(sub.GkcPacketFactoryReceiveCount, 1);
+  EXPECT_EQ(factory.get_framer_statistics().malformed, 2u);
+  SUCCEED();
+}
+
+namespace
+{
+// Stand-ins for tai_gokart_msgs::msg::GkcCommand and GkcState
+struct CommandMsg
+{
+  float throttle = 0;
+  float steering = 0;
+  float brake = 0;
+  bool emergency_stop = false;
+};
+struct StateMsg
+{
+  float wheel_speed_fl, wheel_speed_fr, wheel_speed_rl, wheel_speed_rr;
+  float voltage, amperage;
+  float brake_pressure, throttle_pos, steering_angle_rad, servo_angle_rad;
+  bool fault_brake, fault_throttle, fault_steering;
+  bool fault_fatal, fault_error, fault_warning, fault_info;
+  uint8_t state = 3;
+};
+}  // namespace
+
+TEST(TestGkcPacket, MsgConversions) {
+  auto command = CommandMsg();
+  command.throttle = 0.5f;
+  command.steering = -0.1f;
+  command.brake = 200.0f;
+  command.emergency_stop = true;
+  auto control = tritonai::gkc::ControlGkcPacket();
+  tritonai::gkc::from_msg(command, control);
+  EXPECT_EQ(control.throttle, 0.5f);
+  EXPECT_EQ(control.steering, -0.1f);
+  EXPECT_EQ(control.brake, 200.0f);
+  auto command_back = CommandMsg();
+  tritonai::gkc::to_msg(control, command_back);
+  EXPECT_EQ(command_back.brake, 200.0f);
+  EXPECT_FALSE(command_back.emergency_stop);
+
+  auto sensor = tritonai::gkc::SensorGkcPacket();
+  sensor.values = {};
+  sensor.values.wheel_speed_rr = 321.0f;
+  sensor.values.voltage = 47.5f;
+  sensor.values.fault_warning = true;
+  auto state = StateMsg();
+  tritonai::gkc::to_msg(sensor, state);
+  EXPECT_EQ(state.wheel_speed_rr, 321.0f);
+  EXPECT_EQ(state.voltage, 47.5f);
+  EXPECT_EQ(state.amperage, 0.0f);
+  EXPECT_TRUE(state.fault_warning);
+  EXPECT_FALSE(state.fault_fatal);
+  EXPECT_EQ(state.state, 3);
+  auto sensor_back = tritonai::gkc::SensorGkcPacket();
+  tritonai::gkc::from_msg(state, sensor_back);
+  EXPECT_EQ(std::memcmp(&sensor_back.values, &sensor.values, sizeof(sensor.values)), 0);
+  SUCCEED();
+}
+
+namespace
+{
+// A fixed-point value decodes to within half a unit, plus the rounding error of a float
+float compact_error_bound(const float & value, const float & resolution)
+{
+  return resolution / 2 + std::abs(value) * 1e-6f;
+}
+}  // namespace
+
+TEST(TestGkcPackets, CompactSensorErrorBounds) {
+  using tritonai::gkc::CompactSensorGkcPacket;
+  auto rng = std::mt19937(42);
+  auto uniform = [&rng](const float & min, const float & max) {
+      return std::uniform_real_distribution<float>(min, max)(rng);
+    };
+  for (int i = 0; i < 1000; ++i) {
+    auto packet = tritonai::gkc::SensorGkcPacket();
+    packet.values.wheel_speed_fl = uniform(-3000.0f, 3000.0f);
+    packet.values.wheel_speed_fr = uniform(-3000.0f, 3000.0f);
+    packet.values.wheel_speed_rl = uniform(-3000.0f, 3000.0f);
+    packet.values.wheel_speed_rr = uniform(-3000.0f, 3000.0f);
+    packet.values.voltage = uniform(0.0f, 600.0f);
+    packet.values.amperage = uniform(-300.0f, 300.0f);
+    packet.values.brake_pressure = uniform(0.0f, 6000.0f);
+    packet.values.throttle_pos = uniform(0.0f, 1.0f);
+    packet.values.steering_angle_rad = uniform(-3.0f, 3.0f);
+    packet.values.servo_angle_rad = uniform(-3.0f, 3.0f);
+    packet.values.fault_brake = i & 0x01;
+    packet.values.fault_throttle = i & 0x02;
+    packet.values.fault_steering = i & 0x04;
+    packet.values.fault_fatal = i & 0x08;
+    packet.values.fault_error = i & 0x10;
+    packet.values.fault_warning = i & 0x20;
+    packet.values.fault_info = i & 0x40;
+
+    auto raw_packet = CompactSensorGkcPacket(packet).encode();
+    ASSERT_EQ(raw_packet->payload.size(), CompactSensorGkcPacket::PAYLOAD_SIZE);
+    EXPECT_EQ(raw_packet->payload[0], CompactSensorGkcPacket::FIRST_BYTE);
+    auto compact = CompactSensorGkcPacket();
+    compact.decode(*raw_packet);
+    const auto & original = packet.values;
+    const auto decoded = compact.expand().values;
+    EXPECT_NEAR(decoded.wheel_speed_fl, original.wheel_speed_fl, compact_error_bound(
+        original.wheel_speed_fl, CompactSensorGkcPacket::WHEEL_SPEED_FL_RESOLUTION));
+    EXPECT_NEAR(decoded.wheel_speed_fr, original.wheel_speed_fr, compact_error_bound(
+        original.wheel_speed_fr, CompactSensorGkcPacket::WHEEL_SPEED_FR_RESOLUTION));
+    EXPECT_NEAR(decoded.wheel_speed_rl, original.wheel_speed_rl, compact_error_bound(
+        original.wheel_speed_rl, CompactSensorGkcPacket::WHEEL_SPEED_RL_RESOLUTION));
+    EXPECT_NEAR(decoded.wheel_speed_rr, original.wheel_speed_rr, compact_error_bound(
+        original.wheel_speed_rr, CompactSensorGkcPacket::WHEEL_SPEED_RR_RESOLUTION));
+    EXPECT_NEAR(decoded.voltage, original.voltage, compact_error_bound(
+        original.voltage, CompactSensorGkcPacket::VOLTAGE_RESOLUTION));
+    EXPECT_NEAR(decoded.amperage, original.amperage, compact_error_bound(
+        original.amperage, CompactSensorGkcPacket::AMPERAGE_RESOLUTION));
+    EXPECT_NEAR(decoded.brake_pressure, original.brake_pressure, compact_error_bound(
+        original.brake_pressure, CompactSensorGkcPacket::BRAKE_PRESSURE_RESOLUTION));
+    EXPECT_NEAR(decoded.throttle_pos, original.throttle_pos, compact_error_bound(
+        original.throttle_pos, CompactSensorGkcPacket::THROTTLE_POS_RESOLUTION));
+    EXPECT_NEAR(decoded.steering_angle_rad, original.steering_angle_rad, compact_error_bound(
+        original.steering_angle_rad, CompactSensorGkcPacket::STEERING_ANGLE_RAD_RESOLUTION));
+    EXPECT_NEAR(decoded.servo_angle_rad, original.servo_angle_rad, compact_error_bound(
+        original.servo_angle_rad, CompactSensorGkcPacket::SERVO_ANGLE_RAD_RESOLUTION));
+    EXPECT_EQ(decoded.fault_brake, original.fault_brake);
+    EXPECT_EQ(decoded.fault_throttle, original.fault_throttle);
+    EXPECT_EQ(decoded.fault_steering, original.fault_steering);
+    EXPECT_EQ(decoded.fault_fatal, original.fault_fatal);
+    EXPECT_EQ(decoded.fault_error, original.fault_error);
+    EXPECT_EQ(decoded.fault_warning, original.fault_warning);
+    EXPECT_EQ(decoded.fault_info, original.fault_info);
+  }
+  SUCCEED();
+}
+
+TEST(TestGkcPackets, CompactControlErrorBounds) {
+  using tritonai::gkc::CompactControlGkcPacket;
+  auto rng = std::mt19937(42);
+  auto uniform = [&rng](const float & min, const float & max) {
+      return std::uniform_real_distribution<float>(min, max)(rng);
+    };
+  for (int i = 0; i < 1000; ++i) {
+    auto packet = tritonai::gkc::ControlGkcPacket();
+    packet.throttle = uniform(0.0f, 1.0f);
+    packet.steering = uniform(-0.6f, 0.6f);
+    packet.brake = uniform(0.0f, 2000.0f);
+
+    auto raw_packet = CompactControlGkcPacket(packet).encode();
+    ASSERT_EQ(raw_packet->payload.size(), CompactControlGkcPacket::PAYLOAD_SIZE);
+    auto compact = CompactControlGkcPacket();
+    compact.decode(*raw_packet);
+    const auto decoded = compact.expand();
+    EXPECT_NEAR(decoded.throttle, packet.throttle, compact_error_bound(
+        packet.throttle, CompactControlGkcPacket::THROTTLE_RESOLUTION));
+    EXPECT_NEAR(decoded.steering, packet.steering, compact_error_bound(
+        packet.steering, CompactControlGkcPacket::STEERING_RESOLUTION));
+    EXPECT_NEAR(decoded.brake, packet.brake, compact_error_bound(
+        packet.brake, CompactControlGkcPacket::BRAKE_RESOLUTION));
+  }
+  SUCCEED();
+}
+
+TEST(TestGkcPackets, CompactSaturation) {
+  using tritonai::gkc::CompactControlGkcPacket;
+  auto packet = CompactControlGkcPacket();
+  auto decoded = CompactControlGkcPacket();
+
+  // Out of range values are clamped, not wrapped around
+  packet.throttle = 5.0f;
+  packet.steering = -5.0f;
+  packet.brake = -10.0f;
+  decoded.decode(*packet.encode());
+  EXPECT_FLOAT_EQ(decoded.throttle, 32767 * CompactControlGkcPacket::THROTTLE_RESOLUTION);
+  EXPECT_FLOAT_EQ(decoded.steering, -32768 * CompactControlGkcPacket::STEERING_RESOLUTION);
+  EXPECT_EQ(decoded.brake, 0.0f);
+
+  packet.throttle = std::numeric_limits<float>::quiet_NaN();
+  packet.steering = std::numeric_limits<float>::infinity();
+  packet.brake = 1e9f;
+  decoded.decode(*packet.encode());
+  EXPECT_EQ(decoded.throttle, 0.0f);
+  EXPECT_FLOAT_EQ(decoded.steering, 32767 * CompactControlGkcPacket::STEERING_RESOLUTION);
+  EXPECT_FLOAT_EQ(decoded.brake, 65535 * CompactControlGkcPacket::BRAKE_RESOLUTION);
+
+  // Rounded to the nearest unit, in both directions from 0
+  packet.throttle = 0.00016f;
+  packet.steering = -0.00016f;
+  decoded.decode(*packet.encode());
+  EXPECT_FLOAT_EQ(decoded.throttle, 0.0002f);
+  EXPECT_FLOAT_EQ(decoded.steering, -0.0002f);
+  SUCCEED();
+}
+
+TEST(TestGkcPackets, SensorDeltaGkcPacket) {
+  using tritonai::gkc::SensorDeltaGkcPacket;
+  auto keyframe = tritonai::gkc::SensorGkcPacket::SensorValues();
+  keyframe = {};
+  keyframe.voltage = 48.0f;
+  keyframe.fault_info = true;
+  auto packet = SensorDeltaGkcPacket();
+  packet.keyframe_id = 7;
+  packet.values = keyframe;
+  packet.values.wheel_speed_rl = 250.0f;
+  packet.values.voltage = 48.001f;  // same in the compact encoding
+  packet.values.fault_warning = true;
+  packet.set_changes(keyframe);
+  EXPECT_EQ(packet.changed, 0x0004 | 0x0400);
+
+  auto raw_packet = packet.encode();
+  EXPECT_EQ(raw_packet->payload.size(), SensorDeltaGkcPacket::MIN_PAYLOAD_SIZE + 2 + 1);
+  auto reconstructed_packet = SensorDeltaGkcPacket();
+  reconstructed_packet.decode(*raw_packet);
+  EXPECT_EQ(reconstructed_packet.keyframe_id, 7);
+  EXPECT_EQ(reconstructed_packet.changed, packet.changed);
+  auto values = keyframe;
+  reconstructed_packet.apply_to(values);
+  EXPECT_EQ(values.wheel_speed_rl, 250.0f);
+  EXPECT_EQ(values.voltage, 48.0f);
+  EXPECT_TRUE(values.fault_warning);
+  EXPECT_TRUE(values.fault_info);
+
+  // A payload shorter than its bit mask announces changes nothing
+  auto truncated = *raw_packet;
+  truncated.payload.pop_back();
+  reconstructed_packet.decode(truncated);
+  EXPECT_EQ(reconstructed_packet.changed, 0);
+  SUCCEED();
+}
+
+namespace
+{
+// Sensor values while driving: the wheel speeds change every sample, the steering
+// every fifth, the rest stays the same
+tritonai::gkc::SensorGkcPacket::SensorValues driving_sample(const size_t & i)
+{
+  auto values = tritonai::gkc::SensorGkcPacket::SensorValues();
+  values = {};
+  values.wheel_speed_fl = 300.0f + 0.37f * i;
+  values.wheel_speed_fr = 302.0f + 0.35f * i;
+  values.wheel_speed_rl = 299.0f + 0.36f * i;
+  values.wheel_speed_rr = 301.0f + 0.38f * i;
+  values.voltage = 47.9f;
+  values.amperage = 35.2f;
+  values.throttle_pos = 0.4f;
+  values.steering_angle_rad = 0.01f * static_cast<float>(i / 5 % 10);
+  values.fault_info = true;
+  return values;
+}
+
+tritonai::gkc::SensorGkcPacket::SensorValues compact_values(
+  const tritonai::gkc::SensorGkcPacket::SensorValues & values)
+{
+  auto packet = tritonai::gkc::SensorGkcPacket();
+  packet.values = values;
+  auto compact = tritonai::gkc::CompactSensorGkcPacket();
+  compact.decode(*tritonai::gkc::CompactSensorGkcPacket(packet).encode());
+  return compact.values;
+}
+
+class DeltaSub : public Sub
+{
+public:
+  void packet_callback(const tritonai::gkc::SensorDeltaGkcPacket & packet)
+  {
+    last_result = decoder.apply(packet);
+  }
+  using Sub::packet_callback;
+
+  tritonai::gkc::GkcSensorDeltaDecoder decoder;
+  tritonai::gkc::GkcSensorDeltaDecoder::Result last_result {};
+};
+}  // namespace
+
+TEST(TestGkcSensorDeltas, Stream) {
+  using tritonai::gkc::GkcFrameFormat;
+  using Result = tritonai::gkc::GkcSensorDeltaDecoder::Result;
+  auto sub = DeltaSub();
+  auto factory = tritonai::gkc::GkcPacketFactory(&sub, tritonai::gkc::GkcPacketUtils::debug_cout);
+  auto encoder = tritonai::gkc::GkcSensorDeltaEncoder(50);
+  static constexpr size_t NUM_SAMPLES = 500;
+  size_t stream_size = 0;
+  for (size_t i = 0; i < NUM_SAMPLES; ++i) {
+    const auto values = driving_sample(i);
+    std::array<uint8_t, GkcFrameFormat::MAX_FRAME_SIZE> frame {};
+    const auto frame_size = factory.Send(encoder.next(values), frame);
+    stream_size += frame_size;
+    factory.Receive(tritonai::gkc::GkcBufferView(frame.data(), frame_size));
+    ASSERT_EQ(sub.last_result, Result::Updated);
+    const auto expected = compact_values(values);
+    ASSERT_EQ(std::memcmp(&sub.decoder.values(), &expected, sizeof(expected)), 0) << i;
+  }
+
+  // At least twice the sensor rate of SensorGkcPacket on the same link
+  const auto full_size = tritonai::gkc::SensorGkcPacket::PAYLOAD_SIZE +
+    GkcFrameFormat::NUM_NON_PAYLOAD_BYTES;
+  EXPECT_LE(stream_size * 2, full_size * NUM_SAMPLES);
+  SUCCEED();
+}
+
+TEST(TestGkcSensorDeltas, LostKeyframe) {
+  using Result = tritonai::gkc::GkcSensorDeltaDecoder::Result;
+  auto encoder = tritonai::gkc::GkcSensorDeltaEncoder(10);
+  auto decoder = tritonai::gkc::GkcSensorDeltaDecoder();
+  auto received = [](const tritonai::gkc::SensorDeltaGkcPacket & packet) {
+      auto decoded = tritonai::gkc::SensorDeltaGkcPacket();
+      decoded.decode(*packet.encode());
+      return decoded;
+    };
+  EXPECT_EQ(decoder.apply(received(encoder.next(driving_sample(0)))), Result::Updated);
+  for (size_t i = 1; i < 10; ++i) {
+    EXPECT_EQ(decoder.apply(encoder.next(driving_sample(i))), Result::Updated);
+  }
+
+  // The second keyframe is lost. The PC asks for a resync once and drops the deltas until
+  // the MCU sends the next keyframe.
+  encoder.next(driving_sample(10));
+  EXPECT_EQ(decoder.apply(received(encoder.next(driving_sample(11)))), Result::Resync);
+  EXPECT_EQ(decoder.apply(received(encoder.next(driving_sample(12)))), Result::Pending);
+  EXPECT_EQ(decoder.num_dropped(), 2u);
+  encoder.request_keyframe();
+  const auto & keyframe = encoder.next(driving_sample(13));
+  EXPECT_TRUE(keyframe.changed & tritonai::gkc::SensorDeltaGkcPacket::KEYFRAME);
+  EXPECT_EQ(decoder.apply(received(keyframe)), Result::Updated);
+  EXPECT_EQ(decoder.apply(received(encoder.next(driving_sample(14)))), Result::Updated);
+  const auto expected = compact_values(driving_sample(14));
+  EXPECT_EQ(std::memcmp(&decoder.values(), &expected, sizeof(expected)), 0);
+  SUCCEED();
+}
+
+TEST(TestGkcPackets, SensorBatchGkcPacket) {
+  using tritonai::gkc::SensorBatchGkcPacket;
+  auto packet = SensorBatchGkcPacket();
+  packet.timestamp_us = 0xFFFFF000;
+  packet.num_samples = SensorBatchGkcPacket::MAX_SAMPLES;
+  for (size_t i = 0; i < packet.num_samples; ++i) {
+    packet.samples[i] = {static_cast<uint16_t>(i * 1000), driving_sample(i)};
+  }
+
+  auto raw_packet = packet.encode();
+  EXPECT_EQ(
+    raw_packet->payload.size(),
+    SensorBatchGkcPacket::MIN_PAYLOAD_SIZE +
+    SensorBatchGkcPacket::MAX_SAMPLES * SensorBatchGkcPacket::SAMPLE_SIZE);
+  // The whole batch takes less than half the bytes of one Sensors frame per sample
+  EXPECT_LT(
+    raw_packet->encode()->size() * 2,
+    tritonai::gkc::SensorGkcPacket().encode()->encode()->size() * packet.num_samples);
+  auto reconstructed_packet = SensorBatchGkcPacket();
+  reconstructed_packet.decode(*raw_packet);
+  EXPECT_EQ(reconstructed_packet.timestamp_us, 0xFFFFF000);
+  ASSERT_EQ(reconstructed_packet.num_samples, SensorBatchGkcPacket::MAX_SAMPLES);
+  for (size_t i = 0; i < reconstructed_packet.num_samples; ++i) {
+    const auto & sample = reconstructed_packet.samples[i];
+    const auto expected = compact_values(driving_sample(i));
+    EXPECT_EQ(sample.time_offset_us, i * 1000);
+    EXPECT_EQ(std::memcmp(&sample.values, &expected, sizeof(expected)), 0);
+  }
+
+  // Only the samples that are complete in a truncated payload are decoded
+  auto truncated = *raw_packet;
+  truncated.payload.resize(
+    SensorBatchGkcPacket::MIN_PAYLOAD_SIZE + 3 * SensorBatchGkcPacket::SAMPLE_SIZE - 1);
+  reconstructed_packet.decode(truncated);
+  EXPECT_EQ(reconstructed_packet.num_samples, 2);
+
+  // Samples beyond `MAX_SAMPLES` are not sent
+  packet.num_samples = 255;
+  EXPECT_EQ(packet.encode()->payload.size(), raw_packet->payload.size());
+  SUCCEED();
+}
+
+namespace
+{
+// One direction of a link with a line rate, a latency and frame loss
+struct BulkLinkDirection
+{
+  static constexpr double BYTES_PER_MS = 1000.0;
+  static constexpr double LATENCY_MS = 10.0;
+
+  // Queue a frame, unless the transmit buffer already holds 1 ms worth of bytes
+  bool send(
+    const tritonai::gkc::GkcPacket & packet, tritonai::gkc::GkcPacketFactory & factory,
+    const double & now_ms)
+  {
+    if (busy_until_ms > now_ms + 1.0) {
+      return false;
+    }
+    std::array<uint8_t, tritonai::gkc::GkcFrameFormat::MAX_EXTENDED_FRAME_SIZE> frame;
+    const size_t frame_size = factory.Send(packet, frame);
+    busy_until_ms = std::max(busy_until_ms, now_ms) + frame_size / BYTES_PER_MS;
+    num_bytes += frame_size;
+    const bool is_lost = lost && lost(num_frames);
+    ++num_frames;
+    if (is_lost) {
+      return true;
+    }
+    in_flight.emplace_back(
+      busy_until_ms + LATENCY_MS, std::vector<uint8_t>(frame.begin(), frame.begin() + frame_size));
+    return true;
+  }
+
+  void deliver(const double & now_ms, tritonai::gkc::GkcPacketFactory & factory)
+  {
+    while (!in_flight.empty() && in_flight.front().first <= now_ms) {
+      factory.Receive(in_flight.front().second);
+      in_flight.pop_front();
+    }
+  }
+
+  double busy_until_ms = 0.0;  // the line is busy with queued frames until then
+  std::deque<std::pair<double, std::vector<uint8_t>>> in_flight {};  // arrival time, frame
+  size_t num_frames = 0;
+  size_t num_bytes = 0;
+  bool (* lost)(const size_t & frame_index) = nullptr;
+};
+
+// Either end of a bulk transfer
+class BulkEndpoint : public Sub
+{
+public:
+  explicit BulkEndpoint(const size_t & window)
+  : sender(window, 50)
+  {
+    factory.set_extended_frames(true);
+  }
+
+  void packet_callback(const tritonai::gkc::BulkStartGkcPacket & packet)
+  {
+    if (receiver.is_new(packet)) {
+      data.assign(std::min<size_t>(packet.total_size, max_size), 0);
+    }
+    receiver.start(packet, data, [this](const auto & ack) {return send(ack);});
+  }
+  void packet_callback(const tritonai::gkc::BulkChunkGkcPacket & packet)
+  {
+    receiver.receive(packet, [this](const auto & ack) {return send(ack);});
+  }
+  void packet_callback(const tritonai::gkc::BulkAckGkcPacket & packet)
+  {
+    sender.on_ack(packet, static_cast<uint32_t>(now_ms));
+  }
+  using Sub::packet_callback;
+
+  bool send(const tritonai::gkc::GkcPacket & packet) {return out.send(packet, factory, now_ms);}
+
+  tritonai::gkc::GkcPacketFactory factory {this, tritonai::gkc::GkcPacketUtils::debug_cout};
+  tritonai::gkc::GkcBulkSender sender;
+  tritonai::gkc::GkcBulkReceiver receiver {};
+  std::vector<uint8_t> data {};  // received
+  size_t max_size = SIZE_MAX;  // of received data
+  BulkLinkDirection out {};
+  double now_ms = 0.0;
+};
+
+// Send `data` from `a` to `b` in steps of 1 ms. Returns the time it took in ms.
+uint32_t run_bulk_transfer(
+  BulkEndpoint & a, BulkEndpoint & b, const std::vector<uint8_t> & data,
+  const size_t & chunk_size)
+{
+  static constexpr uint32_t MAX_MS = 100000;
+  EXPECT_TRUE(a.sender.start(7, data, chunk_size, 0));
+  uint32_t now_ms = 0;
+  for (; now_ms < MAX_MS && a.sender.state() == tritonai::gkc::GkcBulkSender::State::Sending;
+    ++now_ms)
+  {
+    a.now_ms = b.now_ms = now_ms;
+    a.out.deliver(now_ms, b.factory);
+    b.out.deliver(now_ms, a.factory);
+    a.sender.poll(now_ms, [&a](const auto & packet) {return a.send(packet);});
+  }
+  return now_ms;
+}
+
+std::vector<uint8_t> random_bytes(const size_t & size)
+{
+  std::mt19937 gen(5);
+  auto bytes = std::vector<uint8_t>(size);
+  for (auto & byte : bytes) {
+    byte = static_cast<uint8_t>(gen());
+  }
+  return bytes;
+}
+}  // namespace
+
+TEST(TestGkcBulkTransfer, WindowApproachesLineRate) {
+  using tritonai::gkc::GkcBulkSender;
+  const auto data = random_bytes(256 * 1024);
+  const size_t chunk_size = tritonai::gkc::BulkChunkGkcPacket::MAX_DATA_SIZE;
+
+  double efficiency[2] = {};
+  const size_t windows[2] = {1, 32};
+  for (size_t i = 0; i < 2; ++i) {
+    auto a = BulkEndpoint(windows[i]);
+    auto b = BulkEndpoint(windows[i]);
+    const auto duration_ms = run_bulk_transfer(a, b, data, chunk_size);
+    ASSERT_EQ(a.sender.state(), GkcBulkSender::State::Complete);
+    EXPECT_EQ(b.data, data);
+    EXPECT_EQ(a.sender.get_statistics().retransmissions, 0u);
+    // Time the line needs for the frames, over the time the transfer took
+    efficiency[i] = a.out.num_bytes / BulkLinkDirection::BYTES_PER_MS / duration_ms;
+  }
+  // Stop-and-wait idles for a round trip after every chunk
+  EXPECT_LT(efficiency[0], 0.1);
+  EXPECT_GT(efficiency[1], 0.9);
+  SUCCEED();
+}
+
+TEST(TestGkcBulkTransfer, Loss) {
+  using tritonai::gkc::GkcBulkSender;
+  using tritonai::gkc::GkcBulkReceiver;
+  const auto data = random_bytes(64 * 1024 + 123);
+  // Extended and standard frames
+  for (const size_t chunk_size :
+    {tritonai::gkc::BulkChunkGkcPacket::MAX_DATA_SIZE, GkcBulkSender::MAX_STANDARD_CHUNK_SIZE})
+  {
+    auto a = BulkEndpoint(16);
+    auto b = BulkEndpoint(16);
+    // Lose the announcement, every 11th chunk, and every 4th acknowledgement
+    a.out.lost = [](const size_t & i) {return i == 0 || i % 11 == 5;};
+    b.out.lost = [](const size_t & i) {return i % 4 == 3;};
+    run_bulk_transfer(a, b, data, chunk_size);
+    ASSERT_EQ(a.sender.state(), GkcBulkSender::State::Complete);
+    EXPECT_EQ(b.receiver.state(), GkcBulkReceiver::State::Complete);
+    EXPECT_EQ(b.data, data);
+    EXPECT_GT(a.sender.get_statistics().retransmissions, 0u);
+    EXPECT_GT(b.receiver.get_statistics().chunks_dropped, 0u);
+  }
+  SUCCEED();
+}
+
+TEST(TestGkcBulkTransfer, Failures) {
+  using tritonai::gkc::GkcBulkSender;
+  using tritonai::gkc::GkcBulkReceiver;
+  auto data = random_bytes(10000);
+  const size_t chunk_size = GkcBulkSender::MAX_STANDARD_CHUNK_SIZE;
+
+  // Data that changes after the announcement fails the CRC
+  auto a = BulkEndpoint(8);
+  auto b = BulkEndpoint(8);
+  ASSERT_TRUE(a.sender.start(7, data, chunk_size, 0));
+  data[5000] ^= 0x01;
+  for (uint32_t now_ms = 0; now_ms < 1000; ++now_ms) {
+    a.now_ms = b.now_ms = now_ms;
+    a.out.deliver(now_ms, b.factory);
+    b.out.deliver(now_ms, a.factory);
+    a.sender.poll(now_ms, [&a](const auto & packet) {return a.send(packet);});
+  }
+  EXPECT_EQ(a.sender.state(), GkcBulkSender::State::Failed);
+  EXPECT_EQ(b.receiver.state(), GkcBulkReceiver::State::Failed);
+
+  // A receiver without room rejects the transfer
+  auto c = BulkEndpoint(8);
+  auto d = BulkEndpoint(8);
+  d.max_size = data.size() - 1;
+  run_bulk_transfer(c, d, data, chunk_size);
+  EXPECT_EQ(c.sender.state(), GkcBulkSender::State::Failed);
+  EXPECT_EQ(c.sender.num_acknowledged(), 0u);
+
+  // Chunks of an abandoned transfer are ignored
+  auto chunk = tritonai::gkc::BulkChunkGkcPacket();
+  chunk.transfer_id = d.receiver.transfer().transfer_id;
+  auto num_acks = size_t{0};
+  d.receiver.reset();
+  EXPECT_EQ(d.receiver.receive(chunk, [&num_acks](const auto &) {return ++num_acks;}),
+    GkcBulkReceiver::State::Idle);
+  EXPECT_EQ(num_acks, 0u);
+
+  // Without a receiver, the sender gives up
+  auto e = BulkEndpoint(8);
+  auto f = BulkEndpoint(8);
+  e.out.lost = [](const size_t &) {return true;};
+  run_bulk_transfer(e, f, data, chunk_size);
+  EXPECT_EQ(e.sender.state(), GkcBulkSender::State::Failed);
+  EXPECT_GT(e.sender.get_statistics().timeouts, 10u);
+
+  // Out-of-range chunk sizes
+  auto sender = GkcBulkSender();
+  EXPECT_FALSE(sender.start(0, data, 0, 0));
+  EXPECT_FALSE(sender.start(0, data, tritonai::gkc::BulkChunkGkcPacket::MAX_DATA_SIZE + 1, 0));
+  SUCCEED();
+}
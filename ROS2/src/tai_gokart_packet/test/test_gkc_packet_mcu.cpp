@@ -0,0 +1,180 @@
+/**
+ * @file test_gkc_packet_mcu.cpp
+ * @brief Tests of the MCU profile, built with -fno-exceptions -fno-rtti
+ * @version 0.1
+ *
+ * @copyright Copyright (c) 2026 [Triton AI]
+ *
+ */
+
+#ifndef GKC_PACKET_MCU_PROFILE
+#error "This test must be built with GKC_PACKET_MCU_PROFILE."
+#endif
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "gtest/gtest.h"
+
+#include "tai_gokart_packet/gkc_packet_factory.hpp"
+#include "gkc_golden_frames.hpp"
+
+// Count every heap allocation made by this test executable.
+// Not inlined, so that GCC does not pair malloc() and free() across the replacements.
+static std::atomic<size_t> g_num_allocations {0};
+__attribute__((noinline)) void * operator new(std::size_t size)
+{
+  ++g_num_allocations;
+  if (void * ptr = std::malloc(size ? size : 1)) {
+    return ptr;
+  }
+  std::abort();
+}
+__attribute__((noinline)) void operator delete(void * ptr) noexcept {std::free(ptr);}
+__attribute__((noinline)) void operator delete(void * ptr, std::size_t) noexcept {std::free(ptr);}
+
+class McuSub : public tritonai::gkc::GkcPacketSubscriber
+{
+public:
+  void packet_callback(const tritonai::gkc::Handshake1GkcPacket & packet) {(void)packet; ++count;}
+  void packet_callback(const tritonai::gkc::Handshake2GkcPacket & packet) {(void)packet; ++count;}
+  void packet_callback(const tritonai::gkc::GetFirmwareVersionGkcPacket & packet)
+  {
+    (void)packet;
+    ++count;
+  }
+  void packet_callback(const tritonai::gkc::FirmwareVersionGkcPacket & packet)
+  {
+    (void)packet;
+    ++count;
+  }
+  void packet_callback(const tritonai::gkc::ResetMcuGkcPacket & packet) {(void)packet; ++count;}
+  void packet_callback(const tritonai::gkc::HeartbeatGkcPacket & packet) {(void)packet; ++count;}
+  void packet_callback(const tritonai::gkc::ConfigGkcPacket & packet) {(void)packet; ++count;}
+  void packet_callback(const tritonai::gkc::StateTransitionGkcPacket & packet)
+  {
+    (void)packet;
+    ++count;
+  }
+  void packet_callback(const tritonai::gkc::ControlGkcPacket & packet)
+  {
+    throttle = packet.throttle;
+    ++count;
+  }
+  void packet_callback(const tritonai::gkc::SensorGkcPacket & packet) {(void)packet; ++count;}
+  void packet_callback(const tritonai::gkc::Shutdown1GkcPacket & packet) {(void)packet; ++count;}
+  void packet_callback(const tritonai::gkc::Shutdown2GkcPacket & packet) {(void)packet; ++count;}
+  void packet_callback(const tritonai::gkc::CompactSensorGkcPacket & packet)
+  {
+    (void)packet;
+    ++count;
+  }
+  void packet_callback(const tritonai::gkc::CompactControlGkcPacket & packet)
+  {
+    throttle = packet.throttle;
+    ++count;
+  }
+  void packet_callback(const tritonai::gkc::SensorDeltaGkcPacket & packet)
+  {
+    (void)packet;
+    ++count;
+  }
+  void packet_callback(const tritonai::gkc::SensorResyncGkcPacket & packet)
+  {
+    (void)packet;
+    ++count;
+  }
+  void packet_callback(const tritonai::gkc::SensorBatchGkcPacket & packet)
+  {
+    (void)packet;
+    ++count;
+  }
+  void packet_callback(const tritonai::gkc::BulkRequestGkcPacket & packet)
+  {
+    (void)packet;
+    ++count;
+  }
+  void packet_callback(const tritonai::gkc::BulkStartGkcPacket & packet)
+  {
+    (void)packet;
+    ++count;
+  }
+  void packet_callback(const tritonai::gkc::BulkChunkGkcPacket & packet)
+  {
+    (void)packet;
+    ++count;
+  }
+  void packet_callback(const tritonai::gkc::BulkAckGkcPacket & packet)
+  {
+    (void)packet;
+    ++count;
+  }
+  void packet_callback(const tritonai::gkc::LogFilterGkcPacket & packet)
+  {
+    (void)packet;
+    ++count;
+  }
+  void packet_callback(const tritonai::gkc::LogIdGkcPacket & packet)
+  {
+    log_id_matches = packet.id == static_cast<uint16_t>(tritonai::gkc::GkcLogId::BRAKE_FAULT);
+    ++count;
+  }
+  void packet_callback(const tritonai::gkc::LogPacket & packet)
+  {
+    log_matches = packet.what == "Hello World";
+    ++count;
+  }
+
+  size_t count = 0;
+  float throttle = 0.0f;
+  bool log_matches = false;
+  bool log_id_matches = false;
+};
+
+TEST(TestGkcPacketMcu, GoldenFrames) {
+  const size_t num_allocations_before = g_num_allocations;
+  size_t i = 0;
+  gkc_golden::visit_packets(
+    [&i](const auto & packet) {
+      ASSERT_LT(i, gkc_golden::NUM_FRAMES);
+      const auto & golden = gkc_golden::FRAMES[i++];
+      std::array<uint8_t, tritonai::gkc::GkcFrameFormat::MAX_FRAME_SIZE> frame {};
+      const size_t frame_size = packet.encode_into(frame);
+      EXPECT_EQ(frame_size, golden.size) << golden.name;
+      EXPECT_TRUE(std::equal(frame.begin(), frame.begin() + frame_size, golden.bytes))
+        << golden.name;
+    });
+  EXPECT_EQ(i, gkc_golden::NUM_FRAMES);
+  EXPECT_EQ(g_num_allocations - num_allocations_before, 0u);
+  SUCCEED();
+}
+
+TEST(TestGkcPacketMcu, ReceiveGoldenFrames) {
+  static McuSub sub;
+  static tritonai::gkc::GkcPacketFactory factory(&sub, tritonai::gkc::GkcPacketUtils::debug_none);
+  const size_t num_allocations_before = g_num_allocations;
+  for (size_t i = 0; i < gkc_golden::NUM_FRAMES; ++i) {
+    const auto & golden = gkc_golden::FRAMES[i];
+    factory.Receive(tritonai::gkc::GkcBufferView(golden.bytes, golden.size));
+  }
+  EXPECT_EQ(g_num_allocations - num_allocations_before, 0u);
+  EXPECT_EQ(sub.count, gkc_golden::NUM_FRAMES);
+  EXPECT_EQ(sub.throttle, 0.25f);
+  EXPECT_TRUE(sub.log_matches);
+  EXPECT_TRUE(sub.log_id_matches);
+  SUCCEED();
+}
+
+TEST(TestGkcPacketMcu, LogPacketTruncated) {
+  auto log = tritonai::gkc::LogPacket();
+  char what[300];
+  std::fill(what, what + sizeof(what) - 1, 'x');
+  what[sizeof(what) - 1] = '\0';
+  log.what = what;
+  EXPECT_EQ(log.what.size(), tritonai::gkc::LogPacket::MAX_WHAT_SIZE);
+  EXPECT_EQ(log.payload_size(), tritonai::gkc::GkcFrameFormat::MAX_PAYLOAD_SIZE);
+  SUCCEED();
+}
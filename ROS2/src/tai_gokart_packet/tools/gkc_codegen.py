@@ -0,0 +1,939 @@
+#!/usr/bin/env python3
+# Copyright 2026 Triton AI
+"""
+Generate the packet classes, codecs, views, subscriber interface, log table and ROS message
+conversions of tai_gokart_packet from schema/gkc_packets.yaml.
+
+Usage:
+  python3 tools/gkc_codegen.py          # (re)write the generated files
+  python3 tools/gkc_codegen.py --check  # fail if a generated file is out of date
+"""
+
+import argparse
+import difflib
+import os
+import sys
+
+PACKAGE_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SCHEMA = os.path.join(PACKAGE_DIR, 'schema', 'gkc_packets.yaml')
+INCLUDE_DIR = os.path.join(PACKAGE_DIR, 'include', 'tai_gokart_packet')
+MSG_DIR = os.path.join(os.path.dirname(PACKAGE_DIR), 'tai_gokart_msgs', 'msg')
+
+# Exit code for a skipped ctest (see SKIP_RETURN_CODE in CMakeLists.txt)
+EXIT_SKIPPED = 77
+
+# schema type: (C++ type, ROS type, wire size)
+SCALAR_TYPES = {
+    'uint8': ('uint8_t', 'uint8', 1),
+    'uint16': ('uint16_t', 'uint16', 2),
+    'uint32': ('uint32_t', 'uint32', 4),
+    'int8': ('int8_t', 'int8', 1),
+    'int16': ('int16_t', 'int16', 2),
+    'int32': ('int32_t', 'int32', 4),
+    'float': ('float', 'float32', 4),
+    'double': ('double', 'float64', 8),
+    'bool': ('bool', 'bool', 1),
+}
+
+INTEGER_TYPES = ['uint8', 'uint16', 'uint32', 'int8', 'int16', 'int32']
+# the last field of a packet only, taking the rest of the payload
+VARIABLE_TYPES = ['string', 'bytes']
+
+# printf conversions of log arguments, by type
+LOG_CONVERSIONS = {t: 'diuxX' for t in INTEGER_TYPES}
+LOG_CONVERSIONS.update({'float': 'feg', 'bool': 's'})
+LOG_MAX_ARGS = 4
+
+DO_NOT_EDIT = 'Generated by tools/gkc_codegen.py from schema/gkc_packets.yaml. Do not edit.'
+
+
+class SchemaError(Exception):
+    pass
+
+
+def file_header(name, brief, author=None, date=None, year='2026'):
+    # Author and date only for files that carry over a hand-written original
+    return (
+        '/**\n'
+        f' * @file {name}\n'
+        + (f' * @author {author}\n' if author else '')
+        + f' * @brief {brief}\n'
+        f' * {DO_NOT_EDIT}\n'
+        ' * @version 0.1\n'
+        + (f' * @date {date}\n' if date else '')
+        + ' *\n'
+        f' * @copyright Copyright (c) {year} [Triton AI]\n'
+        ' *\n'
+        ' */\n')
+
+
+def guard(path):
+    return 'TAI_GOKART_PACKET__' + path.upper().replace('/', '__').replace('.', '_') + '_'
+
+
+class Field:
+    def __init__(self, spec, packet_name):
+        self.name = spec['name']
+        self.type = spec['type']
+        self.comment = spec.get('comment')
+        self.section = spec.get('section')
+        self.optional = spec.get('optional', False)
+        self.enum = spec.get('enum')
+        self.enum_values = spec.get('values', [])
+        self.resolution = spec.get('resolution')
+        self.bits = spec.get('bits', [])
+        self.max_size = spec.get('max_size')
+        if self.type in SCALAR_TYPES:
+            self.cpp_type, self.ros_type, self.size = SCALAR_TYPES[self.type]
+        elif self.type == 'enum':
+            if not self.enum or not self.enum_values:
+                raise SchemaError(f'{packet_name}.{self.name}: enum needs `enum` and `values`.')
+            self.cpp_type, self.ros_type, self.size = self.enum, 'uint8', 1
+        elif self.type == 'string':
+            self.cpp_type, self.ros_type, self.size = 'String', 'string', 0
+        elif self.type == 'bytes':
+            self.cpp_type, self.ros_type, self.size = 'Bytes', 'uint8[]', 0
+        else:
+            raise SchemaError(f'{packet_name}.{self.name}: unknown type "{self.type}".')
+        self.offset = 0
+        if self.bits and (self.type != 'uint8' or len(self.bits) > 8):
+            raise SchemaError(f'{packet_name}.{self.name}: `bits` need a uint8.')
+        if self.resolution is not None and self.type not in INTEGER_TYPES:
+            raise SchemaError(f'{packet_name}.{self.name}: fixed-point fields are integers.')
+        if self.max_size is not None and self.type != 'bytes':
+            raise SchemaError(f'{packet_name}.{self.name}: only bytes have a `max_size`.')
+
+    def declaration(self, indent, initialize=True):
+        lines = []
+        if self.section is not None:
+            if self.section:
+                lines.append(f'{indent}// {self.section}')
+        init = ' = 0' if initialize else ''
+        line = f'{indent}{self.cpp_type} {self.name}{init};'
+        if self.comment:
+            line += f'  // {self.comment}'
+        lines.append(line)
+        return lines
+
+
+class Packet:
+    def __init__(self, spec):
+        self.name = spec['name']
+        self.first_byte = spec['first_byte']
+        self.view = spec.get('view')
+        self.compact_of = spec.get('compact_of')
+        self.full = None  # the packet named by `compact_of`, see resolve_compact()
+        self.delta_of = spec.get('delta_of')
+        self.compact = None  # the packet named by `delta_of`, see resolve_delta()
+        self.batch_of = spec.get('batch_of')
+        struct = spec.get('struct')
+        if struct and spec.get('fields'):
+            raise SchemaError(f'{self.name}: use either `fields` or `struct`.')
+        self.struct_name = struct['name'] if struct else None
+        self.struct_member = struct['member'] if struct else None
+        field_specs = struct['fields'] if struct else spec.get('fields', [])
+        self.fields = [Field(f, self.name) for f in field_specs]
+
+        offset = 1  # after the first byte
+        for i, field in enumerate(self.fields):
+            field.offset = offset
+            offset += field.size
+            last = i == len(self.fields) - 1
+            if (field.optional or field.type in VARIABLE_TYPES) and not last:
+                raise SchemaError(f'{self.name}.{field.name} must be the last field.')
+            if self.struct_name and field.type not in SCALAR_TYPES:
+                raise SchemaError(f'{self.name}.{field.name}: structs only hold scalars.')
+            if field.optional and field.type not in SCALAR_TYPES:
+                raise SchemaError(f'{self.name}.{field.name}: only scalars can be optional.')
+        self.variable = next((f for f in self.fields if f.type in VARIABLE_TYPES), None)
+        self.optional = next((f for f in self.fields if f.optional), None)
+        # size without the optional field or the string or bytes
+        self.payload_size = offset - (self.optional.size if self.optional else 0)
+        if self.view and (self.variable or self.optional):
+            raise SchemaError(f'{self.name}: views need a fixed layout.')
+        if self.variable and self.variable.max_size is not None and \
+                self.variable.max_size > 255 - self.payload_size:
+            raise SchemaError(f'{self.name}.{self.variable.name}: `max_size` exceeds a frame.')
+
+    def value_prefix(self):
+        return f'{self.struct_member}.' if self.struct_name else ''
+
+    def resolve_compact(self, by_name):
+        """Check that every field of the full packet is encoded exactly once."""
+        self.full = by_name.get(self.compact_of)
+        if not self.full or self.full.compact_of:
+            raise SchemaError(f'{self.name}: unknown packet "{self.compact_of}".')
+        if self.struct_name or self.variable or self.optional or self.view:
+            raise SchemaError(f'{self.name}: compact packets only list fields.')
+        full_fields = {f.name: f for f in self.full.fields}
+        encoded = []
+        for field in self.fields:
+            names = field.bits or [field.name]
+            for name in names:
+                full_field = full_fields.get(name)
+                if not full_field:
+                    raise SchemaError(f'{self.name}.{name} is not a field of {self.full.name}.')
+                if field.bits and full_field.type != 'bool':
+                    raise SchemaError(f'{self.name}.{field.name}: `bits` must be bools.')
+                if field.resolution is not None and full_field.type not in ['float', 'double']:
+                    raise SchemaError(f'{self.name}.{name}: only floats are fixed-point.')
+                if not field.bits and field.resolution is None and field.type != full_field.type:
+                    raise SchemaError(f'{self.name}.{name}: type differs from {self.full.name}.')
+            encoded += names
+        missing = [f.name for f in self.full.fields if f.name not in encoded]
+        if missing or len(encoded) != len(set(encoded)):
+            raise SchemaError(f'{self.name} must encode every field of {self.full.name} once.')
+
+    def resolve_delta(self, by_name):
+        self.compact = by_name.get(self.delta_of)
+        if not self.compact or not self.compact.compact_of or not self.compact.full.struct_name:
+            raise SchemaError(f'{self.name}: `delta_of` must be a compact packet of a struct.')
+        if self.fields or self.struct_name or self.view:
+            raise SchemaError(f'{self.name}: delta packets have no fields of their own.')
+        if len(self.compact.fields) > 15:
+            raise SchemaError(f'{self.name}: {self.delta_of} has too many fields for a delta.')
+        # keyframe id and bit mask of changed fields
+        self.payload_size = 4
+
+    def resolve_batch(self, by_name):
+        self.compact = by_name.get(self.batch_of)
+        if not self.compact or not self.compact.compact_of or not self.compact.full.struct_name:
+            raise SchemaError(f'{self.name}: `batch_of` must be a compact packet of a struct.')
+        if self.fields or self.struct_name or self.view:
+            raise SchemaError(f'{self.name}: batch packets have no fields of their own.')
+        # timestamp and number of samples
+        self.payload_size = 6
+
+    def full_field(self, name):
+        return next(f for f in self.full.fields if f.name == name)
+
+
+class Log:
+    def __init__(self, spec, log_packet):
+        self.id = spec['id']
+        self.name = spec['name']
+        self.level = spec['level']
+        self.format = spec['format']
+        self.args = [Field(a, self.name) for a in spec.get('args', [])]
+        level_field = log_packet.fields[0]
+        if self.level not in level_field.enum_values:
+            raise SchemaError(f'{self.name}: unknown level "{self.level}".')
+        if not 0 < self.id <= 0xFFFF:
+            raise SchemaError(f'{self.name}: IDs are from 1 to 65535.')
+        if len(self.args) > LOG_MAX_ARGS:
+            raise SchemaError(f'{self.name}: at most {LOG_MAX_ARGS} arguments.')
+        if sum(a.size for a in self.args) > log_packet.variable.max_size:
+            raise SchemaError(f'{self.name}: arguments exceed {log_packet.name}.')
+        conversions = self.conversions()
+        if len(conversions) != len(self.args):
+            raise SchemaError(f'{self.name}: one conversion per argument in the format.')
+        for arg, conversion in zip(self.args, conversions):
+            if arg.type not in LOG_CONVERSIONS:
+                raise SchemaError(f'{self.name}.{arg.name}: arguments are scalars.')
+            if conversion not in LOG_CONVERSIONS[arg.type]:
+                raise SchemaError(f'{self.name}.{arg.name}: %{conversion} does not print '
+                                  f'{arg.type}.')
+
+    def conversions(self):
+        """Conversion letters of the format, in order."""
+        letters = []
+        i = 0
+        while i < len(self.format):
+            if self.format[i] != '%':
+                i += 1
+                continue
+            if self.format[i + 1:i + 2] == '%':
+                i += 2
+                continue
+            i += 1
+            while i < len(self.format) and self.format[i] in '-+ #0123456789.':
+                i += 1
+            if i == len(self.format):
+                raise SchemaError(f'{self.name}: incomplete conversion in the format.')
+            letters.append(self.format[i])
+            i += 1
+        return letters
+
+
+def load_schema():
+    try:
+        import yaml
+    except ImportError:
+        print('PyYAML is not installed (pip install pyyaml).', file=sys.stderr)
+        sys.exit(EXIT_SKIPPED)
+    with open(SCHEMA) as f:
+        schema = yaml.safe_load(f)
+    packets = [Packet(p) for p in schema['packets']]
+    by_name = {p.name: p for p in packets}
+    for p in packets:
+        if p.compact_of:
+            p.resolve_compact(by_name)
+    for p in packets:
+        if p.delta_of:
+            p.resolve_delta(by_name)
+        elif p.batch_of:
+            p.resolve_batch(by_name)
+    first_bytes = [p.first_byte for p in packets]
+    if len(set(first_bytes)) != len(first_bytes):
+        raise SchemaError('First bytes must be unique.')
+    logs = [Log(log, by_name['LogIdGkcPacket']) for log in schema.get('logs', [])]
+    if len({log.id for log in logs}) != len(logs) or len({log.name for log in logs}) != len(logs):
+        raise SchemaError('Log IDs and names must be unique.')
+    logs.sort(key=lambda log: log.id)
+    return packets, schema.get('messages', []), logs
+
+
+def gen_packet_defs(packets):
+    path = 'generated/gkc_packet_defs.hpp'
+    out = [file_header('gkc_packet_defs.hpp', 'Packet classes'), '\n']
+    out.append(f'#ifndef {guard(path)}\n#define {guard(path)}\n\n')
+    out.append('#ifndef TAI_GOKART_PACKET__GKC_PACKETS_HPP_\n'
+               '#error "Include tai_gokart_packet/gkc_packets.hpp instead."\n#endif\n\n')
+    out.append('namespace tritonai\n{\nnamespace gkc\n{\n')
+    for p in packets:
+        if p.compact_of:
+            out.append(gen_compact_def(p))
+            continue
+        if p.delta_of:
+            out.append(gen_delta_def(p))
+            continue
+        if p.batch_of:
+            out.append(gen_batch_def(p))
+            continue
+        out.append(f'class {p.name} : public GkcPacket\n{{\npublic:\n')
+        out.append(f'  static constexpr uint8_t FIRST_BYTE = 0x{p.first_byte:02X};\n')
+        if p.struct_name:
+            out.append(f'  struct __attribute__((packed)) {p.struct_name}\n  {{\n')
+            for i, field in enumerate(p.fields):
+                if field.section is not None and i > 0:
+                    out.append('\n')
+                out.extend(line + '\n' for line in field.declaration('    ', initialize=False))
+            out.append(f'  }} {p.struct_member};\n')
+        for field in p.fields:
+            if field.type == 'enum':
+                out.append(f'  enum {field.enum}\n  {{\n')
+                out.append(',\n'.join(f'    {v} = {i}' for i, v in enumerate(field.enum_values)))
+                out.append(f'\n  }} {field.name} = {field.enum_values[0]};\n')
+            elif field.type == 'string':
+                max_size = f'MAX_{field.name.upper()}_SIZE'
+                out.append(
+                    f'  static constexpr size_t {max_size} = '
+                    f'GkcFrameFormat::MAX_PAYLOAD_SIZE - {field.offset};\n'
+                    '#ifndef GKC_PACKET_MCU_PROFILE\n'
+                    '  typedef std::string String;\n'
+                    '#else\n'
+                    f'  typedef GkcFixedString<{max_size}> String;\n'
+                    '#endif\n'
+                    f'  String {field.name};\n')
+            elif field.type == 'bytes':
+                # sent in an extended frame beyond `GkcFrameFormat::MAX_PAYLOAD_SIZE`
+                max_size = f'MAX_{field.name.upper()}_SIZE'
+                size = field.max_size if field.max_size is not None else \
+                    f'GkcFrameFormat::MAX_EXTENDED_PAYLOAD_SIZE - {field.offset}'
+                comment = f'  // {field.comment}' if field.comment else ''
+                out.append(
+                    f'  static constexpr size_t {max_size} = {size};\n'
+                    f'  typedef GkcInlineBuffer<{max_size}> Bytes;\n'
+                    f'  Bytes {field.name};{comment}\n')
+            elif not p.struct_name:
+                out.extend(line + '\n' for line in field.declaration('  '))
+        if p.variable:
+            out.append(f'  static constexpr size_t MIN_PAYLOAD_SIZE = {p.payload_size};\n')
+            out.append(f'  size_t payload_size() const;  // `{p.variable.name}` beyond '
+                       f'`MAX_{p.variable.name.upper()}_SIZE` is truncated\n')
+        else:
+            out.append(f'  static constexpr size_t PAYLOAD_SIZE = {p.payload_size};\n')
+            if p.struct_name:
+                out.append(f'  static_assert(sizeof({p.struct_name}) + 1 == PAYLOAD_SIZE, '
+                           f'"{p.struct_name} must be packed.");\n')
+            if p.optional:
+                out.append(f'  size_t payload_size() const\n  {{\n'
+                           f'    return {p.optional.name} ? PAYLOAD_SIZE + '
+                           f'{p.optional.size} : PAYLOAD_SIZE;\n  }}\n')
+            else:
+                out.append('  size_t payload_size() const {return PAYLOAD_SIZE;}\n')
+        out.append('  void encode_payload(uint8_t * payload) const;\n'
+                   '  using GkcPacket::decode;\n'
+                   '  void decode(const GkcBufferView & payload);\n'
+                   '  void publish(GkcPacketSubscriber & sub) {sub.packet_callback(*this);}\n'
+                   '};\n\n')
+    out.append('template<typename ... Ts>\nstruct GkcPacketTypeList {};\n\n')
+    out.append('/**\n * @brief All packets the factory can receive\n */\n'
+               'using GkcPacketTypes = GkcPacketTypeList<\n')
+    out.append(',\n'.join(f'  {p.name}' for p in packets))
+    out.append('>;\n}  // namespace gkc\n}  // namespace tritonai\n')
+    out.append(f'#endif  // {guard(path)}\n')
+    return path, ''.join(out)
+
+
+def resolution_name(field):
+    return f'{field.name.upper()}_RESOLUTION'
+
+
+def gen_compact_def(p):
+    full = p.full
+    out = [f'/**\n * @brief `{full.name}` in a compact encoding\n */\n'
+           f'class {p.name} : public GkcPacket\n{{\npublic:\n'
+           f'  static constexpr uint8_t FIRST_BYTE = 0x{p.first_byte:02X};\n']
+    if full.struct_name:
+        out.append(f'  {full.name}::{full.struct_name} {full.struct_member};\n')
+    else:
+        for field in full.fields:
+            out.extend(line + '\n' for line in field.declaration('  '))
+    fixed = [f for f in p.fields if f.resolution is not None]
+    if fixed:
+        out.append('  // resolution of the fixed-point fields\n')
+    for field in fixed:
+        cpp_type = p.full_field(field.name).cpp_type
+        literal = repr(float(field.resolution)) + ('f' if cpp_type == 'float' else '')
+        out.append(f'  static constexpr {cpp_type} {resolution_name(field)} = {literal};\n')
+    out.append(f'  static constexpr size_t PAYLOAD_SIZE = {p.payload_size};\n'
+               '  size_t payload_size() const {return PAYLOAD_SIZE;}\n'
+               f'  {p.name}() = default;\n'
+               f'  explicit {p.name}(const {full.name} & packet);\n'
+               f'  {full.name} expand() const;\n'
+               '  void encode_payload(uint8_t * payload) const;\n'
+               '  using GkcPacket::decode;\n'
+               '  void decode(const GkcBufferView & payload);\n'
+               '  void publish(GkcPacketSubscriber & sub) {sub.packet_callback(*this);}\n'
+               '};\n\n')
+    return ''.join(out)
+
+
+def gen_compact_codec(p):
+    prefix = p.full.value_prefix()
+    encode, decode = [], []
+    for field in p.fields:
+        if field.bits:
+            encode.append(f'payload[{field.offset}] = static_cast<uint8_t>(\n' + ' |\n'.join(
+                f'    ({prefix}{bit} << {i})' for i, bit in enumerate(field.bits)) + ');')
+            decode.extend(f'{prefix}{bit} = payload[{field.offset}] & 0x{1 << i:02X};'
+                          for i, bit in enumerate(field.bits))
+        elif field.resolution is not None:
+            name = prefix + field.name
+            encode.append(f'GkcPacketUtils::write_fixed_point<{field.cpp_type}>(\n'
+                          f'    payload + {field.offset}, {name}, {resolution_name(field)});')
+            decode.append(f'{name} = GkcPacketUtils::read_fixed_point<{field.cpp_type}>(\n'
+                          f'    payload.data() + {field.offset}, {resolution_name(field)});')
+        else:
+            name = prefix + field.name
+            encode.append(f'GkcPacketUtils::write_to_buffer(payload + {field.offset}, '
+                          f'{name});')
+            decode.append(f'GkcPacketUtils::read_from_buffer(payload.data() + '
+                          f'{field.offset}, {name});')
+    if p.full.struct_name:
+        members = [p.full.struct_member]
+    else:
+        members = [f.name for f in p.full.fields]
+
+    out = [f'/*\n{p.name}\n*/\n']
+    out.append(f'GKC_PACKET_INLINE {p.name}::{p.name}(\n  const {p.full.name} & packet)\n{{\n')
+    out.extend(f'  {m} = packet.{m};\n' for m in members)
+    out.append('}\n\n')
+    out.append(f'GKC_PACKET_INLINE {p.full.name} {p.name}::expand() const\n{{\n'
+               f'  auto packet = {p.full.name}();\n')
+    out.extend(f'  packet.{m} = {m};\n' for m in members)
+    out.append('  return packet;\n}\n\n')
+    out.append(f'GKC_PACKET_INLINE void {p.name}::encode_payload(uint8_t * payload) const\n'
+               '{\n  payload[0] = FIRST_BYTE;\n')
+    out.extend(f'  {line}\n' for line in encode)
+    out.append('}\n\n')
+    out.append(f'GKC_PACKET_INLINE void {p.name}::decode(const GkcBufferView & payload)\n{{\n')
+    out.extend(f'  {line}\n' for line in decode)
+    out.append('}\n\n')
+    return ''.join(out)
+
+
+def gen_delta_def(p):
+    full = p.compact.full
+    values = f'{full.name}::{full.struct_name}'
+    num_fields = len(p.compact.fields)
+    offsets = [f.offset for f in p.compact.fields] + [p.compact.payload_size]
+    return (
+        f'/**\n * @brief The fields of `{p.compact.name}` that changed since a keyframe\n */\n'
+        f'class {p.name} : public GkcPacket\n{{\npublic:\n'
+        f'  typedef {p.compact.name} Compact;\n'
+        f'  static constexpr uint8_t FIRST_BYTE = 0x{p.first_byte:02X};\n'
+        f'  static constexpr size_t NUM_FIELDS = {num_fields};\n'
+        f'  static constexpr uint16_t ALL_FIELDS = 0x{(1 << num_fields) - 1:04X};\n'
+        '  static constexpr uint16_t KEYFRAME = 0x8000;  // flag in `changed`\n'
+        '  uint8_t keyframe_id = 0;  // keyframe that the unchanged fields are taken from\n'
+        '  uint16_t changed = 0;  // bit i is set if field i of `Compact` is sent\n'
+        f'  {values} {full.struct_member};  // only the changed fields are valid\n'
+        f'  static constexpr size_t MIN_PAYLOAD_SIZE = {p.payload_size};\n'
+        '  size_t payload_size() const;\n'
+        f'  // Set `changed` to the fields of `{full.struct_member}` that differ from `keyframe` '
+        'once encoded\n'
+        f'  void set_changes(const {values} & keyframe);\n'
+        f'  // Copy the changed fields into `keyframe`\n'
+        f'  void apply_to({values} & keyframe) const;\n'
+        '  void encode_payload(uint8_t * payload) const;\n'
+        '  using GkcPacket::decode;\n'
+        '  void decode(const GkcBufferView & payload);\n'
+        '  void publish(GkcPacketSubscriber & sub) {sub.packet_callback(*this);}\n\n'
+        'private:\n'
+        '  // where the fields are in the payload of `Compact`\n'
+        '  static constexpr uint8_t FIELD_OFFSETS[NUM_FIELDS + 1] = {\n'
+        f'    {", ".join(str(o) for o in offsets)}}};\n'
+        '};\n\n')
+
+
+def gen_delta_codec(p):
+    full = p.compact.full
+    values = f'{full.name}::{full.struct_name}'
+    member = full.struct_member
+    out = [f'/*\n{p.name}\n*/\n']
+    out.append(f'GKC_PACKET_INLINE size_t {p.name}::payload_size() const\n{{\n'
+               '  size_t size = MIN_PAYLOAD_SIZE;\n'
+               '  for (size_t i = 0; i < NUM_FIELDS; ++i) {\n'
+               '    if (changed & (1 << i)) {\n'
+               '      size += FIELD_OFFSETS[i + 1] - FIELD_OFFSETS[i];\n'
+               '    }\n  }\n  return size;\n}\n\n')
+    out.append(f'GKC_PACKET_INLINE void {p.name}::set_changes(\n  const {values} & keyframe)\n{{\n'
+               '  uint8_t now[Compact::PAYLOAD_SIZE];\n'
+               '  uint8_t before[Compact::PAYLOAD_SIZE];\n'
+               '  auto compact = Compact();\n'
+               f'  compact.{member} = {member};\n'
+               '  compact.encode_payload(now);\n'
+               f'  compact.{member} = keyframe;\n'
+               '  compact.encode_payload(before);\n'
+               '  changed = 0;\n'
+               '  for (size_t i = 0; i < NUM_FIELDS; ++i) {\n'
+               '    const size_t offset = FIELD_OFFSETS[i];\n'
+               '    if (std::memcmp(now + offset, before + offset, '
+               'FIELD_OFFSETS[i + 1] - offset) != 0) {\n'
+               '      changed |= 1 << i;\n'
+               '    }\n  }\n}\n\n')
+    out.append(f'GKC_PACKET_INLINE void {p.name}::apply_to(\n  {values} & keyframe) const\n{{\n')
+    for i, field in enumerate(p.compact.fields):
+        out.append(f'  if (changed & 0x{1 << i:04X}) {{\n')
+        out.extend(f'    keyframe.{name} = {member}.{name};\n'
+                   for name in field.bits or [field.name])
+        out.append('  }\n')
+    out.append('}\n\n')
+    out.append(f'GKC_PACKET_INLINE void {p.name}::encode_payload(uint8_t * payload) const\n{{\n'
+               '  uint8_t fields[Compact::PAYLOAD_SIZE];\n'
+               '  auto compact = Compact();\n'
+               f'  compact.{member} = {member};\n'
+               '  compact.encode_payload(fields);\n'
+               '  payload[0] = FIRST_BYTE;\n'
+               '  payload[1] = keyframe_id;\n'
+               '  GkcPacketUtils::write_to_buffer(payload + 2, changed);\n'
+               '  uint8_t * next = payload + MIN_PAYLOAD_SIZE;\n'
+               '  for (size_t i = 0; i < NUM_FIELDS; ++i) {\n'
+               '    if (changed & (1 << i)) {\n'
+               '      next = std::copy(fields + FIELD_OFFSETS[i], '
+               'fields + FIELD_OFFSETS[i + 1], next);\n'
+               '    }\n  }\n}\n\n')
+    out.append(f'GKC_PACKET_INLINE void {p.name}::decode(const GkcBufferView & payload)\n{{\n'
+               '  // A payload shorter than `changed` announces does not change anything\n'
+               '  changed = 0;\n'
+               '  if (payload.size() < MIN_PAYLOAD_SIZE) {\n    return;\n  }\n'
+               '  keyframe_id = payload[1];\n'
+               '  GkcPacketUtils::read_from_buffer(payload.data() + 2, changed);\n'
+               '  if (payload.size() < payload_size()) {\n'
+               '    changed = 0;\n    return;\n  }\n'
+               '  uint8_t fields[Compact::PAYLOAD_SIZE] = {};\n'
+               '  const uint8_t * next = payload.data() + MIN_PAYLOAD_SIZE;\n'
+               '  for (size_t i = 0; i < NUM_FIELDS; ++i) {\n'
+               '    if (changed & (1 << i)) {\n'
+               '      const size_t size = FIELD_OFFSETS[i + 1] - FIELD_OFFSETS[i];\n'
+               '      std::copy(next, next + size, fields + FIELD_OFFSETS[i]);\n'
+               '      next += size;\n'
+               '    }\n  }\n'
+               '  auto compact = Compact();\n'
+               '  compact.decode(GkcBufferView(fields, Compact::PAYLOAD_SIZE));\n'
+               f'  {member} = compact.{member};\n'
+               '}\n\n')
+    return ''.join(out)
+
+
+def gen_batch_def(p):
+    full = p.compact.full
+    return (
+        f'/**\n * @brief Up to `MAX_SAMPLES` timestamped samples of `{p.compact.name}`\n */\n'
+        f'class {p.name} : public GkcPacket\n{{\npublic:\n'
+        f'  typedef {p.compact.name} Compact;\n'
+        f'  static constexpr uint8_t FIRST_BYTE = 0x{p.first_byte:02X};\n'
+        f'  static constexpr size_t MIN_PAYLOAD_SIZE = {p.payload_size};\n'
+        '  // time offset and the payload of `Compact` without its first byte\n'
+        '  static constexpr size_t SAMPLE_SIZE = sizeof(uint16_t) + Compact::PAYLOAD_SIZE - 1;\n'
+        '  static constexpr size_t MAX_SAMPLES =\n'
+        '    (GkcFrameFormat::MAX_PAYLOAD_SIZE - MIN_PAYLOAD_SIZE) / SAMPLE_SIZE;\n'
+        '  struct Sample\n  {\n'
+        '    uint16_t time_offset_us;  // since `timestamp_us`\n'
+        f'    {full.name}::{full.struct_name} {full.struct_member};\n'
+        '  };\n'
+        '  uint32_t timestamp_us = 0;  // MCU time of the batch in microsecond\n'
+        '  uint8_t num_samples = 0;  // samples beyond `MAX_SAMPLES` are not sent\n'
+        '  std::array<Sample, MAX_SAMPLES> samples;\n'
+        '  size_t payload_size() const;\n'
+        '  void encode_payload(uint8_t * payload) const;\n'
+        '  using GkcPacket::decode;\n'
+        '  void decode(const GkcBufferView & payload);\n'
+        '  void publish(GkcPacketSubscriber & sub) {sub.packet_callback(*this);}\n'
+        '};\n\n')
+
+
+def gen_batch_codec(p):
+    member = p.compact.full.struct_member
+    return (
+        f'/*\n{p.name}\n*/\n'
+        f'GKC_PACKET_INLINE size_t {p.name}::payload_size() const\n{{\n'
+        '  return MIN_PAYLOAD_SIZE + std::min<size_t>(num_samples, MAX_SAMPLES) * SAMPLE_SIZE;\n'
+        '}\n\n'
+        f'GKC_PACKET_INLINE void {p.name}::encode_payload(uint8_t * payload) const\n{{\n'
+        '  const auto count = static_cast<uint8_t>(std::min<size_t>(num_samples, MAX_SAMPLES));\n'
+        '  payload[0] = FIRST_BYTE;\n'
+        '  GkcPacketUtils::write_to_buffer(payload + 1, timestamp_us);\n'
+        '  payload[5] = count;\n'
+        '  uint8_t fields[Compact::PAYLOAD_SIZE];\n'
+        '  auto compact = Compact();\n'
+        '  uint8_t * next = payload + MIN_PAYLOAD_SIZE;\n'
+        '  for (size_t i = 0; i < count; ++i) {\n'
+        '    next = GkcPacketUtils::write_to_buffer(next, samples[i].time_offset_us);\n'
+        f'    compact.{member} = samples[i].{member};\n'
+        '    compact.encode_payload(fields);\n'
+        '    next = std::copy(fields + 1, fields + Compact::PAYLOAD_SIZE, next);\n'
+        '  }\n}\n\n'
+        f'GKC_PACKET_INLINE void {p.name}::decode(const GkcBufferView & payload)\n{{\n'
+        '  // Only the samples that are complete in the payload are decoded\n'
+        '  num_samples = 0;\n'
+        '  if (payload.size() < MIN_PAYLOAD_SIZE) {\n    return;\n  }\n'
+        '  GkcPacketUtils::read_from_buffer(payload.data() + 1, timestamp_us);\n'
+        '  const size_t count = std::min<size_t>(\n'
+        '    {payload[5], MAX_SAMPLES, (payload.size() - MIN_PAYLOAD_SIZE) / SAMPLE_SIZE});\n'
+        '  uint8_t fields[Compact::PAYLOAD_SIZE] = {Compact::FIRST_BYTE};\n'
+        '  auto compact = Compact();\n'
+        '  const uint8_t * next = payload.data() + MIN_PAYLOAD_SIZE;\n'
+        '  for (size_t i = 0; i < count; ++i) {\n'
+        '    next = GkcPacketUtils::read_from_buffer(next, samples[i].time_offset_us);\n'
+        '    std::copy(next, next + Compact::PAYLOAD_SIZE - 1, fields + 1);\n'
+        '    next += Compact::PAYLOAD_SIZE - 1;\n'
+        '    compact.decode(GkcBufferView(fields, Compact::PAYLOAD_SIZE));\n'
+        f'    samples[i].{member} = compact.{member};\n'
+        '  }\n'
+        '  num_samples = static_cast<uint8_t>(count);\n'
+        '}\n\n')
+
+
+def gen_packet_codecs(packets):
+    path = 'generated/gkc_packet_defs.ipp'
+    out = [file_header('gkc_packet_defs.ipp', 'Packet codecs'), '\n']
+    out.append(f'#ifndef {guard(path)}\n#define {guard(path)}\n\n')
+    out.append('#include <algorithm>\n#include <cstring>\n\n'
+               '#include "tai_gokart_packet/gkc_packets.hpp"\n\n')
+    out.append('namespace tritonai\n{\nnamespace gkc\n{\n')
+    for p in packets:
+        if p.compact_of:
+            out.append(gen_compact_codec(p))
+            continue
+        if p.delta_of:
+            out.append(gen_delta_codec(p))
+            continue
+        if p.batch_of:
+            out.append(gen_batch_codec(p))
+            continue
+        prefix = p.value_prefix()
+        encode, decode = [], []
+        if p.struct_name:
+            encode.append(f'GkcPacketUtils::write_to_buffer(payload + 1, {p.struct_member});')
+            decode.append(f'GkcPacketUtils::read_from_buffer(payload.data() + 1, '
+                          f'{p.struct_member});')
+        for field in [] if p.struct_name else p.fields:
+            name = prefix + field.name
+            if field.type == 'enum':
+                encode.append(f'payload[{field.offset}] = static_cast<uint8_t>({name});')
+                decode.append(f'{name} = static_cast<{field.enum}>(payload[{field.offset}]);')
+            elif field.type == 'bytes':
+                encode.append(f'std::copy({name}.begin(), {name}.begin() + '
+                              f'(payload_size() - MIN_PAYLOAD_SIZE), payload + {field.offset});')
+                decode.append(f'// Bytes beyond the capacity of `{field.name}` are dropped\n'
+                              f'  {name}.assign(\n'
+                              f'    payload.begin() + std::min<size_t>(payload.size(), '
+                              f'{field.offset}),\n'
+                              f'    payload.begin() + std::min<size_t>(payload.size(), '
+                              f'{field.offset} + {name}.capacity()));')
+            elif field.type == 'string':
+                encode.append(f'std::copy({name}.begin(), {name}.begin() + '
+                              f'(payload_size() - MIN_PAYLOAD_SIZE), payload + {field.offset});')
+                decode.append('// char pointer overload: assigning from uint8_t iterators goes '
+                              'through a temporary string')
+                decode.append(f'{name}.assign(\n'
+                              '    reinterpret_cast<const char *>(payload.data() + '
+                              f'{field.offset}), payload.size() - {field.offset});')
+            elif field.optional:
+                encode.append(f'if ({name}) {{\n'
+                              f'    GkcPacketUtils::write_to_buffer(payload + {field.offset}, '
+                              f'{name});\n  }}')
+                decode.append(f'// Peers that do not know `{field.name}` send a shorter payload\n'
+                              f'  if (payload.size() >= PAYLOAD_SIZE + {field.size}) {{\n'
+                              f'    GkcPacketUtils::read_from_buffer(payload.data() + '
+                              f'{field.offset}, {name});\n'
+                              f'  }} else {{\n    {name} = 0;\n  }}')
+            else:
+                encode.append(f'GkcPacketUtils::write_to_buffer(payload + {field.offset}, '
+                              f'{name});')
+                decode.append(f'GkcPacketUtils::read_from_buffer(payload.data() + '
+                              f'{field.offset}, {name});')
+        if not decode:
+            decode.append('(void)payload;')
+
+        out.append(f'/*\n{p.name}\n*/\n')
+        if p.variable:
+            out.append(f'GKC_PACKET_INLINE size_t {p.name}::payload_size() const\n{{\n'
+                       f'  return std::min({p.variable.name}.size(), '
+                       f'MAX_{p.variable.name.upper()}_SIZE) + MIN_PAYLOAD_SIZE;\n}}\n\n')
+        out.append(f'GKC_PACKET_INLINE void {p.name}::encode_payload(uint8_t * payload) const\n'
+                   '{\n  payload[0] = FIRST_BYTE;\n')
+        out.extend(f'  {line}\n' for line in encode)
+        out.append('}\n\n')
+        out.append(f'GKC_PACKET_INLINE void {p.name}::decode(const GkcBufferView & payload)\n{{\n')
+        out.extend(f'  {line}\n' for line in decode)
+        out.append('}\n\n')
+    out[-1] = out[-1][:-1]
+    out.append('}  // namespace gkc\n}  // namespace tritonai\n')
+    out.append(f'#endif  // {guard(path)}\n')
+    return path, ''.join(out)
+
+
+def gen_views(packets):
+    path = 'generated/gkc_packet_view_defs.hpp'
+    out = [file_header('gkc_packet_view_defs.hpp', 'Packet views'), '\n']
+    out.append(f'#ifndef {guard(path)}\n#define {guard(path)}\n\n')
+    out.append('#ifndef TAI_GOKART_PACKET__GKC_PACKET_VIEWS_HPP_\n'
+               '#error "Include tai_gokart_packet/gkc_packet_views.hpp instead."\n#endif\n\n')
+    out.append('namespace tritonai\n{\nnamespace gkc\n{\n')
+    views = [p for p in packets if p.view]
+    for p in views:
+        out.append(f'class {p.view} : public GkcPacketView<{p.name}>\n{{\npublic:\n'
+                   '  using GkcPacketView::GkcPacketView;\n')
+        for field in p.fields:
+            out.append(f'  {field.cpp_type} {field.name}() const '
+                       f'{{return load<{field.cpp_type}>({field.offset});}}\n')
+        out.append('};\n\n')
+    for p in views:
+        out.append(f'template<>\nstruct GkcPacketViewOf<{p.name}>\n{{\n'
+                   f'  typedef {p.view} type;\n}};\n')
+    out.append('}  // namespace gkc\n}  // namespace tritonai\n')
+    out.append(f'#endif  // {guard(path)}\n')
+    return path, ''.join(out)
+
+
+def gen_subscriber(packets):
+    path = 'gkc_packet_subscriber.hpp'
+    out = [file_header('gkc_packet_subscriber.hpp',
+                       'Interface for receiving packets from the factory',
+                       author='Haoru Xue (hxue@ucsd.edu)', date='2021-11-04', year='2021')]
+    out.append(f'#ifndef {guard(path)}\n#define {guard(path)}\n')
+    out.append('namespace tritonai\n{\nnamespace gkc\n{\nclass GkcPacketFactory;\n')
+    out.extend(f'class {p.name};\n' for p in packets)
+    out.extend(f'class {p.view};\n' for p in packets if p.view)
+    out.append('/**\n'
+               ' * @brief Subclass this to receive GkcPackets from GkcPacketFactory\n *\n */\n'
+               'class GkcPacketSubscriber\n{\npublic:\n  friend GkcPacketFactory;\n')
+    out.extend(f'  virtual void packet_callback(const {p.name} & packet) = 0;\n'
+               for p in packets)
+    out.append('\n  /**\n'
+               '   * @brief Optionally inspect a frame in place before it is decoded.\n'
+               '   * Return true if the view was enough, which skips decoding and '
+               '`packet_callback`.\n'
+               '   */\n')
+    out.extend(f'  virtual bool packet_view_callback(const {p.view} & view) '
+               '{(void)view; return false;}\n' for p in packets if p.view)
+    out.append('};\n}  // namespace gkc\n}  // namespace tritonai\n\n')
+    out.append(f'#endif  // {guard(path)}\n')
+    return path, ''.join(out)
+
+
+def log_arg_type(field):
+    name = field.type.replace('uint', 'UInt').replace('int', 'Int')
+    return 'GkcLogArg::' + name[0].upper() + name[1:]
+
+
+def gen_log_defs(logs):
+    path = 'generated/gkc_log_defs.hpp'
+    out = [file_header('gkc_log_defs.hpp', 'Log IDs, formats and builders'), '\n']
+    out.append(f'#ifndef {guard(path)}\n#define {guard(path)}\n\n')
+    out.append('#ifndef TAI_GOKART_PACKET__GKC_LOGS_HPP_\n'
+               '#error "Include tai_gokart_packet/gkc_logs.hpp instead."\n#endif\n\n')
+    out.append('namespace tritonai\n{\nnamespace gkc\n{\n')
+    out.append('/**\n * @brief IDs of the logs sent as `LogIdGkcPacket`\n */\n'
+               'enum class GkcLogId : uint16_t\n{\n')
+    out.append(',\n'.join(f'  {log.name} = {log.id}' for log in logs))
+    out.append('\n};\n\n')
+    out.append('struct GkcLogFormat\n{\n'
+               '  GkcLogId id;\n'
+               '  const char * name;\n'
+               '  LogIdGkcPacket::Severity level;  // default of `GkcLogs`\n'
+               '  const char * format;  // printf format, one conversion per argument\n'
+               '  size_t num_args;\n'
+               f'  GkcLogArg args[{LOG_MAX_ARGS}];  // types, in the order of the payload\n'
+               '};\n\n')
+
+    out.append('/**\n * @brief Format of every log, sorted by ID\n */\n'
+               'inline constexpr GkcLogFormat GKC_LOG_FORMATS[] = {\n')
+    for log in logs:
+        text = log.format.replace('\\', '\\\\').replace('"', '\\"')
+        args = ', '.join(log_arg_type(a) for a in log.args)
+        out.append(f'  {{GkcLogId::{log.name}, "{log.name}", LogIdGkcPacket::{log.level},\n'
+                   f'    "{text}", {len(log.args)}, {{{args}}}}},\n')
+    out.append('};\ninline constexpr size_t GKC_NUM_LOG_FORMATS =\n'
+               '  sizeof(GKC_LOG_FORMATS) / sizeof(GKC_LOG_FORMATS[0]);\n\n')
+
+    out.append('/**\n * @brief Builders of `LogIdGkcPacket`, one per log, with its default '
+               'level\n */\nclass GkcLogs\n{\npublic:\n')
+    for i, log in enumerate(logs):
+        params = ', '.join(f'const {a.cpp_type} & {a.name}' for a in log.args)
+        size = sum(a.size for a in log.args)
+        signature = f'  static LogIdGkcPacket {log.name.lower()}({params})'
+        if len(signature) > 99:
+            signature = f'  static LogIdGkcPacket {log.name.lower()}(\n    {params})'
+        out.append(f'  // {log.format}\n'
+                   f'{signature}\n  {{\n'
+                   f'    auto packet = make(GkcLogId::{log.name}, LogIdGkcPacket::{log.level}, '
+                   f'{size});\n')
+        offset = 0
+        for a in log.args:
+            where = 'packet.args.data()' + (f' + {offset}' if offset else '')
+            out.append(f'    GkcPacketUtils::write_to_buffer({where}, {a.name});\n')
+            offset += a.size
+        out.append('    return packet;\n  }\n')
+        if i != len(logs) - 1:
+            out.append('\n')
+    out.append('\nprivate:\n'
+               '  static LogIdGkcPacket make(\n'
+               '    const GkcLogId & id, const LogIdGkcPacket::Severity & level,\n'
+               '    const size_t & args_size)\n  {\n'
+               '    auto packet = LogIdGkcPacket();\n'
+               '    packet.level = level;\n'
+               '    packet.id = static_cast<uint16_t>(id);\n'
+               '    packet.args.resize(args_size);\n'
+               '    return packet;\n  }\n};\n')
+    out.append('}  // namespace gkc\n}  // namespace tritonai\n')
+    out.append(f'#endif  // {guard(path)}\n')
+    return path, ''.join(out)
+
+
+def gen_msg_conversions(packets, messages):
+    path = 'generated/gkc_msg_conversions.hpp'
+    by_name = {p.name: p for p in packets}
+    out = [file_header('gkc_msg_conversions.hpp',
+                       'Conversions between packets and the ROS messages in tai_gokart_msgs'),
+           '\n']
+    out.append(f'#ifndef {guard(path)}\n#define {guard(path)}\n\n')
+    out.append('#include "tai_gokart_packet/gkc_packets.hpp"\n\n')
+    out.append('namespace tritonai\n{\nnamespace gkc\n{\n')
+    for i, msg in enumerate(messages):
+        p = by_name[msg['packet']]
+        if p.variable:
+            raise SchemaError(f'{msg["name"]}: packets with strings or bytes cannot be converted.')
+        source_type = f'{p.name}::{p.struct_name}' if p.struct_name else p.name
+        var = p.struct_member if p.struct_name else 'packet'
+        # Templates, so that this package does not depend on the message package
+        out.append(f'/**\n * @brief Copy every field of `{source_type}` into a message\n'
+                   ' * with the same field names, '
+                   f'e.g. `tai_gokart_msgs::msg::{msg["name"]}`\n */\n')
+        out.append(f'template<typename MsgT>\nvoid to_msg(const {source_type} & {var}, '
+                   f'MsgT & msg)\n{{\n')
+        out.extend(f'  msg.{f.name} = {var}.{f.name};\n' for f in p.fields)
+        out.append('}\n\n')
+        out.append(f'/**\n * @brief Copy every field of `{source_type}` from a message\n'
+                   ' * with the same field names, '
+                   f'e.g. `tai_gokart_msgs::msg::{msg["name"]}`\n */\n')
+        out.append(f'template<typename MsgT>\nvoid from_msg(const MsgT & msg, {source_type} & '
+                   f'{var})\n{{\n')
+        for f in p.fields:
+            value = f'msg.{f.name}'
+            if f.type == 'enum':
+                value = f'static_cast<{source_type}::{f.enum}>({value})'
+            out.append(f'  {var}.{f.name} = {value};\n')
+        out.append('}\n')
+        if p.struct_name:
+            out.append(f'\ntemplate<typename MsgT>\nvoid to_msg(const {p.name} & packet, '
+                       f'MsgT & msg) {{to_msg(packet.{var}, msg);}}\n')
+            out.append(f'template<typename MsgT>\nvoid from_msg(const MsgT & msg, {p.name} & '
+                       f'packet) {{from_msg(msg, packet.{var});}}\n')
+        if i != len(messages) - 1:
+            out.append('\n')
+    out.append('}  // namespace gkc\n}  // namespace tritonai\n')
+    out.append(f'#endif  // {guard(path)}\n')
+    return path, ''.join(out)
+
+
+def gen_msgs(packets, messages):
+    by_name = {p.name: p for p in packets}
+    files = []
+    for msg in messages:
+        p = by_name[msg['packet']]
+        out = [f'# Fields of {p.name} in tai_gokart_packet/schema/gkc_packets.yaml\n',
+               f'# {DO_NOT_EDIT}\n']
+        out.extend(f'{line}\n' for line in msg.get('before', []))
+        for i, field in enumerate(p.fields):
+            if i == 0 or field.section is not None:
+                out.append('\n')
+            line = f'{field.ros_type} {field.name}'
+            if field.comment:
+                line += f'  # {field.comment}'
+            out.append(line + '\n')
+        if msg.get('after'):
+            out.append('\n')
+            out.extend(f'{line}\n' for line in msg['after'])
+        files.append((os.path.join(MSG_DIR, msg['name'] + '.msg'), ''.join(out)))
+    return files
+
+
+def generate():
+    packets, messages, logs = load_schema()
+    files = [(os.path.join(INCLUDE_DIR, path), content) for path, content in [
+        gen_packet_defs(packets),
+        gen_packet_codecs(packets),
+        gen_views(packets),
+        gen_subscriber(packets),
+        gen_log_defs(logs),
+        gen_msg_conversions(packets, messages),
+    ]]
+    # The message package is optional, e.g. when only this package is checked out
+    if os.path.isdir(MSG_DIR):
+        files += gen_msgs(packets, messages)
+    return files
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('--check', action='store_true',
+                        help='only check that the generated files are up to date')
+    args = parser.parse_args()
+
+    try:
+        files = generate()
+    except SchemaError as e:
+        print(f'{SCHEMA}: {e}', file=sys.stderr)
+        return 1
+
+    stale = []
+    for path, content in files:
+        current = None
+        if os.path.exists(path):
+            with open(path) as f:
+                current = f.read()
+        if current == content:
+            continue
+        if args.check:
+            stale.append(path)
+            sys.stderr.writelines(difflib.unified_diff(
+                (current or '').splitlines(True), content.splitlines(True), path, 'generated'))
+        else:
+            os.makedirs(os.path.dirname(path), exist_ok=True)
+            with open(path, 'w') as f:
+                f.write(content)
+            print(f'Wrote {os.path.relpath(path, PACKAGE_DIR)}')
+    if stale:
+        print('Out of date, run tools/gkc_codegen.py: ' + ', '.join(stale), file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())